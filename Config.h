@@ -146,6 +146,12 @@
 
 // NON-VOLATILE MEMORY --------------------------------------------- see https://onstep.groups.io/g/main/wiki/Configuration_Mount#NV
 #define NV_DRIVER              NV_DEFAULT // NV_DEF, Use platforms default non-volatile device to remember runtime settings.  Option
+#define NV_LOG                        OFF //    OFF, n. Bytes (512 to 2048, multiple of 16) for a wear leveled log of         Option
+                                          //         frequently changing positions, moves at end of NV so library loses space.
+#define NV_LOG_PERIOD                1000 //   1000, n. Where n=100..60000 (milliseconds.) How often changed positions go to  Infreq
+                                          //         the NV_LOG, writes in between coalesce.
+#define NV_CHECKSUM                   OFF //    OFF, ON keeps a CRC of the settings and PEC/library regions, warns at startup Option
+                                          //         if NV was corrupted, takes 6 bytes from the library.
 
 // STATUS ------------------------------------------------------ see https://onstep.groups.io/g/main/wiki/Configuration_Mount#STATUS
 #define STATUS_MOUNT_LED              OFF //    OFF, ON Flashes proportional to rate of movement or solid on for slews.       Option
@@ -197,12 +203,14 @@
                                           //         1/2 to 2x this rate, and as performace considerations require.
 #define SLEW_RATE_MEMORY              OFF //    OFF, ON Remembers rates set across power cycles.                              Option
 #define SLEW_ACCELERATION_DIST        5.0 //    5.0, n, (degrees.) Approx. distance for acceleration (and deceleration.)      Adjust
+#define SLEW_ACCELERATION_SCURVE      OFF //    OFF, ON for jerk-limited (S-curve) ramps, peak accel. is PI/2 x the average.  Option
 #define SLEW_RAPID_STOP_DIST          2.0 //    2.0, n, (degrees.) Approx. distance required to stop when a slew              Adjust
                                           //         is aborted or a limit is exceeded.
 #define GOTO_FEATURE                   ON //     ON, Use OFF to disable mount Goto features.                                  Infreq
 #define GOTO_OFFSET                  0.25 //   0.25, Offset in deg's for goto target unidirectional approach, 0.0 disables    Adjust
 #define GOTO_OFFSET_ALIGN             OFF //    OFF, ON skips final phase of goto for align stars so user tends to approach   Option
                                           //         from the correct direction when centering.
+#define GOTO_SYNCHRONIZED             OFF //    OFF, ON Slows the axis that would arrive first so both end a goto together.   Option
 
 // PIER SIDE BEHAVIOUR --------------------------------------- see https://onstep.groups.io/g/main/wiki/Configuration_Mount#PIERSIDE
 #define MFLIP_SKIP_HOME               OFF //    OFF, ON Goto directly to the destination without visiting home position.      Option
@@ -220,6 +228,7 @@
 #define ALIGN_MODEL_MEMORY            OFF //    OFF, ON Restores any pointing model saved in NV at startup.                   Option
 #define ALIGN_MAX_STARS              AUTO //   AUTO, Uses HAL specified default (either 6 or 9 stars.)                        Infreq
                                           //         Or use n. Where n=1 (for Sync only) or 3 to 9 (for Goto Assist.)
+#define ALIGN_MODEL_STREAM            OFF //    OFF, ON Streaming model, :AP# adds any number of points to it.                Infreq
 
 // =================================================================================================================================
 // ROTATOR =========================================================================================================================
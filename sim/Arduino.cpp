@@ -0,0 +1,356 @@
+// -----------------------------------------------------------------------------------
+// Arduino core stand-in for the host (Linux) simulation build (ARDUINO_ARCH_SIM)
+
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// virtual time that passes on each call to yield(), in microseconds
+#ifndef SIM_YIELD_MICROS
+  #define SIM_YIELD_MICROS 1
+#endif
+
+#define SIM_PINS 1024
+
+extern void simAdvance(unsigned long subMicros);
+
+// -----------------------------------------------------------------------------------
+// time
+
+// true while the virtual clock is being advanced, time stands still inside a timer callback
+static bool advancing = false;
+
+static void advance(unsigned long long subMicros) {
+  if (advancing) return;
+  advancing = true;
+  // simAdvance() takes up to about 268 seconds at once
+  while (subMicros > 0) {
+    unsigned long step = subMicros > 0xF0000000ULL ? 0xF0000000UL : (unsigned long)subMicros;
+    simAdvance(step);
+    subMicros -= step;
+  }
+  advancing = false;
+}
+
+void delay(unsigned long ms) { advance(ms*16000ULL); }
+
+void delayMicroseconds(unsigned int us) { advance(us*16ULL); }
+
+void yield() { advance(SIM_YIELD_MICROS*16ULL); }
+
+// -----------------------------------------------------------------------------------
+// digital and analog I/O
+
+static uint8_t pinModes[SIM_PINS];
+static int pinValues[SIM_PINS];
+
+static inline bool validPin(int pin) { return pin >= 0 && pin < SIM_PINS; }
+
+void pinMode(int pin, int mode) {
+  if (!validPin(pin)) return;
+  pinModes[pin] = mode;
+  if (mode == INPUT_PULLUP) pinValues[pin] = HIGH; else
+  if (mode == INPUT_PULLDOWN) pinValues[pin] = LOW;
+}
+
+void (*simPinWrite)(int pin, int value) = NULL;
+
+void digitalWrite(int pin, int value) {
+  if (!validPin(pin)) return;
+  pinValues[pin] = value ? HIGH : LOW;
+  if (simPinWrite != NULL) simPinWrite(pin, pinValues[pin]);
+}
+
+int digitalRead(int pin) { return validPin(pin) ? (pinValues[pin] ? HIGH : LOW) : LOW; }
+
+int analogRead(int pin) { return validPin(pin) ? pinValues[pin] : 0; }
+
+void analogWrite(int pin, int value) { if (validPin(pin)) pinValues[pin] = value; }
+
+void analogReadResolution(int bits) { (void)(bits); }
+
+void analogWriteResolution(int bits) { (void)(bits); }
+
+void analogWriteFrequency(int pin, float frequency) { (void)(pin); (void)(frequency); }
+
+void tone(int pin, unsigned int frequency, unsigned long duration) { (void)(pin); (void)(frequency); (void)(duration); }
+
+void noTone(int pin) { (void)(pin); }
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode) { (void)(interrupt); (void)(isr); (void)(mode); }
+
+void detachInterrupt(int interrupt) { (void)(interrupt); }
+
+// -----------------------------------------------------------------------------------
+// conversion
+
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer) {
+  sprintf(buffer, "%*.*f", width, precision, value);
+  return buffer;
+}
+
+// -----------------------------------------------------------------------------------
+// random numbers, a fixed sequence so runs repeat exactly
+
+static unsigned long long randomState = 1;
+
+void randomSeed(unsigned long seed) { if (seed != 0) randomState = seed; }
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  randomState = randomState*6364136223846793005ULL + 1442695040888963407ULL;
+  return (long)((randomState >> 33) % (unsigned long long)howbig);
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+// -----------------------------------------------------------------------------------
+// String
+
+static std::string numberToString(unsigned long long n, unsigned char base, bool negative) {
+  if (base < 2) base = 10;
+  std::string s;
+  do { uint8_t d = n % base; s.insert(s.begin(), d < 10 ? '0' + d : 'A' + d - 10); n /= base; } while (n > 0);
+  if (negative) s.insert(s.begin(), '-');
+  return s;
+}
+
+String::String(long value, unsigned char base) {
+  if (value < 0 && base == DEC) s = numberToString(-(unsigned long long)value, base, true); else s = numberToString((unsigned long)value, base, false);
+}
+
+String::String(unsigned long value, unsigned char base) { s = numberToString(value, base, false); }
+
+String::String(double value, unsigned char decimalPlaces) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+  s = buffer;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t i = s.find(c, from);
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String &str, unsigned int from) const {
+  size_t i = s.find(str.s, from);
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t i = s.rfind(c);
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+String String::substring(unsigned int from) const { return substring(from, s.length()); }
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= s.length()) return String();
+  if (to > s.length()) to = s.length();
+  return String(s.substr(from, to - from));
+}
+
+bool String::endsWith(const String &suffix) const {
+  if (suffix.s.length() > s.length()) return false;
+  return s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0;
+}
+
+void String::toCharArray(char *buf, unsigned int size, unsigned int index) const {
+  if (size == 0) return;
+  if (index >= s.length()) { buf[0] = 0; return; }
+  strncpy(buf, s.c_str() + index, size - 1);
+  buf[size - 1] = 0;
+}
+
+void String::trim() {
+  size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos) { s.clear(); return; }
+  s = s.substr(first, s.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+void String::toUpperCase() { for (auto &c : s) c = toupper(c); }
+
+void String::toLowerCase() { for (auto &c : s) c = tolower(c); }
+
+void String::replace(const String &find, const String &replace) {
+  if (find.s.empty()) return;
+  size_t i = 0;
+  while ((i = s.find(find.s, i)) != std::string::npos) { s.replace(i, find.s.length(), replace.s); i += replace.s.length(); }
+}
+
+void String::remove(unsigned int index, unsigned int count) { if (index < s.length()) s.erase(index, count); }
+
+// -----------------------------------------------------------------------------------
+// Print and Stream
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+  std::string s = numberToString(n, base, false);
+  return write(s.c_str());
+}
+
+size_t Print::print(const __FlashStringHelper *s) { return write((const char *)s); }
+size_t Print::print(const String &s) { return write(s.c_str()); }
+size_t Print::print(const char s[]) { return write(s); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base) { return print((unsigned long long)n, base); }
+size_t Print::print(int n, int base) { return print((long long)n, base); }
+size_t Print::print(unsigned int n, int base) { return print((unsigned long long)n, base); }
+size_t Print::print(long n, int base) { return print((long long)n, base); }
+size_t Print::print(unsigned long n, int base) { return print((unsigned long long)n, base); }
+
+size_t Print::print(long long n, int base) {
+  if (base == 0) return write((uint8_t)n);
+  if (base == DEC && n < 0) return write('-') + printNumber(-(unsigned long long)n, DEC);
+  return printNumber((unsigned long long)n, base);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+  if (base == 0) return write((uint8_t)n);
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+  return write(buffer);
+}
+
+size_t Print::println(const __FlashStringHelper *s) { return print(s) + println(); }
+size_t Print::println(const String &s) { return print(s) + println(); }
+size_t Print::println(const char s[]) { return print(s) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+size_t Print::println(long long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long long n, int base) { return print(n, base) + println(); }
+size_t Print::println(double n, int digits) { return print(n, digits) + println(); }
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printf(const char *format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return write(buffer);
+}
+
+// reads wait on the virtual clock, as they would on the hardware, up to the timeout
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  unsigned long startTime = millis();
+  while (count < length) {
+    int c = read();
+    if (c < 0) {
+      if ((long)(millis() - startTime) >= (long)timeout) break;
+      yield();
+      continue;
+    }
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String s;
+  unsigned long startTime = millis();
+  while (true) {
+    int c = read();
+    if (c < 0) {
+      if ((long)(millis() - startTime) >= (long)timeout) break;
+      yield();
+      continue;
+    }
+    if (c == terminator) break;
+    s += (char)c;
+  }
+  return s;
+}
+
+// -----------------------------------------------------------------------------------
+// Serial ports
+
+static int consolePeek = -1;
+static bool consoleReady = false;
+static std::string consoleInput;
+
+std::string *simSerialCapture = NULL;
+
+void simSerialInput(const char *s) { consoleInput += s; }
+
+// fetch the next character from the test input or stdin, if there is one, without blocking
+// and once caught up with the input any replies waiting go out
+static void consolePoll() {
+  if (consolePeek >= 0) return;
+  if (!consoleInput.empty()) {
+    consolePeek = (unsigned char)consoleInput[0];
+    consoleInput.erase(0, 1);
+    return;
+  }
+  if (!consoleReady) {
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    consoleReady = true;
+  }
+  unsigned char c;
+  if (::read(STDIN_FILENO, &c, 1) == 1) consolePeek = c; else fflush(stdout);
+}
+
+int HardwareSerial::available() {
+  if (!console) return simInput.length();
+  consolePoll();
+  return consolePeek >= 0 ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+  if (!console) {
+    if (simInput.empty()) return -1;
+    int c = (unsigned char)simInput[0];
+    simInput.erase(0, 1);
+    return c;
+  }
+  consolePoll();
+  int c = consolePeek;
+  consolePeek = -1;
+  return c;
+}
+
+int HardwareSerial::peek() {
+  if (!console) return simInput.empty() ? -1 : (unsigned char)simInput[0];
+  consolePoll();
+  return consolePeek;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (console) { if (simSerialCapture != NULL) *simSerialCapture += (char)c; else fputc(c, stdout); } else
+  if (simWrite != NULL) simWrite(c);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  if (console) { if (simSerialCapture != NULL) simSerialCapture->append((const char *)buffer, size); else fwrite(buffer, 1, size, stdout); } else
+  if (simWrite != NULL) for (size_t i = 0; i < size; i++) simWrite(buffer[i]);
+  return size;
+}
+
+void HardwareSerial::flush() { if (console) fflush(stdout); }
+
+HardwareSerial Serial(true);
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+HardwareSerial Serial3;
@@ -0,0 +1,295 @@
+// -----------------------------------------------------------------------------------
+// Arduino core stand-in for the host (Linux) simulation build (ARDUINO_ARCH_SIM)
+// only what OnStepX uses is here, time comes from the virtual clock in lib/tasks/OnTask.h
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define PULLUP         0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define strcpy_P strcpy
+#define strcat_P strcat
+#define strcmp_P strcmp
+#define strlen_P strlen
+#define sprintf_P sprintf
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *)(s))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+
+using std::min;
+using std::max;
+using std::isnan;
+using std::isinf;
+
+// the timers only fire while the virtual clock is advanced, never in the middle of other code, so these have nothing to do
+#define noInterrupts()
+#define interrupts()
+#define cli()
+#define sei()
+
+#define digitalPinToInterrupt(p) (p)
+#define NOT_AN_INTERRUPT -1
+
+// time, from the virtual clock
+extern unsigned long simMillis();
+extern unsigned long simMicros();
+inline unsigned long millis() { return simMillis(); }
+inline unsigned long micros() { return simMicros(); }
+
+// advance the virtual clock by the given time, running any h/w timers that come due
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// advance the virtual clock by SIM_YIELD_MICROS, called from each pass through tasks.yield()
+void yield();
+
+// digital and analog I/O, pins hold the state last written and read back as written, or as pulled up/down for inputs
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+int analogRead(int pin);
+void analogWrite(int pin, int value);
+void analogReadResolution(int bits);
+void analogWriteResolution(int bits);
+void analogWriteFrequency(int pin, float frequency);
+void tone(int pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(int pin);
+void attachInterrupt(int interrupt, void (*isr)(), int mode);
+void detachInterrupt(int interrupt);
+
+// if set, called on each digitalWrite() so tests can model devices attached to the pins
+extern void (*simPinWrite)(int pin, int value);
+
+// double to string, as in avr-libc
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer);
+
+// deterministic pseudo random numbers
+void randomSeed(unsigned long seed);
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+// -----------------------------------------------------------------------------------
+// String
+
+class String {
+  public:
+    String(const char *s = "") : s(s ? s : "") {}
+    String(const __FlashStringHelper *s) : s((const char *)s) {}
+    String(const std::string &s) : s(s) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(int value, unsigned char base = DEC) : String((long)value, base) {}
+    explicit String(unsigned int value, unsigned char base = DEC) : String((unsigned long)value, base) {}
+    explicit String(long value, unsigned char base = DEC);
+    explicit String(unsigned long value, unsigned char base = DEC);
+    explicit String(float value, unsigned char decimalPlaces = 2) : String((double)value, decimalPlaces) {}
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    inline const char *c_str() const { return s.c_str(); }
+    inline unsigned int length() const { return s.length(); }
+    inline void reserve(unsigned int size) { s.reserve(size); }
+
+    inline String &operator+=(const String &o) { s += o.s; return *this; }
+    inline String &operator+=(const char *o) { s += o; return *this; }
+    inline String &operator+=(char c) { s += c; return *this; }
+    inline String &concat(const String &o) { return *this += o; }
+
+    inline bool operator==(const String &o) const { return s == o.s; }
+    inline bool operator==(const char *o) const { return s == o; }
+    inline bool operator!=(const String &o) const { return s != o.s; }
+    inline bool operator!=(const char *o) const { return s != o; }
+    inline bool equals(const String &o) const { return s == o.s; }
+    inline bool equalsIgnoreCase(const String &o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+
+    inline char operator[](unsigned int i) const { return i < s.length() ? s[i] : 0; }
+    inline char &operator[](unsigned int i) { return s[i]; }
+    inline char charAt(unsigned int i) const { return (*this)[i]; }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &str, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    inline bool startsWith(const String &prefix) const { return s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const;
+
+    void toCharArray(char *buf, unsigned int size, unsigned int index = 0) const;
+    inline long toInt() const { return atol(s.c_str()); }
+    inline float toFloat() const { return atof(s.c_str()); }
+    inline double toDouble() const { return atof(s.c_str()); }
+
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+    void replace(const String &find, const String &replace);
+    void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+
+  private:
+    std::string s;
+};
+
+inline String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, const char *b) { String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, char b) { String r(a); r += b; return r; }
+
+// -----------------------------------------------------------------------------------
+// Print and Stream
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    inline size_t write(const char *str) { return str == NULL ? 0 : write((const uint8_t *)str, strlen(str)); }
+    inline size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper *s);
+    size_t print(const String &s);
+    size_t print(const char s[]);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(long long n, int base = DEC);
+    size_t print(unsigned long long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println(const __FlashStringHelper *s);
+    size_t println(const String &s);
+    size_t println(const char s[]);
+    size_t println(char c);
+    size_t println(unsigned char n, int base = DEC);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(long long n, int base = DEC);
+    size_t println(unsigned long long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+    size_t println();
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+  private:
+    size_t printNumber(unsigned long long n, uint8_t base);
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    inline void setTimeout(unsigned long timeout) { this->timeout = timeout; }
+    size_t readBytes(char *buffer, size_t length);
+    inline size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    String readStringUntil(char terminator);
+
+  protected:
+    unsigned long timeout = 1000;
+};
+
+// -----------------------------------------------------------------------------------
+// Serial ports, Serial is the host's stdin/stdout, the others read what a test puts in simInput and hand what's
+// written to simWrite (if set) so tests can model a device on the other end
+
+class HardwareSerial : public Stream {
+  public:
+    HardwareSerial(bool console = false) : console(console) {}
+
+    inline void begin(unsigned long baud) { (void)(baud); }
+    inline void begin(unsigned long baud, uint32_t config, int8_t rxPin = -1, int8_t txPin = -1) { (void)(baud); (void)(config); (void)(rxPin); (void)(txPin); }
+    inline void end() {}
+    inline void setRxBufferSize(size_t size) { (void)(size); }
+    inline void setTxBufferSize(size_t size) { (void)(size); }
+    inline operator bool() { return true; }
+
+    int available();
+    int read();
+    int peek();
+    int availableForWrite() { return 128; }
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    void flush();
+
+    std::string simInput;
+    void (*simWrite)(uint8_t c) = NULL;
+
+  private:
+    bool console;
+};
+
+#define SERIAL_8N1 0x800001c
+
+// tests can talk to the sketch over Serial, characters given here are read ahead of any from stdin
+// and while a capture string is set what's written to Serial is appended to it rather than stdout
+void simSerialInput(const char *s);
+extern std::string *simSerialCapture;
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
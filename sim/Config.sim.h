@@ -0,0 +1,20 @@
+// -----------------------------------------------------------------------------------
+// host (Linux) simulation overrides, the Makefile appends these to a copy of Config.h
+
+// no pins on the host
+#undef PINMAP
+#define PINMAP OFF
+
+// no WiFi for NTP on the host
+#undef TIME_LOCATION_SOURCE
+#define TIME_LOCATION_SOURCE OFF
+
+// virtual step/dir pins for the motors
+#define AXIS1_STEP_PIN 1
+#define AXIS1_DIR_PIN 2
+#define AXIS2_STEP_PIN 3
+#define AXIS2_DIR_PIN 4
+#define AXIS3_STEP_PIN 5
+#define AXIS3_DIR_PIN 6
+#define AXIS4_STEP_PIN 7
+#define AXIS4_DIR_PIN 8
@@ -0,0 +1,26 @@
+// -----------------------------------------------------------------------------------
+// Arduino EEPROM stand-in for the host (Linux) simulation build, RAM that starts erased
+#pragma once
+
+#include "Arduino.h"
+
+#ifndef E2END
+  #define E2END 4095
+#endif
+
+class EEPROMClass {
+  public:
+    EEPROMClass() { memset(data, 0xff, sizeof(data)); }
+
+    inline bool begin(size_t size) { return size <= sizeof(data); }
+    inline uint8_t read(int address) { return address >= 0 && address <= E2END ? data[address] : 0xff; }
+    inline void write(int address, uint8_t value) { if (address >= 0 && address <= E2END) data[address] = value; }
+    inline void update(int address, uint8_t value) { write(address, value); }
+    inline bool commit() { return true; }
+    inline uint16_t length() { return E2END + 1; }
+
+  private:
+    uint8_t data[E2END + 1];
+};
+
+extern EEPROMClass EEPROM;
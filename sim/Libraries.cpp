@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------------
+// Arduino library stand-ins for the host (Linux) simulation build, their instances
+
+#include "Wire.h"
+#include "EEPROM.h"
+#include "WiFi.h"
+
+#include <map>
+
+TwoWire Wire;
+EEPROMClass EEPROM;
+
+// -----------------------------------------------------------------------------------
+// Wire
+
+void TwoWire::busTime(size_t count) {
+  delayMicroseconds((unsigned int)(((count + 1)*9*1000000ULL)/clock));
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address & 0x7f;
+  txCount = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+  if (txCount >= SIM_WIRE_BUFFER_SIZE) return 0;
+  txBuffer[txCount++] = c;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (n < size && write(buffer[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)(sendStop);
+  SimI2cDevice *device = devices[txAddress];
+  if (device == NULL || !device->ready()) { busTime(0); return 2; }
+  busTime(txCount);
+  return device->receive(txBuffer, txCount) ? 0 : 3;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+  (void)(sendStop);
+  rxCount = rxIndex = 0;
+  SimI2cDevice *device = devices[address & 0x7f];
+  if (device == NULL || !device->ready()) { busTime(0); return 0; }
+  if (quantity > SIM_WIRE_BUFFER_SIZE) quantity = SIM_WIRE_BUFFER_SIZE;
+  rxCount = device->transmit(rxBuffer, quantity);
+  busTime(rxCount);
+  return rxCount;
+}
+
+// -----------------------------------------------------------------------------------
+// WiFi
+
+// the servers listening, by port
+static std::map<uint16_t, WiFiServer *> wifiServers;
+
+SimTcp simWiFiConnect(uint16_t port) {
+  auto server = wifiServers.find(port);
+  if (server == wifiServers.end()) return NULL;
+  SimTcp connection = std::make_shared<SimTcpConnection>();
+  server->second->pending.push_back(connection);
+  return connection;
+}
+
+int WiFiClient::available() { return connection != NULL ? (int)connection->toServer.length() : 0; }
+
+int WiFiClient::read() {
+  if (available() <= 0) return -1;
+  int c = (unsigned char)connection->toServer[0];
+  connection->toServer.erase(0, 1);
+  return c;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size) {
+  size_t count = std::min(size, (size_t)available());
+  if (count == 0) return 0;
+  memcpy(buffer, connection->toServer.data(), count);
+  connection->toServer.erase(0, count);
+  return (int)count;
+}
+
+int WiFiClient::peek() { return available() > 0 ? (unsigned char)connection->toServer[0] : -1; }
+
+size_t WiFiClient::write(uint8_t c) { return write(&c, 1); }
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size) {
+  if (!connected()) return 0;
+  connection->toClient.append((const char *)buffer, size);
+  return size;
+}
+
+void WiFiClient::stop() {
+  if (connection != NULL) connection->open = false;
+  connection = NULL;
+}
+
+void WiFiServer::begin() { wifiServers[port] = this; }
+
+void WiFiServer::end() {
+  auto server = wifiServers.find(port);
+  if (server != wifiServers.end() && server->second == this) wifiServers.erase(server);
+  pending.clear();
+}
+
+WiFiClient WiFiServer::available() {
+  if (pending.empty()) return WiFiClient();
+  SimTcp connection = pending.front();
+  pending.pop_front();
+  return WiFiClient(connection);
+}
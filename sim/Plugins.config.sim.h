@@ -0,0 +1,15 @@
+/* ---------------------------------------------------------------------------------------------------------------------------------
+ * User plugins for the host (Linux) simulation build, the Makefile puts this in place of src/plugins/Plugins.config.h
+ *
+ * Plugins are written for the hardware they run on and aren't part of the simulation.
+ * ---------------------------------------------------------------------------------------------------------------------------------
+*/
+
+#define PLUGIN1                       OFF
+#define PLUGIN2                       OFF
+#define PLUGIN3                       OFF
+#define PLUGIN4                       OFF
+#define PLUGIN5                       OFF
+#define PLUGIN6                       OFF
+#define PLUGIN7                       OFF
+#define PLUGIN8                       OFF
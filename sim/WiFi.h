@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------------
+// Arduino WiFi stand-in for the host (Linux) simulation build, a TCP connection is a pair of byte queues that
+// a test opens to a WiFiServer and then writes commands to and reads replies from
+#pragma once
+
+#include "Arduino.h"
+#include <memory>
+#include <deque>
+
+// one TCP connection, what each end has written that the other hasn't read yet
+typedef struct SimTcpConnection {
+  std::string toServer;
+  std::string toClient;
+  bool open = true;
+} SimTcpConnection;
+
+typedef std::shared_ptr<SimTcpConnection> SimTcp;
+
+// connects to the WiFiServer listening on port, the server sees it with hasClient(), returns NULL if nothing listens there
+SimTcp simWiFiConnect(uint16_t port);
+
+class WiFiClient : public Stream {
+  public:
+    WiFiClient() {}
+    WiFiClient(SimTcp connection) : connection(connection) {}
+
+    // as on the ESP32, a client is true while it's connected
+    inline operator bool() { return connected(); }
+    inline uint8_t connected() { return connection != NULL && connection->open; }
+
+    int available();
+    int read();
+    int read(uint8_t *buffer, size_t size);
+    int peek();
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    inline void flush() {}
+    void stop();
+    inline void setNoDelay(bool noDelay) { (void)(noDelay); }
+
+  private:
+    SimTcp connection;
+};
+
+class WiFiServer {
+  public:
+    WiFiServer(uint16_t port) : port(port) {}
+    ~WiFiServer() { end(); }
+
+    void begin();
+    void end();
+    inline void setNoDelay(bool noDelay) { (void)(noDelay); }
+
+    // true if a connection is waiting to be accepted
+    inline bool hasClient() { return !pending.empty(); }
+
+    // accepts the next connection waiting, the client is false if there isn't one
+    WiFiClient available();
+    inline WiFiClient accept() { return available(); }
+
+  private:
+    friend SimTcp simWiFiConnect(uint16_t port);
+
+    uint16_t port;
+    std::deque<SimTcp> pending;
+};
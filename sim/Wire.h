@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------------
+// Arduino Wire (I2C) stand-in for the host (Linux) simulation build, nothing is on the bus unless a test attaches a device
+#pragma once
+
+#include "Arduino.h"
+
+// the Wire buffer size on most platforms, a transmission or request longer than this is cut short
+#define SIM_WIRE_BUFFER_SIZE 32
+
+// a device on the simulated bus
+class SimI2cDevice {
+  public:
+    virtual ~SimI2cDevice() {}
+
+    // return false while busy (an EEPROM write cycle, etc.) and the device doesn't acknowledge its address
+    virtual bool ready() { return true; }
+
+    // the bytes of one transmission (after the address), return false to not acknowledge it
+    virtual bool receive(const uint8_t *data, size_t count) = 0;
+
+    // fill data with up to count bytes for a request, returns the number of bytes sent
+    virtual size_t transmit(uint8_t *data, size_t count) = 0;
+};
+
+class TwoWire : public Stream {
+  public:
+    inline bool begin() { return true; }
+    inline bool begin(int sda, int scl, uint32_t frequency = 0) { (void)(sda); (void)(scl); if (frequency) clock = frequency; return true; }
+    inline bool end() { return true; }
+    inline void setClock(uint32_t frequency) { clock = frequency; }
+
+    // puts a device on the bus at the given 7 bit address (NULL removes it)
+    inline void attach(uint8_t address, SimI2cDevice *device) { devices[address & 0x7f] = device; }
+
+    void beginTransmission(uint8_t address);
+    // returns 0 on success, 2 if no device acknowledges its address or 3 the data, the bus time passes on the virtual clock
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+
+    inline int available() { return rxCount - rxIndex; }
+    inline int read() { return rxIndex < rxCount ? rxBuffer[rxIndex++] : -1; }
+    inline int peek() { return rxIndex < rxCount ? rxBuffer[rxIndex] : -1; }
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+
+  private:
+    // the time for this many bytes plus the address byte to cross the bus, 9 clocks each
+    void busTime(size_t count);
+
+    SimI2cDevice *devices[128] = { NULL };
+    uint32_t clock = 100000;
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[SIM_WIRE_BUFFER_SIZE];
+    size_t txCount = 0;
+    uint8_t rxBuffer[SIM_WIRE_BUFFER_SIZE];
+    size_t rxCount = 0;
+    size_t rxIndex = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------
+// host (Linux) simulation entry point, runs the sketch for a given amount of virtual time
+//
+// usage: onstepx [seconds]
+//   commands are read from stdin and replies written to stdout (the Serial port, SERIAL_A)
+//   seconds of virtual time to run for, default 10
+
+#include "Arduino.h"
+
+extern void setup();
+extern void loop();
+
+int main(int argc, char *argv[]) {
+  double seconds = 10.0;
+  if (argc > 1) seconds = atof(argv[1]);
+  if (argc > 2 || seconds <= 0.0) {
+    fprintf(stderr, "usage: %s [seconds]\n", argv[0]);
+    return 1;
+  }
+  unsigned long long endMicros = (unsigned long long)(seconds*1000000.0);
+
+  // micros() wraps every ~71 minutes, keep our own count of the time that's passed
+  unsigned long long elapsedMicros = 0;
+  unsigned long lastMicros = micros();
+
+  setup();
+  while (true) {
+    unsigned long now = micros();
+    elapsedMicros += now - lastMicros;
+    lastMicros = now;
+    if (elapsedMicros >= endMicros) break;
+
+    loop();
+    yield();
+  }
+  Serial.flush();
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------
+// synthetic align stars for the pointing model tests and benchmarks (German equatorial mount)
+#pragma once
+
+#include "src/telescope/mount/coordinates/Transform.h"
+
+#include "Test.h"
+
+#define ALIGN_LATITUDE 40.0
+
+typedef struct AlignStar {
+  Coordinate actual;
+  Coordinate mount;
+} AlignStar;
+
+// mount axis corrections for the model terms (in radians, indexed by ALIGN_TERM_*) at mount axis position ma1, ma2
+// these follow the model GeoAlign fits, but are worked out here separately in double precision
+static void alignCorrect(const double *term, double ma1, double ma2, int side, double *a1r, double *a2r) {
+  double cosLat = cos(degToRad(ALIGN_LATITUDE)), sinLat = sin(degToRad(ALIGN_LATITUDE));
+  double cosA1 = cos(ma1), sinA1 = sin(ma1), cosA2 = cos(ma2), sinA2 = sin(ma2), tanA2 = sinA2/cosA2;
+
+  double DOh = term[ALIGN_TERM_DO]/cosA2*side;
+  double PDh = -term[ALIGN_TERM_PD]*tanA2*side;
+  double PZ = term[ALIGN_TERM_AZM];
+  double PA = term[ALIGN_TERM_ALT];
+  double FLd = -term[ALIGN_TERM_FLEX]*(cosLat*cosA1 + sinLat*tanA2);
+  double TFh = term[ALIGN_TERM_TF]*cosLat*sinA1/cosA2;
+  double TFd = term[ALIGN_TERM_TF]*(cosLat*cosA1*sinA2 - sinLat*cosA2);
+
+  *a1r = -PZ*cosA1*tanA2 + PA*sinA1*tanA2 + DOh + PDh + TFh;
+  *a2r = PZ*sinA1 + PA*cosA1 + FLd + TFd;
+}
+
+// the model terms, in radians and indexed by ALIGN_TERM_*, from an AlignModel
+static void alignTerms(const AlignModel &model, double *term) {
+  term[ALIGN_TERM_AX1] = model.ax1Cor;
+  term[ALIGN_TERM_AX2] = -model.ax2Cor;
+  term[ALIGN_TERM_DO] = model.doCor;
+  term[ALIGN_TERM_PD] = model.pdCor;
+  term[ALIGN_TERM_AZM] = model.azmCor;
+  term[ALIGN_TERM_ALT] = model.altCor;
+  term[ALIGN_TERM_TF] = model.tfCor;
+  term[ALIGN_TERM_FLEX] = model.dfCor;
+}
+
+// makes n stars spread over both sides of the pier for the model terms given (in arc-seconds), the actual positions
+// are where the stars are seen with the mount at its positions, plus noise of up to the given arc-seconds
+static void alignStars(const double *termArcsec, int n, double noiseArcsec, AlignStar *stars, double decMin = -20.0, double decMax = 80.0) {
+  double term[ALIGN_TERMS];
+  for (int i = 0; i < ALIGN_TERMS; i++) term[i] = arcsecToRad(termArcsec[i]);
+
+  for (int l = 0; l < n; l++) {
+    int side = (l & 1) ? -1 : 1;
+    double h = degToRad(-75.0 + 150.0*(l + 0.5)/n);
+    double d = degToRad(decMin + (decMax - decMin)*fmod(0.3 + l*0.618034, 1.0));
+
+    double a1r, a2r;
+    alignCorrect(term, h + term[ALIGN_TERM_AX1], d + term[ALIGN_TERM_AX2]*side, side, &a1r, &a2r);
+
+    stars[l].mount.h = h;
+    stars[l].mount.d = d;
+    stars[l].mount.pierSide = side == 1 ? PIER_SIDE_EAST : PIER_SIDE_WEST;
+    stars[l].actual.h = h + term[ALIGN_TERM_AX1] - a1r + arcsecToRad(noiseArcsec*(random(2001) - 1000)/1000.0);
+    stars[l].actual.d = d + term[ALIGN_TERM_AX2]*side - a2r + arcsecToRad(noiseArcsec*(random(2001) - 1000)/1000.0);
+    stars[l].actual.pierSide = stars[l].mount.pierSide;
+  }
+}
+
+// rms pointing error remaining at the stars for a model, in arc-seconds
+static double alignRms(const AlignModel &model, const AlignStar *stars, int n) {
+  double term[ALIGN_TERMS];
+  alignTerms(model, term);
+
+  double sum = 0.0;
+  for (int l = 0; l < n; l++) {
+    int side = stars[l].mount.pierSide == PIER_SIDE_WEST ? -1 : 1;
+    double a1r, a2r;
+    alignCorrect(term, stars[l].mount.h + term[ALIGN_TERM_AX1], stars[l].mount.d + term[ALIGN_TERM_AX2]*side, side, &a1r, &a2r);
+    double r1 = (stars[l].actual.h - stars[l].mount.h - term[ALIGN_TERM_AX1] + a1r)*cos(stars[l].actual.d);
+    double r2 = stars[l].actual.d - stars[l].mount.d - term[ALIGN_TERM_AX2]*side + a2r;
+    sum += r1*r1 + r2*r2;
+  }
+  return radToArcsec(sqrt(sum/n));
+}
+
+// loads the stars into the align model and solves it one iteration at a time (as the task would), returns the iterations
+static int alignSolve(const AlignStar *stars, int n) {
+  transform.align.init(GEM, degToRad(ALIGN_LATITUDE));
+  for (int l = 0; l < n; l++) {
+    Coordinate actual = stars[l].actual, mount = stars[l].mount;
+    transform.align.addStar(l + 1, n, &actual, &mount);
+  }
+  // the last star starts the model task, but without tasks.yield() it never runs
+  int iterations = 0;
+  do { transform.align.autoModel(n); iterations++; } while (!transform.align.modelReady() && !transform.align.modelFailed() && iterations < 1000);
+  return iterations;
+}
@@ -0,0 +1,53 @@
+// -----------------------------------------------------------------------------------
+// I2C memory for the simulated bus, a 24XX series EEPROM or an 85RC series FRAM with 16 bit addresses
+#pragma once
+
+#include <Wire.h>
+
+class SimI2cMemory : public SimI2cDevice {
+  public:
+    // pageSize: bytes a write wraps around within (0 for none, FRAM), writeMicros: write cycle time (0 for none, FRAM)
+    SimI2cMemory(uint16_t size, uint16_t pageSize, unsigned long writeMicros) : size(size), pageSize(pageSize), writeMicros(writeMicros) {
+      memory = new uint8_t[size];
+      memset(memory, 0xff, size);
+    }
+    ~SimI2cMemory() { delete[] memory; }
+
+    bool ready() { return !writing || (long)(micros() - writeStartMicros) >= (long)writeMicros; }
+
+    bool receive(const uint8_t *data, size_t count) {
+      writing = false;
+      if (count < 2) return true;
+      address = ((data[0] << 8) | data[1]) % size;
+      if (count == 2) return true;
+
+      // a write past the end of the page wraps around to its start, over what was written already
+      for (size_t k = 2; k < count; k++) {
+        memory[address] = data[k];
+        if (pageSize > 0 && (address + 1) % pageSize == 0) { address -= pageSize - 1; if (k + 1 < count) pageWraps++; } else address = (address + 1) % size;
+      }
+      writes++;
+      bytesWritten += count - 2;
+      if (writeMicros > 0) { writing = true; writeStartMicros = micros(); }
+      return true;
+    }
+
+    size_t transmit(uint8_t *data, size_t count) {
+      for (size_t k = 0; k < count; k++) { data[k] = memory[address]; address = (address + 1) % size; }
+      reads++;
+      return count;
+    }
+
+    uint8_t *memory;
+    uint16_t size;
+    uint16_t pageSize;
+    unsigned long writeMicros;
+
+    // write transactions and bytes written, reads, and writes that ran past the end of a page
+    unsigned long writes = 0, bytesWritten = 0, reads = 0, pageWraps = 0;
+
+  private:
+    uint16_t address = 0;
+    bool writing = false;
+    unsigned long writeStartMicros = 0;
+};
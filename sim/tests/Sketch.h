@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------
+// runs the whole sketch on the virtual clock and talks to it over Serial, for tests of the firmware
+#pragma once
+
+#include <string>
+#include "src/Common.h"
+
+extern void setup();
+extern void loop();
+
+// run the sketch for the given virtual time in seconds, calling each() after every pass through loop() if given
+static inline void sketchRun(double seconds, void (*each)() = NULL) {
+  unsigned long long endMicros = (unsigned long long)(seconds*1000000.0);
+  unsigned long long elapsedMicros = 0;
+  unsigned long lastMicros = micros();
+  while (elapsedMicros < endMicros) {
+    loop();
+    yield();
+    if (each != NULL) each();
+    unsigned long now = micros();
+    elapsedMicros += now - lastMicros;
+    lastMicros = now;
+  }
+}
+
+// send a command and return the reply, the sketch runs until a reply has come and nothing more follows for 10 ms
+// or for up to a second when there's no reply, calling each() after every pass through loop() if given
+static inline std::string sketchCommand(const char *command, void (*each)() = NULL) {
+  std::string reply;
+  simSerialCapture = &reply;
+  simSerialInput(command);
+  size_t length = 0;
+  for (int ms = 0, quiet = 0; ms < 1000 && !(length > 0 && quiet >= 10); ms++) {
+    sketchRun(0.001, each);
+    if (reply.length() == length) quiet++; else { length = reply.length(); quiet = 0; }
+  }
+  simSerialCapture = NULL;
+  return reply;
+}
@@ -0,0 +1,27 @@
+// -----------------------------------------------------------------------------------
+// minimal checks and timing for the host tests and benchmarks
+#pragma once
+
+#include <stdio.h>
+#include <chrono>
+
+static int testChecks = 0;
+static int testFailures = 0;
+
+// record a check, on failure report where and carry on
+#define CHECK(condition) do { testChecks++; if (!(condition)) { testFailures++; printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); } } while (0)
+
+// as above for two values that can be printed as doubles
+#define CHECK_NEAR(value, expected, tolerance) do { testChecks++; double _v = (value), _e = (expected); \
+  if (!(fabs(_v - _e) <= (tolerance))) { testFailures++; printf("FAIL %s:%d: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, #value, _v, _e, (double)(tolerance)); } } while (0)
+
+// report the results, use as the return value of main()
+static inline int testResult() {
+  if (testFailures == 0) printf("passed %d checks\n", testChecks); else printf("FAILED %d of %d checks\n", testFailures, testChecks);
+  return testFailures == 0 ? 0 : 1;
+}
+
+// host (wall clock) time in nanoseconds, for benchmarks
+static inline double hostNanos() {
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
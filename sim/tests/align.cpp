@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------------
+// pointing model solver, recovers the model the align stars were made with
+
+#include "src/Common.h"
+#include "AlignStars.h"
+
+NVS nv;
+
+static const double truth[ALIGN_TERMS] = { 600.0, -300.0, 200.0, 60.0, 900.0, -1200.0, 30.0, 40.0 };
+
+int main() {
+  AlignStar stars[ALIGN_MAX_NUM_STARS];
+  double term[ALIGN_TERMS];
+
+  // with exact stars every term the star count supports comes back to within an arc-second
+  for (int n = 2; n <= ALIGN_MAX_NUM_STARS; n++) {
+    double t[ALIGN_TERMS];
+    for (int i = 0; i < ALIGN_TERMS; i++) t[i] = truth[i];
+    // two stars fit the offsets and polar alignment, three or four add cone error
+    if (n <= 4) t[ALIGN_TERM_PD] = t[ALIGN_TERM_TF] = t[ALIGN_TERM_FLEX] = 0.0;
+    if (n <= 2) t[ALIGN_TERM_DO] = 0.0;
+
+    alignStars(t, n, 0.0, stars);
+    alignSolve(stars, n);
+    CHECK(transform.align.modelReady());
+    CHECK(!transform.align.modelFailed());
+    CHECK_NEAR(radToArcsec(transform.align.rms), 0.0, 0.5);
+    CHECK_NEAR(alignRms(transform.align.model, stars, n), 0.0, 0.5);
+    alignTerms(transform.align.model, term);
+    for (int i = 0; i < ALIGN_TERMS; i++) CHECK_NEAR(radToArcsec(term[i]), t[i], 1.0);
+  }
+
+  // with noise the fit is about as good as the noise allows and the residuals reported match
+  alignStars(truth, 9, 5.0, stars);
+  alignSolve(stars, 9);
+  CHECK(transform.align.modelReady());
+  CHECK(alignRms(transform.align.model, stars, 9) < 5.0);
+  CHECK_NEAR(radToArcsec(transform.align.rms), alignRms(transform.align.model, stars, 9), 0.1);
+  double sum = 0.0;
+  for (int l = 0; l < 9; l++) sum += sq(radToArcsec(transform.align.residual[l]));
+  CHECK_NEAR(sqrt(sum/9), radToArcsec(transform.align.rms), 0.1);
+
+  // stars on the celestial equator leave the pole to axis2 term with no effect (its column of the Jacobian is zero)
+  // the other terms are still fit rather than the solver giving up at the starting point
+  alignStars(truth, 6, 0.0, stars, 0.0, 0.0);
+  alignSolve(stars, 6);
+  CHECK(transform.align.modelReady());
+  CHECK_NEAR(alignRms(transform.align.model, stars, 6), 0.0, 1.0);
+
+  // a star that can't be fit (bad coordinates) fails the model, which is left cleared and not used
+  alignStars(truth, 6, 0.0, stars);
+  stars[3].actual.d = NAN;
+  alignSolve(stars, 6);
+  CHECK(!transform.align.modelReady());
+  CHECK(transform.align.modelFailed());
+  alignTerms(transform.align.model, term);
+  for (int i = 0; i < ALIGN_TERMS; i++) CHECK(term[i] == 0.0);
+
+  return testResult();
+}
@@ -0,0 +1,211 @@
+// -----------------------------------------------------------------------------------
+// pointing model solver (Levenberg-Marquardt) against the grid search it replaced, host time and rms on synthetic stars
+
+#include "src/Common.h"
+#include "AlignStars.h"
+
+NVS nv;
+
+// the grid search GeoAlign::autoModel() used before, as it was for HAL_FAST_PROCESSOR (less the Y; in its inner loop)
+class GridAlign {
+  public:
+    void autoModel(int n, const AlignStar *stars);
+    AlignModel model;
+
+  private:
+    void correct(AlignCoordinate &mount, float sf, float _deo, float _pd, float _pz, float _pe, float _df, float _ff, float _tf, float *a1r, float *a2r);
+    void doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9);
+
+    AlignCoordinate mount[ALIGN_MAX_NUM_STARS];
+    AlignCoordinate actual[ALIGN_MAX_NUM_STARS];
+    AlignCoordinate delta[ALIGN_MAX_NUM_STARS];
+    float cosLat = cosf(degToRad(ALIGN_LATITUDE)), sinLat = sinf(degToRad(ALIGN_LATITUDE));
+    long num, l;
+    float best_deo, best_pd, best_pz, best_pe, best_ohw, best_odw, best_ohe, best_ode, best_tf, best_df, best_ff;
+    float best_dist;
+    float ohe, ode, ohw, odw;
+    float sum1;
+    float max_dist;
+};
+
+void GridAlign::correct(AlignCoordinate &mount, float sf, float _deo, float _pd, float _pz, float _pe, float _df, float _ff, float _tf, float *a1r, float *a2r) {
+  float DOh = _deo*sf*(1.0F/mount.cosA2)*mount.side;
+  float PDh = -_pd*sf*mount.tanA2*mount.side;
+  float PZ  = _pz*sf;
+  float PA  = _pe*sf;
+  float DFd = -_df*sf*(cosLat*mount.cosA1 + sinLat*mount.tanA2);
+  float FFd = _ff*sf*mount.cosA1;
+  float TF  = _tf*sf;
+  float TFh = TF*(cosLat*mount.sinA1*(1.0/mount.cosA2));
+  float TFd = TF*(cosLat*mount.cosA1*mount.sinA2 - sinLat*mount.cosA2);
+  *a1r = (-PZ*mount.cosA1*mount.tanA2 + PA*mount.sinA1*mount.tanA2 + DOh + PDh + TFh);
+  *a2r = (+PZ*mount.sinA1             + PA*mount.cosA1             + DFd + FFd + TFd);
+}
+
+void GridAlign::doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
+  long _deo_m, _deo_p, _pd_m, _pd_p, _pz_m, _pz_p, _pe_m, _pe_p, _df_m, _df_p, _tf_m, _tf_p, _ff_m, _ff_p, _oh_m, _oh_p, _od_m, _od_p;
+  long _deo, _pd, _pz, _pe, _df, _tf, _ff, _ode, _ohe;
+
+  float sf1 = arcsecToRad(sf);
+
+  _deo_m= -p1 + round(best_deo/sf); _deo_p= p1 + round(best_deo/sf);
+  _pd_m = -p2 + round(best_pd/sf);  _pd_p = p2 + round(best_pd/sf);
+  _pz_m = -p3 + round(best_pz/sf);  _pz_p = p3 + round(best_pz/sf);
+  _pe_m = -p4 + round(best_pe/sf);  _pe_p = p4 + round(best_pe/sf);
+  _tf_m = -p5 + round(best_tf/sf);  _tf_p = p5 + round(best_tf/sf);
+  _ff_m = -p6 + round(best_ff/sf);  _ff_p = p6 + round(best_ff/sf);
+  _df_m = -p7 + round(best_df/sf);  _df_p = p7 + round(best_df/sf);
+  _od_m = -p8 + round(best_ode/sf); _od_p = p8 + round(best_ode/sf);
+  _oh_m = -p9 + round(best_ohe/sf); _oh_p = p9 + round(best_ohe/sf);
+
+  float ma2, ma1;
+  for (_ohe = _oh_m; _ohe <= _oh_p; _ohe++)
+  for (_ode = _od_m; _ode <= _od_p; _ode++) {
+    ode = _ode*sf1;
+    odw = -ode;
+    ohe = _ohe*sf1;
+    ohw = ohe;
+
+    for (l = 0; l < num; l++) {
+      ma1 = mount[l].ax1;
+      ma2 = mount[l].ax2;
+      if (mount[l].side == -1) { ma1 = ma1 + ohw; ma2 = ma2 + odw; } else { ma1 = ma1 + ohe; ma2 = ma2 + ode; }
+      mount[l].ma1 = ma1;
+      mount[l].ma2 = ma2;
+      mount[l].sinA1 = sinf(ma1);
+      mount[l].cosA1 = cosf(ma1);
+      mount[l].sinA2 = sinf(ma2);
+      mount[l].cosA2 = cosf(ma2);
+      mount[l].tanA2 = mount[l].sinA2/mount[l].cosA2;
+    }
+
+    for (_deo = _deo_m; _deo <= _deo_p; _deo++)
+    for (_pd = _pd_m; _pd <= _pd_p; _pd++)
+    for (_pz = _pz_m; _pz <= _pz_p; _pz++)
+    for (_pe = _pe_m; _pe <= _pe_p; _pe++)
+    for (_df = _df_m; _df <= _df_p; _df++)
+    for (_ff = _ff_m; _ff <= _ff_p; _ff++)
+    for (_tf = _tf_m; _tf <= _tf_p; _tf++) {
+      for (l = 0; l < num; l++) {
+        float ma1r, ma2r;
+        correct(mount[l], sf1, _deo, _pd, _pz, _pe, _df, _ff, _tf, &ma1r, &ma2r);
+        delta[l].ax1 = actual[l].ax1 - (mount[l].ma1 - ma1r);
+        if (delta[l].ax1 >  Deg180) delta[l].ax1 = delta[l].ax1 - Deg360; else
+        if (delta[l].ax1 < -Deg180) delta[l].ax1 = delta[l].ax1 + Deg360;
+        delta[l].ax2 = actual[l].ax2 - (mount[l].ma2 - ma2r);
+      }
+
+      float a, b;
+      sum1 = 0.0;
+      for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax1*cosf(actual[l].ax2));
+      a = sum1/(num - 1);
+      sum1 = 0.0;
+      for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax2);
+      b = sum1/(num - 1);
+      max_dist = sqrtf(a + b);
+
+      if (max_dist < best_dist) {
+        best_dist = max_dist;
+        best_deo  = _deo*sf;
+        best_pd   = _pd*sf;
+        best_pz   = _pz*sf;
+        best_pe   = _pe*sf;
+        best_tf   = _tf*sf;
+        best_df   = _df*sf;
+        best_ff   = _ff*sf;
+        if (p8 != 0) best_odw = radToArcsec(odw); else best_odw = best_pe/2.0;
+        if (p8 != 0) best_ode = radToArcsec(ode); else best_ode = -best_pe/2.0;
+        if (p9 != 0) best_ohw = radToArcsec(ohw);
+        if (p9 != 0) best_ohe = radToArcsec(ohe);
+      }
+    }
+  }
+}
+
+void GridAlign::autoModel(int n, const AlignStar *stars) {
+  num = n;
+  for (l = 0; l < num; l++) {
+    mount[l].ax1 = stars[l].mount.h;
+    mount[l].ax2 = stars[l].mount.d;
+    mount[l].side = stars[l].mount.pierSide == PIER_SIDE_WEST ? -1 : 1;
+    actual[l].ax1 = stars[l].actual.h;
+    actual[l].ax2 = stars[l].actual.d;
+  }
+
+  best_dist = 3600.0F*180.0F;
+  best_deo = best_pd = best_pz = best_pe = best_tf = best_ff = best_df = best_ode = best_ohe = 0.0F;
+
+  ohe = 0;
+  for (l = 0; l < num; l++) {
+    float diff = actual[l].ax1 - mount[l].ax1;
+    if (diff >  Deg180) diff = diff - Deg360;
+    if (diff < -Deg180) diff = diff + Deg360;
+    ohe = ohe + diff;
+  }
+  ohe = ohe/num;
+  best_ohe = round(radToArcsec(ohe));
+  best_ohw = best_ohe;
+
+  // German equatorial mount, axis2 flex
+  long Ff = 0, Df = 1;
+  int Do = num > 2 ? 1 : 0;
+
+  doSearch(16384,0 ,0,1,1,0, 0, 0,1,1);
+  doSearch( 8192,Do,0,1,1,0, 0, 0,1,1);
+  doSearch( 4096,Do,0,1,1,0, 0, 0,1,1);
+  doSearch( 2048,Do,0,1,1,0, 0, 0,1,1);
+  doSearch( 1024,Do,0,1,1,0, 0, 0,1,1);
+  doSearch(  512,Do,0,1,1,0, 0, 0,1,1);
+  if (num > 4) {
+    doSearch(256,Do,1,1,1,0,Ff,Df,1,1);
+    doSearch(128,Do,1,1,1,1,Ff,Df,1,1);
+    doSearch( 64,Do,1,1,1,1,Ff,Df,1,1);
+    doSearch( 32,Do,1,1,1,1,Ff,Df,1,1);
+    doSearch( 16,Do,1,1,1,1,Ff,Df,1,1);
+    doSearch(  8,Do,1,1,1,1,Ff,Df,1,1);
+  } else {
+    doSearch(256,Do,0,1,1,0, 0, 0,1,1);
+    doSearch(128,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 32,Do,0,1,1,0, 0, 0,1,1);
+    doSearch( 16,Do,0,1,1,0, 0, 0,1,1);
+    doSearch(  8,Do,0,1,1,0, 0, 0,1,1);
+  }
+
+  model.doCor = arcsecToRad(best_deo);
+  model.pdCor = arcsecToRad(best_pd);
+  model.azmCor = arcsecToRad(best_pz);
+  model.altCor = arcsecToRad(best_pe);
+  model.tfCor = arcsecToRad(best_tf);
+  model.dfCor = arcsecToRad(best_df);
+  model.ax1Cor = arcsecToRad(best_ohw);
+  model.ax2Cor = arcsecToRad(best_odw);
+}
+
+static const double truth[ALIGN_TERMS] = { 600.0, -300.0, 200.0, 60.0, 900.0, -1200.0, 30.0, 40.0 };
+
+int main() {
+  static GridAlign grid;
+  AlignStar stars[ALIGN_MAX_NUM_STARS];
+
+  printf("stars noise    LM: iterations      ms   rms(\")    grid search:      ms   rms(\")\n");
+  for (int n = 3; n <= ALIGN_MAX_NUM_STARS; n += 3) {
+    for (int noise = 0; noise <= 10; noise += 10) {
+      alignStars(truth, n, noise, stars);
+
+      double t0 = hostNanos();
+      int iterations = alignSolve(stars, n);
+      double lmMs = (hostNanos() - t0)/1.0E6;
+      double lmRms = transform.align.modelReady() ? alignRms(transform.align.model, stars, n) : NAN;
+
+      t0 = hostNanos();
+      grid.autoModel(n, stars);
+      double gridMs = (hostNanos() - t0)/1.0E6;
+      double gridRms = alignRms(grid.model, stars, n);
+
+      printf("%5d %4d\"            %4d %7.2f %8.2f                  %7.1f %8.2f\n", n, noise, iterations, lmMs, lmRms, gridMs, gridRms);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------------
+// command dispatch, host time for a replayed stream of the commands apps poll with, routed on two characters by the
+// dispatch table in Telescope against routing on the first character and against every handler tried in turn (as
+// Telescope::command() did before), the replies must all match
+
+#include "Sketch.h"
+#include "src/lib/commands/CommandDispatch.h"
+#include "src/telescope/Telescope.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/goto/Goto.h"
+#include "src/telescope/mount/guide/Guide.h"
+#include "src/telescope/mount/home/Home.h"
+#include "src/telescope/mount/library/Library.h"
+#include "src/telescope/mount/limits/Limits.h"
+#include "src/telescope/mount/park/Park.h"
+#include "src/telescope/mount/pec/Pec.h"
+#include "src/telescope/mount/site/Site.h"
+#include "src/telescope/mount/status/Status.h"
+#include "src/telescope/rotator/Rotator.h"
+#include "src/telescope/focuser/Focuser.h"
+#include "src/telescope/auxiliary/Features.h"
+#include "Test.h"
+
+#define PASSES 20000
+#define ROUNDS 5
+
+#define COMMAND_HANDLER(object) [](char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError) \
+  { return object.command(reply, command, parameter, supressFrame, numericReply, commandError); }
+
+// a status poll as the apps send it, then a few less frequent ones
+static const char *stream[] = {
+  ":GR#", ":GD#", ":GU#", ":Gu#", ":GA#", ":GZ#", ":GS#", ":GL#", ":GC#", ":Gm#", ":GT#", ":Gr#", ":Gd#", ":Gt#", ":Gg#",
+  ":GW#", ":GX40#", ":GX43#", ":GXA2#", ":FA#", ":LI#", ":$QZ?#"
+};
+#define STREAM_COMMANDS (int)(sizeof(stream)/sizeof(stream[0]))
+
+// every handler registered for every character, in the order Telescope::command() called them
+static CommandDispatch chain;
+
+// handlers registered for the first characters of their commands only
+static CommandDispatch firstChar;
+
+static void dispatchInit() {
+  char all[200] = "";
+  for (char c = '!'; c <= '~'; c++) { char s[3] = { c, ' ', 0 }; strcat(all, s); }
+
+  #ifdef MOUNT_PRESENT
+    chain.add(all, COMMAND_HANDLER(mount));       firstChar.add("$ % G S T",     COMMAND_HANDLER(mount));
+    chain.add(all, COMMAND_HANDLER(guide));       firstChar.add("G M Q R",       COMMAND_HANDLER(guide));
+    chain.add(all, COMMAND_HANDLER(gpio));        firstChar.add("G S",           COMMAND_HANDLER(gpio));
+    chain.add(all, COMMAND_HANDLER(mountStatus)); firstChar.add("G S",           COMMAND_HANDLER(mountStatus));
+    chain.add(all, COMMAND_HANDLER(goTo));        firstChar.add("A C D G M S",   COMMAND_HANDLER(goTo));
+    chain.add(all, COMMAND_HANDLER(park));        firstChar.add("h",             COMMAND_HANDLER(park));
+    chain.add(all, COMMAND_HANDLER(library));     firstChar.add("L",             COMMAND_HANDLER(library));
+    chain.add(all, COMMAND_HANDLER(site));        firstChar.add("G S W",         COMMAND_HANDLER(site));
+    chain.add(all, COMMAND_HANDLER(limits));      firstChar.add("G S",           COMMAND_HANDLER(limits));
+    chain.add(all, COMMAND_HANDLER(home));        firstChar.add("h",             COMMAND_HANDLER(home));
+    chain.add(all, COMMAND_HANDLER(pec));         firstChar.add("$ G S V W",     COMMAND_HANDLER(pec));
+    chain.add(all, COMMAND_HANDLER(axis1));       firstChar.add("G S",           COMMAND_HANDLER(axis1));
+    chain.add(all, COMMAND_HANDLER(axis2));       firstChar.add("G S",           COMMAND_HANDLER(axis2));
+  #endif
+  #ifdef ROTATOR_PRESENT
+    chain.add(all, COMMAND_HANDLER(rotator));     firstChar.add("G S h r",       COMMAND_HANDLER(rotator));
+  #endif
+  #ifdef FOCUSER_PRESENT
+    chain.add(all, COMMAND_HANDLER(focuser));     firstChar.add("F G S h",       COMMAND_HANDLER(focuser));
+  #endif
+  #ifdef FEATURES_PRESENT
+    chain.add(all, COMMAND_HANDLER(features));    firstChar.add("G S",           COMMAND_HANDLER(features));
+  #endif
+}
+
+typedef struct Result {
+  bool handled;
+  CommandError error;
+  bool supressFrame, numericReply;
+  char reply[80];
+} Result;
+
+// split ":GR#" into command "GR" and parameter "" as the command buffer does, then run it
+static Result run(const char *s, int dispatch) {
+  char command[3] = { s[1], s[2], 0 };
+  char parameter[40];
+  strcpy(parameter, s + 3);
+  parameter[strlen(parameter) - 1] = 0;
+
+  Result r;
+  r.reply[0] = 0;
+  r.error = CE_NONE;
+  r.supressFrame = false;
+  r.numericReply = true;
+  switch (dispatch) {
+    case 0: r.handled = chain.command(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error); break;
+    case 1: r.handled = firstChar.command(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error); break;
+    default: r.handled = telescope.command(r.reply, command, parameter, &r.supressFrame, &r.numericReply, &r.error); break;
+  }
+  return r;
+}
+
+// host nanoseconds per command, the best of ROUNDS runs of PASSES passes over the command
+static double timed(const char *s, int dispatch) {
+  double best = 0.0;
+  for (int round = 0; round < ROUNDS; round++) {
+    double start = hostNanos();
+    for (int i = 0; i < PASSES; i++) run(s, dispatch);
+    double ns = (hostNanos() - start)/PASSES;
+    if (round == 0 || ns < best) best = ns;
+  }
+  return best;
+}
+
+int main() {
+  setup();
+  sketchRun(2.0);
+  dispatchInit();
+
+  printf("%-8s %12s %12s %12s\n", "command", "chain ns", "first ns", "routed ns");
+  double total[3] = { 0.0, 0.0, 0.0 };
+  for (int i = 0; i < STREAM_COMMANDS; i++) {
+    Result a = run(stream[i], 0);
+    CHECK(a.handled);
+    for (int d = 1; d < 3; d++) {
+      Result b = run(stream[i], d);
+      CHECK(a.handled == b.handled && a.error == b.error && a.supressFrame == b.supressFrame && a.numericReply == b.numericReply);
+      CHECK(strcmp(a.reply, b.reply) == 0);
+    }
+
+    double ns[3];
+    for (int d = 0; d < 3; d++) { ns[d] = timed(stream[i], d); total[d] += ns[d]; }
+    printf("%-8s %12.1f %12.1f %12.1f\n", stream[i], ns[0], ns[1], ns[2]);
+  }
+  printf("commands/s %10.0f %12.0f %12.0f\n", STREAM_COMMANDS*1.0E9/total[0], STREAM_COMMANDS*1.0E9/total[1], STREAM_COMMANDS*1.0E9/total[2]);
+
+  return testResult();
+}
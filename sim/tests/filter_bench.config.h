@@ -0,0 +1,4 @@
+
+// -----------------------------------------------------------------------------------
+// servo encoder filters on their own, no servo axis is configured so they're enabled here
+#define SERVO_MOTOR_PRESENT
@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------
+// servo encoder filters on a synthetic encoder trace, a slow sinusoid on a ramp with gaussian count noise and then
+// with occasional large glitches added, rms error against the true position and host time per update
+
+#include "src/Common.h"
+#include "src/lib/axis/motor/servo/filter/Median/Median.h"
+#include "src/lib/axis/motor/servo/filter/AlphaBeta/AlphaBeta.h"
+#include "src/lib/axis/motor/servo/filter/Kalman/Kalman.h"
+#include "Test.h"
+
+#include <vector>
+
+#define SAMPLES 200000
+#define NOISE_SIGMA 2.0
+#define GLITCH_PERCENT 0.5
+#define GLITCH_COUNTS 500
+
+// deterministic gaussian noise (Box-Muller on a 64 bit LCG)
+static uint64_t seed = 1;
+static double uniform() {
+  seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+  return ((seed >> 11) + 0.5)/9007199254740992.0;
+}
+static double gaussian() {
+  return sqrt(-2.0*log(uniform()))*cos(2.0*M_PI*uniform());
+}
+
+// true position in counts at control cycle i, about 0.05 counts per cycle of ramp and a 2000 count swing
+static double truth(int i) {
+  return 0.05*i + 1000.0*sin(2.0*M_PI*i/50000.0);
+}
+
+typedef struct Result {
+  double rms;
+  double ns;
+} Result;
+
+// run the trace through the filter (or straight through for NULL), rms from the 1000th sample on so it has settled
+static Result run(Filter *filter, const std::vector<int32_t> &trace) {
+  std::vector<int32_t> out(trace.size());
+  if (filter != NULL) filter->reset(trace[0]);
+
+  double start = hostNanos();
+  if (filter != NULL) {
+    for (size_t i = 0; i < trace.size(); i++) out[i] = filter->update(trace[i]);
+  } else {
+    for (size_t i = 0; i < trace.size(); i++) out[i] = trace[i];
+  }
+  Result r;
+  r.ns = (hostNanos() - start)/trace.size();
+
+  double sum = 0.0;
+  for (size_t i = 1000; i < trace.size(); i++) { double e = out[i] - truth(i); sum += e*e; }
+  r.rms = sqrt(sum/(trace.size() - 1000));
+
+  return r;
+}
+
+int main() {
+  std::vector<int32_t> noisy(SAMPLES), glitchy(SAMPLES);
+  int glitches = 0;
+  for (int i = 0; i < SAMPLES; i++) {
+    noisy[i] = lround(truth(i) + NOISE_SIGMA*gaussian());
+    glitchy[i] = noisy[i];
+    if (uniform()*100.0 < GLITCH_PERCENT) { glitchy[i] += GLITCH_COUNTS; glitches++; }
+  }
+  CHECK(glitches > 0);
+
+  Median median(SERVO_FLTR_MEDIAN_WIDTH);
+  AlphaBeta alphaBeta(SERVO_FLTR_ALPHA, SERVO_FLTR_BETA, SERVO_FLTR_GAMMA);
+  Kalman kalman(SERVO_FLTR_MEAS_VAR, SERVO_FLTR_PROC_VAR);
+
+  static const char *names[] = { "none", "median", "alpha-beta", "Kalman" };
+  Filter *filters[] = { NULL, &median, &alphaBeta, &kalman };
+
+  printf("%d samples, noise sigma %.1f counts, %d glitches of %d counts\n", SAMPLES, NOISE_SIGMA, glitches, GLITCH_COUNTS);
+  printf("%-12s %10s %12s %10s\n", "filter", "rms", "glitch rms", "ns/update");
+  Result noise[4], glitch[4];
+  for (int f = 0; f < 4; f++) {
+    noise[f] = run(filters[f], noisy);
+    glitch[f] = run(filters[f], glitchy);
+    printf("%-12s %10.2f %12.2f %10.1f\n", names[f], noise[f].rms, glitch[f].rms, noise[f].ns);
+  }
+
+  // unfiltered the error is the noise (and the rounding to whole counts)
+  CHECK_NEAR(noise[0].rms, NOISE_SIGMA, 0.1);
+
+  // each filter does better than no filter on noise, with the Kalman gains doing better than the default alpha-beta ones
+  for (int f = 1; f < 4; f++) CHECK(noise[f].rms < noise[0].rms);
+  CHECK(noise[3].rms < noise[2].rms);
+
+  // the median rejects the glitches, the others spread them out
+  CHECK(glitch[1].rms < noise[0].rms);
+  CHECK(glitch[1].rms < glitch[0].rms/10.0);
+
+  return testResult();
+}
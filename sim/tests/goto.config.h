@@ -0,0 +1,3 @@
+// goto test, both axes arrive together
+#undef GOTO_SYNCHRONIZED
+#define GOTO_SYNCHRONIZED ON
@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------------
+// goto timing and overshoot, the whole sketch running a goto from home on the virtual clock
+
+#include "Sketch.h"
+#include "src/telescope/mount/Mount.h"
+#include "src/telescope/mount/goto/Goto.h"
+#include "Test.h"
+
+// what's seen of an axis over the first slew of a goto
+typedef struct AxisSlew {
+  Axis *axis;
+  bool started, stopped;
+  double startSeconds, stopSeconds;
+  float estimateSeconds;
+  int direction;
+  long overshootSteps;
+} AxisSlew;
+
+static AxisSlew slew[2];
+
+static void watch() {
+  double seconds = micros()/1000000.0;
+  for (int i = 0; i < 2; i++) {
+    AxisSlew *s = &slew[i];
+    long distance = s->axis->getTargetCoordinateSteps() - s->axis->getInstrumentCoordinateSteps();
+    if (!s->started) {
+      if (s->axis->isSlewing() && s->axis->getTargetDistance() > degToRad(0.5)) {
+        s->started = true;
+        s->startSeconds = seconds;
+        s->estimateSeconds = s->axis->getAutoGotoTime();
+        s->direction = distance >= 0 ? 1 : -1;
+      }
+    } else
+    if (!s->stopped) {
+      // steps past the target in the direction of travel
+      if (-distance*s->direction > s->overshootSteps) s->overshootSteps = -distance*s->direction;
+      if (!s->axis->isSlewing()) { s->stopped = true; s->stopSeconds = seconds; }
+    }
+  }
+}
+
+// goto the given coordinates from wherever the mount is and report on the first slew of each axis
+static void gotoTest(const char *ra, const char *dec) {
+  for (int i = 0; i < 2; i++) slew[i] = { i == 0 ? &axis1 : &axis2, false, false, 0.0, 0.0, 0.0F, 0, 0 };
+
+  char command[40];
+  sprintf(command, ":Sr%s#:Sd%s#", ra, dec);
+  CHECK(sketchCommand(command) == "11");
+  CHECK(sketchCommand(":MS#", watch) == "0");
+  sketchRun(120.0, watch);
+  CHECK(goTo.state == GS_NONE);
+
+  for (int i = 0; i < 2; i++) {
+    CHECK(slew[i].started && slew[i].stopped);
+    double seconds = slew[i].stopSeconds - slew[i].startSeconds;
+    printf("axis%d %6.2f s (estimated %6.2f s), overshoot %ld steps\n", i + 1, seconds, slew[i].estimateSeconds, slew[i].overshootSteps);
+
+    // the motor stops at the target step, it never runs past it
+    CHECK(slew[i].overshootSteps <= 0);
+  }
+
+  // axis2's target stands still (axis1's moves with tracking, so takes longer than estimated here) and the
+  // rate is updated 100 times a second (FRACTIONAL_SEC) which leaves it within a few of those of the estimate
+  CHECK_NEAR(slew[1].stopSeconds - slew[1].startSeconds, slew[1].estimateSeconds, 0.05);
+
+  // and the two axes arrive together
+  CHECK_NEAR(slew[0].stopSeconds, slew[1].stopSeconds, 0.1);
+}
+
+int main() {
+  setup();
+
+  // the date, time and site have to be known before a goto is accepted
+  CHECK(sketchCommand(":SC10/17/26#") == "1");
+  CHECK(sketchCommand(":SL20:00:00#") == "1");
+  CHECK(sketchCommand(":St+40*00#") == "1");
+  CHECK(sketchCommand(":Sg+000*00#") == "1");
+
+  // from the pole, axis1 has further to go
+  gotoTest("23:30:00", "+60:00:00");
+  // and now axis2 has further to go
+  gotoTest("23:00:00", "+10:00:00");
+
+  return testResult();
+}
@@ -0,0 +1,5 @@
+// IP serial test, one standard WiFi command server port serving the most clients it can
+#undef SERIAL_IP_MODE
+#define SERIAL_IP_MODE WIFI_ACCESS_POINT
+#define SERIAL_SERVER STANDARD
+#define SERIAL_SERVER_CLIENTS 8
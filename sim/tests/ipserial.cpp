@@ -0,0 +1,140 @@
+// -----------------------------------------------------------------------------------
+// WiFi IP serial command server, many simulated clients on one port with a command channel polling it as
+// CommandProcessor::poll() does, checks each client gets all of its own replies and measures latency under load
+
+#include "src/Common.h"
+#include "src/lib/serial/Serial_IP_Wifi.h"
+#include "Test.h"
+
+#include <vector>
+
+// the IP serial code starts the WiFi through this, there's nothing to start here
+bool WifiManager::init() { return true; }
+WifiManager wifiManager;
+
+static unsigned long polls = 0;
+
+// one pass of the command channel, takes at most one command and echoes it back as the reply
+static bool serve() {
+  polls++;
+  char command[IP_CLIENT_BUFFER_SIZE + 1];
+  int length = 0;
+  while (SerialIP.available() && length < IP_CLIENT_BUFFER_SIZE) {
+    char c = SerialIP.read();
+    command[length++] = c;
+    if (c == '#' || c == (char)6) break;
+  }
+  if (length == 0) return false;
+  SerialIP.write((const uint8_t *)command, length);
+  return true;
+}
+
+static std::string commandFor(int client, int i) {
+  char s[16];
+  sprintf(s, ":C%d,%d#", client, i);
+  return s;
+}
+
+// clients that each send a command and wait for its reply before sending the next, returns the latencies in polls
+static std::vector<unsigned long> closedLoop(int clientCount, int commands, double *hostNsPerCommand) {
+  std::vector<SimTcp> clients;
+  std::vector<int> sent(clientCount, 0);
+  std::vector<unsigned long> sentAt(clientCount, 0);
+  std::vector<bool> waiting(clientCount, false);
+  std::vector<unsigned long> latency;
+  for (int i = 0; i < clientCount; i++) clients.push_back(simWiFiConnect(9999));
+
+  double start = hostNanos();
+  int done = 0;
+  while (done < clientCount && polls < 1000000) {
+    done = 0;
+    for (int i = 0; i < clientCount; i++) {
+      SimTcp c = clients[i];
+      if (waiting[i]) {
+        if (c->toClient.empty()) continue;
+        if (c->toClient == commandFor(i, sent[i] - 1)) latency.push_back(polls - sentAt[i]);
+        c->toClient.clear();
+        waiting[i] = false;
+      }
+      if (sent[i] >= commands) { done++; continue; }
+      c->toServer += commandFor(i, sent[i]++);
+      sentAt[i] = polls;
+      waiting[i] = true;
+    }
+    serve();
+  }
+  *hostNsPerCommand = (hostNanos() - start)/(clientCount*commands);
+
+  for (int i = 0; i < clientCount; i++) clients[i]->open = false;
+  for (int i = 0; i < 10; i++) serve();
+  return latency;
+}
+
+int main() {
+  SerialIP.begin(9999);
+
+  // each client pipelines 20 commands, more than its 64 byte buffer holds, and gets all of its replies in order
+  std::vector<SimTcp> clients;
+  std::string expected[SERIAL_SERVER_CLIENTS];
+  for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) {
+    clients.push_back(simWiFiConnect(9999));
+    for (int j = 0; j < 20; j++) { clients[i]->toServer += commandFor(i, j); expected[i] += commandFor(i, j); }
+  }
+  CHECK(expected[0].length() > IP_CLIENT_BUFFER_SIZE);
+  for (int i = 0; i < 1000; i++) serve();
+  bool allReplies = true;
+  for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) if (clients[i]->toClient != expected[i]) allReplies = false;
+  CHECK(allReplies);
+
+  // with every place taken another client is turned away
+  SimTcp extra = simWiFiConnect(9999);
+  serve();
+  CHECK(!extra->open);
+
+  // a full buffer without a complete command is dropped, and the client can carry on
+  clients[0]->toClient.clear();
+  clients[0]->toServer = std::string(IP_CLIENT_BUFFER_SIZE + 10, 'x');
+  for (int i = 0; i < 10; i++) serve();
+  CHECK(clients[0]->toClient.empty());
+  clients[0]->toServer = ":GR#";
+  for (int i = 0; i < 10; i++) serve();
+  CHECK(clients[0]->toClient.find(":GR#") != std::string::npos);
+
+  // a client that leaves frees its place, and the one that takes it is seen as a new connection
+  uint8_t connection[SERIAL_SERVER_CLIENTS];
+  for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) connection[i] = SerialIP.getConnection(i);
+  clients[3]->open = false;
+  serve();
+  SimTcp next = simWiFiConnect(9999);
+  next->toServer = ":GD#";
+  for (int i = 0; i < 10; i++) serve();
+  CHECK(next->open && next->toClient == ":GD#");
+  int changed = 0;
+  for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) if (SerialIP.getConnection(i) != connection[i]) changed++;
+  CHECK(changed == 1);
+
+  // telemetry style writes go to the client chosen, not the one that sent the last command
+  SerialIP.setClient(SerialIP.getClient() == 1 ? 2 : 1);
+  uint8_t chosen = SerialIP.getClient();
+  clients[chosen]->toClient.clear();
+  SerialIP.write((const uint8_t *)"T", 1);
+  CHECK(clients[chosen]->toClient == "T");
+
+  for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) clients[i]->open = false;
+  next->open = false;
+  for (int i = 0; i < 10; i++) serve();
+
+  // latency under load, each command is served within one pass per client
+  printf("%-8s %10s %10s %12s\n", "clients", "mean", "max polls", "host ns/cmd");
+  for (int n = 1; n <= SERIAL_SERVER_CLIENTS; n *= 2) {
+    double ns;
+    std::vector<unsigned long> latency = closedLoop(n, 200, &ns);
+    CHECK(latency.size() == (size_t)n*200);
+    unsigned long sum = 0, worst = 0;
+    for (unsigned long l : latency) { sum += l; if (l > worst) worst = l; }
+    CHECK(worst <= (unsigned long)n);
+    printf("%-8d %10.2f %10lu %12.1f\n", n, latency.empty() ? 0.0 : (double)sum/latency.size(), worst, ns);
+  }
+
+  return testResult();
+}
@@ -0,0 +1,4 @@
+
+// -----------------------------------------------------------------------------------
+// JTW 24 bit BiSS-C encoder on virtual pins, bit-banged, with the default frame
+#define AXIS1_ENCODER JTW_24BIT
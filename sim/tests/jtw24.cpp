@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------------
+// JTW 24 bit BiSS-C frame decode, frames clocked out on the SLO pin as MA falls, laid out as BiSS-C sends them
+// (Ack, Start, Cds, data MSB first, Err, Wrn, inverted CRC6) with the CRC worked out bit by bit here rather than
+// from the decoder's table, no frame captured from the hardware is at hand so these stand in for one
+
+#include "src/Common.h"
+#include "src/lib/encoder/bissc/Jtw24.h"
+#include "Test.h"
+
+#include <vector>
+
+#define MA_PIN 60
+#define SLO_PIN 61
+
+static std::vector<uint8_t> slo;
+static size_t sloIndex = 0;
+
+// the encoder puts the next bit on SLO each time MA falls, and holds SLO low once the frame is done
+static void encoderPins(int pin, int value) {
+  if (pin != MA_PIN || value != LOW) return;
+  digitalWrite(SLO_PIN, sloIndex < slo.size() ? slo[sloIndex] : LOW);
+  sloIndex++;
+}
+
+static void addBits(uint64_t value, int bits) {
+  for (int i = bits - 1; i >= 0; i--) slo.push_back((value >> i) & 1);
+}
+
+// BiSS-C CRC6, x^6 + x^1 + 1 with a zero start, shifted one bit at a time and inverted
+static uint8_t crc6(const std::vector<uint8_t> &bits) {
+  uint8_t crc = 0;
+  for (uint8_t b : bits) {
+    uint8_t feedback = ((crc >> 5) & 1) ^ b;
+    crc = (crc << 1) & 0b111111;
+    if (feedback) crc ^= 0b000011;
+  }
+  return ~crc & 0b111111;
+}
+
+// a frame with the given position, multi-turn count and Err/Wrn bits, badBit >= 0 flips that data bit after the CRC
+static void frame(uint32_t position, uint32_t turns, int err, int wrn, int badBit = -1) {
+  std::vector<uint8_t> data;
+  slo.clear();
+  sloIndex = 0;
+
+  // idle high for a couple of clocks, then Ack low for the encoder's latency, Start high and Cds low
+  addBits(0b11, 2);
+  addBits(0b000, 3);
+  addBits(0b10, 2);
+  size_t start = slo.size();
+
+  #if JTW24_TURNS_FIRST == ON
+    addBits(turns, JTW24_TURN_BITS);
+    addBits(position, 24);
+  #else
+    addBits(position, 24);
+    addBits(turns, JTW24_TURN_BITS);
+  #endif
+  addBits(err, 1);
+  addBits(wrn, 1);
+  data.assign(slo.begin() + start, slo.end());
+  addBits(crc6(data), 6);
+
+  if (badBit >= 0) slo[start + badBit] ^= 1;
+}
+
+static bool clean(Jtw24 &encoder) { return !encoder.warn && !encoder.error; }
+
+int main() {
+  simPinWrite = encoderPins;
+  Jtw24 encoder(MA_PIN, SLO_PIN, 1);
+  encoder.init();
+
+  // the count is the single turn position less half a turn, the multi-turn count doesn't change it in single turn mode
+  frame(0x123456, 0x00ABCD, 0, 0);
+  CHECK(encoder.read() == 0x123456 - 8388608);
+  CHECK(clean(encoder));
+  frame(0x800000, 0x000001, 0, 1);
+  CHECK(encoder.read() == 0);
+  CHECK(clean(encoder));
+  frame(0xFFFFFF, 0xFFFFFF, 0, 0);
+  CHECK(encoder.read() == 8388607);
+  CHECK(clean(encoder));
+
+  // a flipped bit in the position, or in the multi-turn count when it's sent, fails the CRC and the last good count stands
+  for (int bit = 0; bit < 24 + JTW24_TURN_BITS; bit += 7) {
+    frame(0x000010, 0x000002, 0, 0, bit);
+    encoder.warn = false;
+    CHECK(encoder.read() == 8388607);
+    CHECK(encoder.warn);
+  }
+
+  // the Err bit is read after all of the data bits and flags the reading, a good frame after it reads again
+  frame(0x000010, 0x000002, 1, 0);
+  encoder.warn = false;
+  CHECK(encoder.read() == 8388607);
+  CHECK(encoder.warn);
+  frame(0x000010, 0x000002, 0, 0);
+  encoder.warn = false;
+  CHECK(encoder.read() == 0x000010 - 8388608);
+  CHECK(clean(encoder));
+
+  // no Ack, SLO stays high
+  slo.assign(64, 1);
+  sloIndex = 0;
+  encoder.warn = false;
+  CHECK(encoder.read() == 0x000010 - 8388608);
+  CHECK(encoder.warn);
+
+  // with no good frame for over a second the count is lost
+  delay(1100);
+  slo.assign(64, 1);
+  sloIndex = 0;
+  CHECK(encoder.read() == INT32_MAX);
+
+  return testResult();
+}
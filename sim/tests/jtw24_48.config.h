@@ -0,0 +1,5 @@
+
+// -----------------------------------------------------------------------------------
+// JTW 24 bit BiSS-C encoder on virtual pins, bit-banged, with the 48 bit frame (position then multi-turn count)
+#define AXIS1_ENCODER JTW_24BIT
+#define JTW24_TURN_BITS 24
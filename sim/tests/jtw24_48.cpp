@@ -0,0 +1,4 @@
+// -----------------------------------------------------------------------------------
+// JTW BiSS-C frame decode as jtw24, built with JTW24_TURN_BITS 24
+
+#include "jtw24.cpp"
@@ -0,0 +1,3 @@
+// NV test, with the CRC header
+#undef NV_CHECKSUM
+#define NV_CHECKSUM ON
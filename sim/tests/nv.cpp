@@ -0,0 +1,78 @@
+// -----------------------------------------------------------------------------------
+// NV bulk load and the CRC header over the NV regions
+
+#include "src/Common.h"
+#pragma push_macro("NVS")
+#undef NVS
+#include "src/lib/nv/NV_MB85RC.h"
+#pragma pop_macro("NVS")
+#include "src/libApp/nvCheck/NvCheck.h"
+#include "I2cMemory.h"
+#include "Test.h"
+
+NVS nv;
+
+int main() {
+  // the CRC-16 (CCITT) check value
+  nv.init(4096, false, 0, false);
+  char digits[] = "123456789";
+  nv.writeBytes(100, digits, 9);
+  CHECK(nv.checksum(100, 9) == 0x29B1);
+
+  // a bulk load reads the whole image in 32 byte bursts, keeping any bytes written before it
+  SimI2cMemory memory(4096, 0, 0);
+  for (int i = 0; i < 4096; i++) memory.memory[i] = (uint8_t)random(256);
+  Wire.attach(0x50, &memory);
+  NonVolatileStorageMB85RC fram;
+  CHECK(fram.init(4096, true, 0, false, &Wire, 0x50));
+  fram.write(7, (uint8_t)(memory.memory[7] ^ 0xff));
+  fram.write(4095, (uint8_t)(memory.memory[4095] ^ 0xff));
+  uint8_t written7 = memory.memory[7] ^ 0xff, written4095 = memory.memory[4095] ^ 0xff;
+  memory.reads = 0;
+  CHECK(fram.load());
+  CHECK(memory.reads == 4096/32);
+  int errors = 0;
+  for (int i = 0; i < 4096; i++) {
+    uint8_t expected = i == 7 ? written7 : (i == 4095 ? written4095 : memory.memory[i]);
+    if (fram.read(i) != expected) errors++;
+  }
+  CHECK(errors == 0);
+  CHECK(memory.reads == 4096/32);
+  Wire.attach(0x50, NULL);
+
+  // the header is only kept once NV holds its key
+  nv.writeKey(0x12345678);
+  CHECK(nv.isKeyValid(0x12345678));
+
+  NvCheck first;
+  first.init();
+  CHECK(!first.found);
+  first.poll();
+
+  // on the next start the header matches
+  NvCheck second;
+  second.init();
+  CHECK(second.found);
+  CHECK(second.failed == 0);
+
+  // a change behind its back is found in the settings region, then in the PEC/library region too
+  nv.write(NV_LAST - 1, (uint8_t)(nv.read(NV_LAST - 1) ^ 1));
+  NvCheck third;
+  third.init();
+  CHECK(third.found);
+  CHECK(third.failed == 1);
+
+  nv.write(NV_LAST + 100, (uint8_t)(nv.read(NV_LAST + 100) ^ 1));
+  NvCheck fourth;
+  fourth.init();
+  CHECK(fourth.failed == 3);
+
+  // and once brought up to date again it matches
+  fourth.poll();
+  NvCheck fifth;
+  fifth.init();
+  CHECK(fifth.found);
+  CHECK(fifth.failed == 0);
+
+  return testResult();
+}
@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------------------
+// NV cache flush throughput and startup load time, the 24XX EEPROM and 85RC FRAM drivers against memories on the
+// simulated I2C bus
+
+#include "src/Common.h"
+#undef NVS
+#include "src/lib/nv/NV_24XX.h"
+#undef NVS
+#include "src/lib/nv/NV_MB85RC.h"
+#include "I2cMemory.h"
+#include "Test.h"
+
+#define NV_SIZE 4096
+
+// data as written, to check what reaches the memory
+static uint8_t image[NV_SIZE];
+
+// write count bytes, spread evenly over NV when scattered, then poll as systemServices() does (every 10 ms)
+// until committed and report how long that took
+static void flush(const char *name, NonVolatileStorage *nv, SimI2cMemory *memory, const char *workload, uint16_t count, bool scattered) {
+  for (uint16_t n = 0; n < count; n++) {
+    uint16_t i = scattered ? (uint16_t)(((uint32_t)n*NV_SIZE)/count) : n;
+    image[i] = (uint8_t)random(256);
+    nv->write(i, image[i]);
+  }
+  memory->writes = memory->bytesWritten = 0;
+
+  unsigned long startMs = millis();
+  unsigned long pollMaxUs = 0;
+  while (!nv->committed()) {
+    unsigned long startUs = micros();
+    nv->poll(false);
+    if (micros() - startUs > pollMaxUs) pollMaxUs = micros() - startUs;
+    delay(10);
+  }
+  unsigned long ms = millis() - startMs;
+
+  printf("%-7s %-16s %5u %7lu %8lu %9.0f %12lu\n", name, workload, count, memory->writes, ms, count*1000.0/(ms > 0 ? ms : 1), pollMaxUs);
+  CHECK(memcmp(memory->memory, image, NV_SIZE) == 0);
+  CHECK(memory->pageWraps == 0);
+}
+
+// time to bring the whole image into the cache at startup, as each byte is first read or by a bulk load()
+static void load(const char *name, NonVolatileStorage *byBytes, NonVolatileStorage *byLoad, SimI2cMemory *memory, uint8_t address) {
+  CHECK(byBytes->init(NV_SIZE, true, 0, false, &Wire, address));
+  CHECK(byLoad->init(NV_SIZE, true, 0, false, &Wire, address));
+
+  memory->reads = 0;
+  unsigned long startUs = micros();
+  int errors = 0;
+  for (uint16_t i = 0; i < NV_SIZE; i++) if (byBytes->read(i) != memory->memory[i]) errors++;
+  unsigned long bytesUs = micros() - startUs;
+  unsigned long bytesReads = memory->reads;
+
+  memory->reads = 0;
+  startUs = micros();
+  CHECK(byLoad->load());
+  for (uint16_t i = 0; i < NV_SIZE; i++) if (byLoad->read(i) != memory->memory[i]) errors++;
+  unsigned long loadUs = micros() - startUs;
+
+  printf("%-7s %5u %12lu %10.1f %12lu %10.1f\n", name, NV_SIZE, bytesReads, bytesUs/1000.0, memory->reads, loadUs/1000.0);
+  CHECK(errors == 0);
+}
+
+static void device(const char *name, NonVolatileStorage *nv, SimI2cMemory *memory, uint8_t address) {
+  Wire.attach(address, memory);
+  CHECK(nv->init(NV_SIZE, true, 0, false, &Wire, address));
+  CHECK(nv->load());
+  memcpy(image, memory->memory, NV_SIZE);
+
+  flush(name, nv, memory, "9 byte record", 9, false);
+  flush(name, nv, memory, "82 scattered", 82, true);
+  flush(name, nv, memory, "full 4096", NV_SIZE, false);
+}
+
+int main() {
+  Wire.setClock(400000);
+  printf("device  workload         bytes  bursts  time ms   bytes/s  poll max us\n");
+
+  // AT24C32, 32 byte pages (the driver writes 8 byte pages) and a 10 ms write cycle
+  SimI2cMemory eepromMemory(NV_SIZE, 32, 10000);
+  NonVolatileStorage24XX eeprom;
+  device("EEPROM", &eeprom, &eepromMemory, 0x57);
+
+  // MB85RC64, no pages or write cycle
+  SimI2cMemory framMemory(NV_SIZE, 0, 0);
+  NonVolatileStorageMB85RC fram;
+  device("FRAM", &fram, &framMemory, 0x50);
+
+  printf("\ndevice  bytes  byte reads    time ms  bulk reads    time ms\n");
+  NonVolatileStorage24XX eepromBytes, eepromLoad;
+  Wire.attach(0x57, &eepromMemory);
+  load("EEPROM", &eepromBytes, &eepromLoad, &eepromMemory, 0x57);
+  NonVolatileStorageMB85RC framBytes, framLoad;
+  load("FRAM", &framBytes, &framLoad, &framMemory, 0x50);
+
+  return testResult();
+}
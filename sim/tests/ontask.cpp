@@ -0,0 +1,62 @@
+// -----------------------------------------------------------------------------------
+// OnTask scheduling of software timed tasks, as seen through the priority levels skipped by yield()
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+
+#include "Test.h"
+
+static int runs[3];
+static void task0() { runs[0]++; }
+static void task1() { runs[1]++; }
+static void task2() { runs[2]++; }
+
+// yield until the given time (in ms) has passed
+static void yieldFor(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms) tasks.yield();
+}
+
+int main() {
+  // tasks at three priority levels run on their periods, the cached wake times don't hold any of them back
+  tasks.add(10, 0, true, 0, task0, "T0");
+  tasks.add(25, 0, true, 3, task1, "T1");
+  uint8_t h2 = tasks.add(100, 0, true, 7, task2, "T2");
+  yieldFor(1000);
+  CHECK_NEAR(runs[0], 100, 1);
+  CHECK_NEAR(runs[1], 40, 1);
+  CHECK_NEAR(runs[2], 10, 1);
+
+  // a period changed from outside the task takes effect on its next run
+  tasks.setPeriod(h2, 10);
+  runs[2] = 0;
+  yieldFor(1000);
+  CHECK_NEAR(runs[2], 100, 11);
+
+  // a task made immediate runs right away even though its level was skipped until later
+  tasks.setPeriod(h2, 1000);
+  yieldFor(1100);
+  runs[2] = 0;
+  tasks.immediate(h2);
+  yieldFor(1);
+  CHECK(runs[2] == 1);
+
+  // after its first run a task whose duration has passed, but isn't due, asks to be checked again right away so
+  // yield() removes it (on the hardware a millis() tick between isDurationComplete() and poll() can do this)
+  Task expired(500, 10, true, 7, task0);
+  runs[0] = 0;
+  while (runs[0] == 0) { expired.poll(); yield(); }
+  delay(15);
+  expired.poll();
+  CHECK(expired.getWaitMicros() == 0);
+
+  // and one whose duration hasn't passed is checked again when it does
+  Task limited(500, 100, true, 7, task0);
+  runs[0] = 0;
+  while (runs[0] == 0) { limited.poll(); yield(); }
+  delay(15);
+  limited.poll();
+  CHECK_NEAR(limited.getWaitMicros(), 85000, 1000);
+
+  return testResult();
+}
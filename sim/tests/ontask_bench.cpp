@@ -0,0 +1,40 @@
+// -----------------------------------------------------------------------------------
+// OnTask yield() overhead versus the number of software timed tasks
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+
+#include "Test.h"
+
+static unsigned long runs = 0;
+static void work() { runs++; }
+
+// host time per yield() over the given virtual time, each yield() moves the clock on by SIM_YIELD_MICROS
+static double nanosPerYield(unsigned long ms) {
+  unsigned long count = 0;
+  unsigned long start = millis();
+  double t0 = hostNanos();
+  while (millis() - start < ms) { tasks.yield(); count++; }
+  return (hostNanos() - t0)/count;
+}
+
+int main() {
+  static const int counts[] = { 0, 5, 10, 20, 30, 40 };
+  int added = 0;
+
+  // periods from 5ms to 1s spread over the eight priority levels, like the firmware's mix of tasks
+  printf("tasks   ns/yield   runs/s\n");
+  for (unsigned int c = 0; c < sizeof(counts)/sizeof(counts[0]); c++) {
+    while (added < counts[c]) {
+      static const unsigned long periods[] = { 5, 10, 20, 50, 100, 250, 500, 1000 };
+      if (!tasks.add(periods[added % 8], 0, true, added % 8, work)) break;
+      added++;
+    }
+    nanosPerYield(100);
+    runs = 0;
+    double ns = nanosPerYield(2000);
+    printf("%5d %10.1f %8lu\n", added, ns, runs/2);
+  }
+
+  return 0;
+}
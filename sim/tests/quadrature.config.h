@@ -0,0 +1,6 @@
+
+// -----------------------------------------------------------------------------------
+// A/B quadrature encoder on virtual pins, axis9 as nothing else uses it here
+#define AXIS9_ENCODER AB
+#define AXIS9_ENCODER_A_PIN 50
+#define AXIS9_ENCODER_B_PIN 51
@@ -0,0 +1,171 @@
+// -----------------------------------------------------------------------------------
+// A/B quadrature decoder, the edge table against the switch it replaced run side by side on the same pins, for
+// random edges with missed and spurious interrupts and for edge trains at increasing frequency with a fixed
+// interrupt latency
+
+#include "src/Common.h"
+#include "src/lib/encoder/quadrature/Quadrature.h"
+#include "Test.h"
+
+#include <vector>
+#include <queue>
+
+#define PIN_A AXIS9_ENCODER_A_PIN
+#define PIN_B AXIS9_ENCODER_B_PIN
+
+// the decoder as it was before the edge table, with dir kept per instance (it was a static in each of A() and B()
+// then, shared by every axis, with one encoder on one axis that's the same as the two kept here)
+class BaselineQuadrature {
+  public:
+    void init() {
+      stateA = digitalRead(PIN_A); lastA = stateA;
+      stateB = digitalRead(PIN_B); lastB = stateB;
+    }
+
+    void A(const int16_t pin) {
+      stateA = digitalRead(pin);
+      uint8_t v = stateA*8 + stateB*4 + lastA*2 + lastB;
+      seen |= 1 << v;
+      decode(v, dirA);
+    }
+
+    void B(const int16_t pin) {
+      stateB = digitalRead(pin);
+      uint8_t v = stateA*8 + stateB*4 + lastA*2 + lastB;
+      seen |= 1 << v;
+      decode(v, dirB);
+    }
+
+    int32_t count = 0;
+    bool warn = false;
+    bool error = false;
+    uint16_t seen = 0; // bit set for each of the 16 transitions decoded
+
+  private:
+    void decode(uint8_t v, int16_t &dir) {
+      switch (v) {
+        case 0b0000: dir = 0; error = true; break;
+        case 0b0001: dir = -1; break;
+        case 0b0010: dir = 1; break;
+        case 0b0011: warn = true; break;
+        case 0b0100: dir = 1; break;
+        case 0b0101: dir = 0; error = true; break;
+        case 0b0110: warn = true; break;
+        case 0b0111: dir = -1; break;
+        case 0b1000: dir = -1; break;
+        case 0b1001: warn = true; break;
+        case 0b1010: dir = 0; error = true; break;
+        case 0b1011: dir = 1; break;
+        case 0b1100: warn = true; break;
+        case 0b1101: dir = 1; break;
+        case 0b1110: dir = -1; break;
+        case 0b1111: dir = 0; error = true; break;
+      }
+      count += dir;
+      lastA = stateA;
+      lastB = stateB;
+    }
+
+    int16_t stateA, stateB, lastA, lastB;
+    int16_t dirA = 0, dirB = 0;
+};
+
+static Quadrature encoder(PIN_A, PIN_B, 9);
+static BaselineQuadrature baseline;
+
+static void interruptA() { encoder.A(PIN_A); baseline.A(PIN_A); }
+static void interruptB() { encoder.B(PIN_B); baseline.B(PIN_B); }
+
+// set the pins and let both decoders see them, then clear the counts and flags
+static void start(int a, int b) {
+  digitalWrite(PIN_A, a);
+  interruptA();
+  digitalWrite(PIN_B, b);
+  interruptB();
+  encoder.write(0);
+  encoder.warn = encoder.error = false;
+  baseline.count = 0;
+  baseline.warn = baseline.error = false;
+}
+
+static bool same() {
+  return encoder.read() == baseline.count && encoder.warn == baseline.warn && encoder.error == baseline.error;
+}
+
+// A leads B going forward: ...00 01 11 10 00...
+static const uint8_t phase[4] = { 0b00, 0b01, 0b11, 0b10 };
+
+typedef struct Event {
+  long ns;
+  int type; // 0 = pin edge, 1 = A interrupt, 2 = B interrupt
+  bool operator>(const Event &e) const { return ns != e.ns ? ns > e.ns : type > e.type; }
+} Event;
+
+// edges count of edges, periodNs apart (negative reverses the direction), each interrupt runs latencyNs after its
+// edge and reads the pin then, an edge on a pin with its interrupt still pending doesn't raise another
+static void edgeTrain(long edges, long periodNs, long latencyNs) {
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+  for (long i = 1; i <= edges; i++) events.push({ i*labs(periodNs), 0 });
+
+  bool pendingA = false, pendingB = false;
+  int p = 0;
+  while (!events.empty()) {
+    Event e = events.top();
+    events.pop();
+    if (e.type == 0) {
+      int last = phase[p];
+      p = (p + (periodNs > 0 ? 1 : 3)) % 4;
+      digitalWrite(PIN_A, phase[p] >> 1);
+      digitalWrite(PIN_B, phase[p] & 1);
+      if (((last ^ phase[p]) & 0b10) && !pendingA) { pendingA = true; events.push({ e.ns + latencyNs, 1 }); }
+      if (((last ^ phase[p]) & 0b01) && !pendingB) { pendingB = true; events.push({ e.ns + latencyNs, 2 }); }
+    } else
+    if (e.type == 1) { pendingA = false; interruptA(); } else { pendingB = false; interruptB(); }
+  }
+}
+
+int main() {
+  encoder.init();
+  baseline.init();
+
+  // random pin changes, with interrupts that are sometimes missed and sometimes raised with no change
+  srand(1);
+  bool allSame = true;
+  for (int run = 0; run < 200; run++) {
+    start(rand() & 1, rand() & 1);
+    for (int i = 0; i < 200; i++) {
+      int r = rand() % 100;
+      if (r < 40) { digitalWrite(PIN_A, !digitalRead(PIN_A)); if (r >= 4) interruptA(); } else
+      if (r < 80) { digitalWrite(PIN_B, !digitalRead(PIN_B)); if (r >= 44) interruptB(); } else
+      if (r < 90) interruptA(); else interruptB();
+      if (!same()) allSame = false;
+    }
+  }
+  CHECK(allSame);
+  // an interrupt only sees its own pin change, so the four transitions where both pins differ never come up
+  CHECK(baseline.seen == (0xFFFF & ~(1 << 0b0011 | 1 << 0b0110 | 1 << 0b1001 | 1 << 0b1100)));
+
+  // clean forward and reverse trains count every edge
+  start(0, 0);
+  edgeTrain(4000, 10000, 2000);
+  CHECK(encoder.read() == 4000 && same() && !encoder.warn && !encoder.error);
+  start(0, 0);
+  edgeTrain(4000, -10000, 2000);
+  CHECK(encoder.read() == -4000 && same() && !encoder.warn && !encoder.error);
+
+  // with a 2 us interrupt latency, edges up to 500 kHz are all counted and past that both decoders go wrong the same way
+  printf("%-10s %10s %10s %10s %6s\n", "edges/s", "expected", "table", "switch", "error");
+  for (long rate = 10000; rate <= 1280000; rate *= 2) {
+    long periodNs = 1000000000L/rate;
+    for (int reverse = 0; reverse < 2; reverse++) {
+      start(0, 0);
+      long edges = 4000;
+      edgeTrain(edges, reverse ? -periodNs : periodNs, 2000);
+      CHECK(same());
+      if (rate < 500000) CHECK(encoder.read() == (reverse ? -edges : edges) && !encoder.error);
+      if (!reverse) printf("%-10ld %10ld %10ld %10ld %6s\n", rate, edges, (long)encoder.read(), (long)baseline.count, encoder.error ? "yes" : "no");
+    }
+  }
+
+  return testResult();
+}
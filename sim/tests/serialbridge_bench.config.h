@@ -0,0 +1,5 @@
+
+// -----------------------------------------------------------------------------------
+// serial bridge encoders on Serial2, with ASCII requests and replies
+#define SERIAL_ENCODER Serial2
+#define AXIS1_ENCODER SERIAL_BRIDGE
@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------------
+// serial bridge encoders against a simulated bridge on the other end of the port, samples per second per axis for
+// more and more axes on the virtual clock, the requests and replies take their time on the line at the baud rate
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+#include "src/lib/encoder/serialBridge/SerialBridge.h"
+#include "Test.h"
+
+#include <deque>
+
+// bridge time to turn a request into a reply, in microseconds
+#define BRIDGE_RESPONSE_US 20
+
+// the line time for one byte, start and stop bits included
+static const double byteUs = 10.0*1000000.0/SERIAL_ENCODER_BAUD;
+
+typedef struct Byte {
+  double readyUs;
+  uint8_t c;
+} Byte;
+
+static std::deque<Byte> toBridge;   // requests on their way to the bridge
+static std::deque<Byte> fromBridge; // replies on their way back
+static double toBridgeFreeUs = 0.0;
+static double fromBridgeFreeUs = 0.0;
+
+static int dropPercent = 0;
+static uint32_t replies[9];
+
+static void bridgeRequest(uint8_t c) {
+  double startUs = fmax((double)micros(), toBridgeFreeUs);
+  toBridgeFreeUs = startUs + byteUs;
+  toBridge.push_back({ toBridgeFreeUs, c });
+}
+
+// the count for a channel carries the channel, so a count read back on the wrong axis shows up
+static int32_t bridgeCount(uint8_t channel) {
+  return channel*1000000L + (replies[channel - 1]++ % 1000000L);
+}
+
+static void bridgeReply(double atUs, uint8_t channel) {
+  uint8_t reply[16];
+  int length = 0;
+  int32_t count = bridgeCount(channel);
+  #if SERIAL_ENCODER_BINARY == ON
+    reply[0] = SERIAL_BRIDGE_FRAME_SYNC;
+    reply[1] = channel;
+    for (int i = 0; i < 4; i++) reply[2 + i] = (count >> (i*8)) & 0xFF;
+    reply[6] = 0;
+    for (int i = 0; i < 6; i++) reply[6] += reply[i];
+    length = SERIAL_BRIDGE_FRAME_SIZE;
+  #else
+    length = sprintf((char *)reply, "%ld\r", (long)count);
+  #endif
+
+  double startUs = fmax(atUs, fromBridgeFreeUs);
+  for (int i = 0; i < length; i++) fromBridge.push_back({ startUs + (i + 1)*byteUs, reply[i] });
+  fromBridgeFreeUs = startUs + length*byteUs;
+}
+
+// move the bytes due by now to the other end of the line, the bridge answers each request it gets
+static void bridgePoll() {
+  double nowUs = micros();
+  while (!toBridge.empty() && toBridge.front().readyUs <= nowUs) {
+    uint8_t c = toBridge.front().c;
+    double atUs = toBridge.front().readyUs + BRIDGE_RESPONSE_US;
+    toBridge.pop_front();
+    #if SERIAL_ENCODER_BINARY == ON
+      uint8_t channel = c & 0x7F;
+    #else
+      uint8_t channel = c - '0';
+    #endif
+    if (channel < 1 || channel > 9) continue;
+    if (dropPercent > 0 && random(100) < dropPercent) continue;
+    bridgeReply(atUs, channel);
+  }
+  while (!fromBridge.empty() && fromBridge.front().readyUs <= nowUs) {
+    Serial2.simInput += (char)fromBridge.front().c;
+    fromBridge.pop_front();
+  }
+}
+
+static void runFor(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms) { tasks.yield(); bridgePoll(); }
+}
+
+static SerialBridge *encoder[9];
+
+// true if every axis up to axes reads back a count from its own channel
+static bool countsOnTheirAxes(int axes) {
+  for (int i = 0; i < axes; i++) if (encoder[i]->read()/1000000L != i + 1) return false;
+  return true;
+}
+
+int main() {
+  Serial2.simWrite = bridgeRequest;
+  for (int i = 0; i < 9; i++) encoder[i] = new SerialBridge(i + 1);
+
+  #if SERIAL_ENCODER_BINARY == ON
+    printf("binary requests at %d baud\n", SERIAL_ENCODER_BAUD);
+  #else
+    printf("ASCII requests at %d baud\n", SERIAL_ENCODER_BAUD);
+  #endif
+  printf("%-6s %8s %16s %10s\n", "axes", "drop %", "samples/s/axis", "timeouts");
+
+  int axes = 0;
+  static const int axesRun[] = { 1, 2, 5, 9 };
+  for (int run = 0; run < 5; run++) {
+    if (run < 4) while (axes < axesRun[run]) encoder[axes++]->init(); else dropPercent = 1;
+
+    runFor(100);
+    uint32_t samples = serialBridgePort.samples;
+    uint32_t timeouts = serialBridgePort.timeouts;
+    runFor(1000);
+    samples = serialBridgePort.samples - samples;
+    timeouts = serialBridgePort.timeouts - timeouts;
+    printf("%-6d %8d %16.1f %10lu\n", axes, dropPercent, samples/(double)axes, (unsigned long)timeouts);
+
+    CHECK(countsOnTheirAxes(axes));
+    bool ready = true;
+    for (int i = 0; i < axes; i++) if (!encoder[i]->ready) ready = false;
+    CHECK(ready);
+    if (dropPercent == 0) CHECK(timeouts == 0); else CHECK(timeouts > 0);
+
+    // a sample per axis on each 1 ms poll of the bridge while the replies fit on the line, and still most
+    // of the line's worth with every axis busy and replies dropped
+    if (axes <= 5 && dropPercent == 0) CHECK(samples/axes >= 990);
+    CHECK(samples/axes >= 400);
+  }
+
+  // after the dropped replies every axis is still sampled and reads its own count
+  dropPercent = 0;
+  runFor(100);
+  uint32_t samples = serialBridgePort.samples;
+  runFor(100);
+  CHECK(serialBridgePort.samples - samples >= 9*50);
+  CHECK(countsOnTheirAxes(9));
+
+  return testResult();
+}
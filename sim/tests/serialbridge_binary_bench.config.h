@@ -0,0 +1,6 @@
+
+// -----------------------------------------------------------------------------------
+// serial bridge encoders on Serial2, with binary requests and framed replies
+#define SERIAL_ENCODER Serial2
+#define SERIAL_ENCODER_BINARY ON
+#define AXIS1_ENCODER SERIAL_BRIDGE
@@ -0,0 +1,4 @@
+// -----------------------------------------------------------------------------------
+// serial bridge loopback as serialbridge_bench, built with SERIAL_ENCODER_BINARY ON
+
+#include "serialbridge_bench.cpp"
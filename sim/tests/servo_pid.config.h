@@ -0,0 +1,3 @@
+// -----------------------------------------------------------------------------------
+// servo fixed point PID on its own, no servo axis is configured so it's enabled here
+#define SERVO_MOTOR_PRESENT
@@ -0,0 +1,148 @@
+// -----------------------------------------------------------------------------------
+// servo fixed point PID against a floating point PID worked out as QuickPID's Compute() does it for the modes Pid
+// sets up by default (pOnError, dOnMeas, iAwCondition), the library isn't built here so its arithmetic is copied below,
+// both on the same error trace and each closing the loop on its own copy of a simple DC motor
+
+#include "src/Common.h"
+#include "src/lib/axis/motor/servo/feedback/Pid/FixedPid.h"
+#include "Test.h"
+
+#define RATE 2000.0F
+#define RANGE 255
+#define KP 4.0F
+#define KI 20.0F
+#define KD 0.02F
+
+// QuickPID, with the gains per second scaled to the sample time by SetTunings() and run every call
+class QuickPidFloat {
+  public:
+    QuickPidFloat(float p, float i, float d, float rate, bool reverse) {
+      kp = p;
+      ki = i/rate;
+      kd = d*rate;
+      this->reverse = reverse;
+    }
+
+    float compute(float set, float input) {
+      float dInput = input - lastInput;
+      if (reverse) dInput = -dInput;
+      float error = set - input;
+      if (reverse) error = -error;
+      float dError = error - lastError;
+
+      float peTerm = kp*error;
+      float iTerm = ki*error;
+      float dTerm = -kd*dInput;
+
+      bool aw = false;
+      float iTermOut = peTerm + ki*(iTerm + error);
+      if (iTermOut > RANGE && dError > 0) aw = true; else
+      if (iTermOut < -RANGE && dError < 0) aw = true;
+      if (aw && ki) iTerm = constrain(iTermOut, -RANGE, RANGE);
+
+      outputSum = constrain(outputSum + iTerm, -RANGE, RANGE);
+      lastError = error;
+      lastInput = input;
+      return constrain(outputSum + peTerm + dTerm, -RANGE, RANGE);
+    }
+
+    void start(float input) { lastInput = input; }
+
+  private:
+    float kp, ki, kd;
+    bool reverse;
+    float outputSum = 0.0F, lastInput = 0.0F, lastError = 0.0F;
+};
+
+// a DC motor, speed in counts per cycle lags the power by about 20 cycles
+typedef struct Motor {
+  double position;
+  double speed;
+  long read() { return lround(position); }
+  void drive(int32_t power) { speed += (power*0.02 - speed)*0.05; position += speed; }
+} Motor;
+
+// error in counts at cycle k, a slow swing with a little jitter
+static long traceError(long k) {
+  return lround(30.0*sin(k/200.0)) + ((k*7919) % 5) - 2;
+}
+
+// the same error trace to both, with the target moving at half a count per cycle
+static void openLoop(bool reverse, int *maxDiff, double *meanDiff, int *samples) {
+  FixedPid fixed;
+  fixed.setRange(RANGE);
+  fixed.setGains(KP, KI, KD, RATE, reverse);
+  QuickPidFloat quick(KP, KI, KD, RATE, reverse);
+
+  long lastIn = 0;
+  quick.start(lastIn);
+  *maxDiff = 0;
+  *meanDiff = 0.0;
+  *samples = 0;
+  for (long k = 1; k <= 20000; k++) {
+    long set = k/2;
+    long in = set - traceError(k);
+    int32_t a = fixed.compute(set - in, in - lastIn, 0);
+    float b = quick.compute(set, in);
+    lastIn = in;
+    if (fabs(b) >= RANGE) continue;
+    int diff = abs(a - (int32_t)lroundf(b));
+    if (diff > *maxDiff) *maxDiff = diff;
+    *meanDiff += fabs(a - b);
+    (*samples)++;
+  }
+  *meanDiff /= *samples;
+}
+
+int main() {
+  int maxDiff, samples;
+  double meanDiff;
+
+  // off the rails the fixed point output is the floating point output rounded, either way round
+  openLoop(false, &maxDiff, &meanDiff, &samples);
+  printf("open loop: %d samples in range, mean |fixed - float| %.3f, max %d\n", samples, meanDiff, maxDiff);
+  CHECK(samples > 15000);
+  CHECK(maxDiff <= 1);
+  CHECK(meanDiff < 0.3);
+  openLoop(true, &maxDiff, &meanDiff, &samples);
+  CHECK(samples > 15000);
+  CHECK(maxDiff <= 1);
+  CHECK(meanDiff < 0.3);
+
+  // each closes the loop on its own motor, a step of 2000 counts (well past the rails) then tracking a ramp
+  FixedPid fixed;
+  fixed.setRange(RANGE);
+  fixed.setGains(KP, KI, KD, RATE, false);
+  QuickPidFloat quick(KP, KI, KD, RATE, false);
+  Motor motorA = { 0.0, 0.0 }, motorB = { 0.0, 0.0 };
+  quick.start(0);
+
+  long lastIn = 0;
+  long maxApart = 0, maxError = 0;
+  bool railed = false;
+  for (long k = 1; k <= 40000; k++) {
+    long set = k < 20000 ? 2000 : 2000 + (k - 20000)/5;
+    long inA = motorA.read(), inB = motorB.read();
+    int32_t a = fixed.compute(set - inA, inA - lastIn, 0);
+    float b = quick.compute(set, inB);
+    lastIn = inA;
+    motorA.drive(a);
+    motorB.drive(lroundf(b));
+
+    if (a == RANGE) railed = true;
+    if (labs(inA - inB) > maxApart) maxApart = labs(inA - inB);
+    if ((k > 10000 && k < 20000) || k > 30000) { if (labs(set - inA) > maxError) maxError = labs(set - inA); }
+  }
+  printf("closed loop: max position apart %ld counts, max settled error %ld counts\n", maxApart, maxError);
+  CHECK(railed);
+  CHECK(maxApart <= 2);
+  CHECK(maxError <= 2);
+
+  // disabled the integral is cleared, so the output starts again from zero error
+  fixed.reset();
+  CHECK(fixed.compute(0, 0, 0) == 0);
+  CHECK(fixed.compute(0, 0, 10*65536) == 10);
+  CHECK(fixed.compute(0, 0, 1000*65536) == RANGE);
+
+  return testResult();
+}
@@ -0,0 +1,63 @@
+// -----------------------------------------------------------------------------------
+// virtual clock and hardware timers of the simulation HAL
+
+#include "src/Common.h"
+#include "src/lib/tasks/OnTask.h"
+
+#include "Test.h"
+
+static uint64_t fired[3][64];
+static int firedCount[3];
+
+static unsigned long logTime[256];
+static int logTimer[256];
+static int logCount;
+
+static void record(int timer) {
+  if (firedCount[timer] < 64) fired[timer][firedCount[timer]++] = micros();
+  if (logCount < 256) { logTime[logCount] = micros(); logTimer[logCount++] = timer; }
+}
+static void timer1() { record(0); }
+static void timer2() { record(1); }
+static void timer3() { record(2); }
+
+int main() {
+  // time only passes when it's advanced
+  unsigned long start = micros();
+  CHECK(micros() == start);
+  delay(5);
+  CHECK(micros() - start == 5000);
+  delayMicroseconds(7);
+  CHECK(micros() - start == 5007);
+  yield();
+  CHECK(micros() - start == 5008);
+
+  // three hardware timer tasks at 100us, 250us and 1ms
+  uint8_t h1 = tasks.add(0, 0, true, 0, timer1, "T1");
+  uint8_t h2 = tasks.add(0, 0, true, 0, timer2, "T2");
+  uint8_t h3 = tasks.add(0, 0, true, 0, timer3, "T3");
+  CHECK(tasks.requestHardwareTimer(h1, 0));
+  CHECK(tasks.requestHardwareTimer(h2, 0));
+  CHECK(tasks.requestHardwareTimer(h3, 0));
+  tasks.setPeriodSubMicros(h1, 100*16);
+  tasks.setPeriodSubMicros(h2, 250*16);
+  tasks.setPeriodSubMicros(h3, 1000*16);
+
+  // the first period is the 1ms startup period, after that each fires exactly on its own period
+  delay(10);
+  CHECK(firedCount[0] > 40 && firedCount[1] > 15 && firedCount[2] > 5);
+  for (int t = 0; t < 3; t++) {
+    unsigned long period = t == 0 ? 100 : (t == 1 ? 250 : 1000);
+    for (int i = 2; i < firedCount[t]; i++) CHECK(fired[t][i] - fired[t][i - 1] == period);
+  }
+
+  // timers that come due together fire lower numbered first
+  int together = 0;
+  for (int i = 1; i < logCount; i++) {
+    if (logTime[i] == logTime[i - 1]) { together++; CHECK(logTimer[i] > logTimer[i - 1]); }
+    CHECK(logTime[i] >= logTime[i - 1]);
+  }
+  CHECK(together > 0);
+
+  return testResult();
+}
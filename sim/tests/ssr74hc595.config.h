@@ -0,0 +1,10 @@
+
+// -----------------------------------------------------------------------------------
+// 74HC595 (two of them) on virtual pins with writes latched together at 50kHz
+#undef GPIO_DEVICE
+#define GPIO_DEVICE SSR74HC595
+#define GPIO_SSR74HC595_LATCH_PIN 40
+#define GPIO_SSR74HC595_CLOCK_PIN 41
+#define GPIO_SSR74HC595_DATA_PIN 42
+#define GPIO_SSR74HC595_COUNT 16
+#define GPIO_SSR74HC595_FRAME_RATE 50000
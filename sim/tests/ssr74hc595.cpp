@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------------
+// 74HC595 frame queue, writes made faster than the frames go out keep their order
+
+#include "src/Common.h"
+#include "src/lib/gpio/Ssr74HC595.h"
+#include "src/lib/tasks/OnTask.h"
+
+#include "Test.h"
+
+#define STEP1 0
+#define DIR1 1
+#define STEP2 2
+#define DIR2 3
+
+// the 74HC595 pair, shifted in on the rising edge of the clock and latched on the rising edge of the latch
+static uint32_t shiftRegister = 0;
+static uint32_t latched[1024];
+static int latchedCount = 0;
+
+static void pinWrite(int pin, int value) {
+  if (!value) return;
+  if (pin == GPIO_SSR74HC595_CLOCK_PIN) shiftRegister = (shiftRegister << 1) | (digitalRead(GPIO_SSR74HC595_DATA_PIN) ? 1 : 0); else
+  if (pin == GPIO_SSR74HC595_LATCH_PIN && latchedCount < 1024) latched[latchedCount++] = shiftRegister & 0xffff;
+}
+
+static inline bool pinState(uint32_t frame, int pin) { return (frame >> pin) & 1; }
+
+// check the latched frames for the pulses on stepPin, each must come with the direction written before it and
+// (past the first frame) with the direction already latched and the step pin inactive in the frame before
+static int checkPulses(int stepPin, int dirPin, const bool *dirs, int pulses) {
+  int count = 0;
+  for (int f = 0; f < latchedCount; f++) {
+    if (!pinState(latched[f], stepPin)) continue;
+    CHECK(count < pulses);
+    if (count >= pulses) break;
+    CHECK(pinState(latched[f], dirPin) == dirs[count]);
+    if (f > 0) {
+      CHECK(!pinState(latched[f - 1], stepPin));
+      CHECK(pinState(latched[f - 1], dirPin) == dirs[count]);
+    }
+    count++;
+  }
+  return count;
+}
+
+int main() {
+  simPinWrite = pinWrite;
+  CHECK(gpio.init());
+  gpio.setPulsePin(STEP1, HIGH);
+  gpio.setPulsePin(STEP2, HIGH);
+
+  // one axis, a direction change before each step, with the clock stopped so nothing goes out on the frame timer
+  // and the queue of GPIO_SSR74HC595_FRAME_QUEUE frames overflows after the first two steps
+  bool dirs[16];
+  for (int i = 0; i < 16; i++) {
+    dirs[i] = i & 1;
+    gpio.digitalWrite(DIR1, dirs[i]);
+    gpio.digitalWrite(STEP1, HIGH);
+  }
+  CHECK(latchedCount > 0);
+
+  // the rest go out on the frame timer
+  delay(2);
+  CHECK(checkPulses(STEP1, DIR1, dirs, 16) == 16);
+  CHECK(!pinState(latched[latchedCount - 1], STEP1));
+
+  // two axes with their writes interleaved, and a step written twice while the pin is still active
+  latchedCount = 0;
+  bool dirs1[16], dirs2[16];
+  for (int i = 0; i < 16; i++) {
+    dirs1[i] = (i/2) & 1;
+    dirs2[i] = (i/3) & 1;
+    gpio.digitalWrite(DIR1, dirs1[i]);
+    gpio.digitalWrite(DIR2, dirs2[i]);
+    gpio.digitalWrite(STEP2, HIGH);
+    gpio.digitalWrite(STEP1, HIGH);
+  }
+  delay(2);
+  CHECK(checkPulses(STEP1, DIR1, dirs1, 16) == 16);
+  CHECK(checkPulses(STEP2, DIR2, dirs2, 16) == 16);
+
+  // once the frames are out a write is latched on the next frame, not before
+  latchedCount = 0;
+  gpio.digitalWrite(DIR1, LOW);
+  gpio.digitalWrite(STEP1, HIGH);
+  CHECK(latchedCount == 0);
+  delay(1);
+  CHECK(latchedCount == 3);
+  CHECK(!pinState(latched[0], DIR1) && !pinState(latched[0], STEP1));
+  CHECK(!pinState(latched[1], DIR1) && pinState(latched[1], STEP1));
+  CHECK(!pinState(latched[2], DIR1) && !pinState(latched[2], STEP1));
+
+  return testResult();
+}
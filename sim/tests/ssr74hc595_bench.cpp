@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------
+// 74HC595 shift operations and step latency for one second of a two axis slew, with each write latched
+// immediately (as before frames) and with the writes latched together at GPIO_SSR74HC595_FRAME_RATE
+
+#include "src/Common.h"
+#include "src/lib/gpio/Ssr74HC595.h"
+#include "src/lib/tasks/OnTask.h"
+
+#include "Test.h"
+
+#define STEP1 0
+#define DIR1 1
+#define STEP2 2
+#define DIR2 3
+
+static unsigned long shiftedBits = 0;
+static unsigned long latches = 0;
+static uint32_t shiftRegister = 0;
+
+// time each step was written and the step latency totals
+static unsigned long stepWritten[2];
+static bool stepPending[2];
+static double latencyTotal = 0;
+static unsigned long latencyMax = 0;
+static unsigned long steps = 0;
+
+static void latency(int axis, uint32_t frame, int pin) {
+  if (!stepPending[axis] || !((frame >> pin) & 1)) return;
+  unsigned long t = micros() - stepWritten[axis];
+  latencyTotal += t;
+  if (t > latencyMax) latencyMax = t;
+  stepPending[axis] = false;
+  steps++;
+}
+
+static void pinWrite(int pin, int value) {
+  if (!value) return;
+  if (pin == GPIO_SSR74HC595_CLOCK_PIN) {
+    shiftRegister = (shiftRegister << 1) | (digitalRead(GPIO_SSR74HC595_DATA_PIN) ? 1 : 0);
+    shiftedBits++;
+  } else
+  if (pin == GPIO_SSR74HC595_LATCH_PIN) {
+    latches++;
+    latency(0, shiftRegister, STEP1);
+    latency(1, shiftRegister, STEP2);
+  }
+}
+
+// as StepDirMotor::move() does for a PULSE wave form, the step pin is cleared then set on each step
+static void step(int axis, int pin) {
+  gpio.digitalWrite(pin, LOW);
+  stepWritten[axis] = micros();
+  stepPending[axis] = true;
+  gpio.digitalWrite(pin, HIGH);
+}
+static void axis1() { step(0, STEP1); }
+static void axis2() { step(1, STEP2); }
+
+// counts for one second of virtual time
+static void slew(const char *name) {
+  shiftedBits = latches = steps = 0;
+  latencyTotal = 0;
+  latencyMax = 0;
+  stepPending[0] = stepPending[1] = false;
+
+  delay(1000);
+
+  printf("%-10s %7lu steps/s %8lu bytes shifted/s %7lu frames latched/s %5.2f frames/step, step latency %4.1fus mean %2luus max\n",
+    name, steps, shiftedBits/8, latches, (double)latches/steps, latencyTotal/steps, latencyMax);
+}
+
+int main() {
+  simPinWrite = pinWrite;
+  gpio.init();
+  gpio.digitalWrite(DIR1, HIGH);
+  gpio.digitalWrite(DIR2, LOW);
+
+  // about 10kHz and 7.7kHz, away from multiples of the frame period
+  uint8_t h1 = tasks.add(0, 0, true, 0, axis1, "Axis1");
+  uint8_t h2 = tasks.add(0, 0, true, 0, axis2, "Axis2");
+  tasks.requestHardwareTimer(h1, 0);
+  tasks.requestHardwareTimer(h2, 0);
+  tasks.setPeriodSubMicros(h1, 1605);
+  tasks.setPeriodSubMicros(h2, 2087);
+
+  gpio.setFrameMode(false);
+  delay(10);
+  slew("immediate");
+
+  gpio.setPulsePin(STEP1, HIGH);
+  gpio.setPulsePin(STEP2, HIGH);
+  gpio.setFrameMode(true);
+  delay(10);
+  slew("frames");
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------
+// binary telemetry framing, frames and LX200 replies interleaved on Serial and split apart again as a client would
+
+#include "Sketch.h"
+#include "src/libApp/telemetry/Telemetry.h"
+#include "Test.h"
+
+#include <vector>
+
+typedef std::vector<uint8_t> Bytes;
+
+// undo the COBS encoding of a frame taken from between its 0x00 delimiters
+static Bytes decode(const Bytes &frame) {
+  Bytes data;
+  size_t i = 0;
+  while (i < frame.size()) {
+    uint8_t code = frame[i++];
+    for (uint8_t j = 1; j < code && i < frame.size(); j++) data.push_back(frame[i++]);
+    if (i < frame.size()) data.push_back(0);
+  }
+  return data;
+}
+
+static uint16_t crc16(const uint8_t *data, size_t count) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < count; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+int main() {
+  setup();
+  sketchRun(2.0);
+
+  // every block every 100 ms, with a status query in the middle of the stream
+  std::string out;
+  simSerialCapture = &out;
+  simSerialInput(":YT1F,100#");
+  sketchRun(0.45);
+  simSerialInput(":Gu#");
+  sketchRun(0.55);
+  simSerialInput(":YT0,0#");
+  sketchRun(0.2);
+  simSerialCapture = NULL;
+
+  // split on 0x00, what's inside a pair of delimiters is a frame and the rest is replies
+  std::string text;
+  std::vector<Bytes> frames;
+  bool inFrame = false;
+  for (size_t i = 0; i < out.length(); i++) {
+    uint8_t c = out[i];
+    if (c == 0) { if (!inFrame) frames.push_back(Bytes()); inFrame = !inFrame; continue; }
+    if (inFrame) frames.back().push_back(c); else text += (char)c;
+  }
+  CHECK(!inFrame);
+
+  // "1" for each :YT and the 9 status bytes of :Gu#, every one with bit 7 set
+  CHECK(text.length() == 12);
+  CHECK(text.substr(0, 1) == "1");
+  CHECK(text.substr(10, 2) == "#1");
+  bool statusHigh = true;
+  for (int i = 1; i < 10 && i < (int)text.length(); i++) if (!((uint8_t)text[i] & 0x80)) statusHigh = false;
+  CHECK(statusHigh);
+
+  CHECK(frames.size() >= 9 && frames.size() <= 11);
+  int zeros = 0;
+  for (size_t f = 0; f < frames.size(); f++) {
+    CHECK(frames[f].size() + 2 <= TELEMETRY_FRAME_MAX);
+    Bytes data = decode(frames[f]);
+    CHECK(data.size() == 3 + 16 + 12 + 9 + 3 + 24 + 2);
+    if (data.size() < 5) continue;
+
+    CHECK(data[0] == TELEMETRY_ALL);
+    CHECK(data[1] == (uint8_t)f);
+    CHECK(data[2] == data.size() - 5);
+    uint16_t crc = crc16(data.data(), data.size() - 2);
+    CHECK(data[data.size() - 2] == (crc & 0xFF) && data[data.size() - 1] == (crc >> 8));
+    for (size_t i = 0; i < data.size(); i++) if (data[i] == 0) zeros++;
+
+    // the status block matches the :Gu# reply
+    if (data.size() >= 3 + 16 + 12 + 9) CHECK(memcmp(&data[3 + 16 + 12], text.data() + 1, 9) == 0);
+  }
+  // the encoding had zeros to take out, the sequence starts at 0 and focuser positions are 0 at boot
+  CHECK(zeros > 0);
+
+  return testResult();
+}
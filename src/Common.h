@@ -20,6 +20,26 @@
 #else
   #define NV_PEC_BUFFER_BASE      (NV_LAST+1) // bytes: ?   , ? + (PEC_BUFFER_SIZE_LIMIT - 1)
 #endif
+#if ALIGN_MODEL_STREAM == ON
+  #define NV_ALIGN_SUMS_SIZE      368         // bytes: 368 , 368 at the end of NV, below the library
+#else
+  #define NV_ALIGN_SUMS_SIZE      0
+#endif
+#if NV_LOG != OFF
+  #define NV_LOG_SIZE             NV_LOG      // bytes: n   , n   below the align sums
+#else
+  #define NV_LOG_SIZE             0
+#endif
+#if NV_CHECKSUM == ON
+  #define NV_CHECKSUM_SIZE        6           // bytes: 6   , 6   below the log
+#else
+  #define NV_CHECKSUM_SIZE        0
+#endif
+#if PEC_STEPS_PER_WORM_ROTATION != 0
+  #define NV_END_DATA_BASE_MIN    (NV_PEC_BUFFER_BASE + PEC_BUFFER_SIZE_LIMIT) // the checksum, log, and align sums stay above this
+#else
+  #define NV_END_DATA_BASE_MIN    (NV_PEC_BUFFER_BASE + 0)
+#endif
 
 #include "HAL/HAL.h"
 #include "lib/Macros.h"
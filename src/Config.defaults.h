@@ -6,6 +6,15 @@
 #ifndef NV_DRIVER
 #define NV_DRIVER                     NV_DEFAULT
 #endif
+#ifndef NV_LOG
+#define NV_LOG                        OFF                         // n, size in bytes of a wear leveled log for frequently changing records
+#endif
+#ifndef NV_LOG_PERIOD
+#define NV_LOG_PERIOD                 1000                        // n, in milliseconds, how often changed records are appended to the log
+#endif
+#ifndef NV_CHECKSUM
+#define NV_CHECKSUM                   OFF                         // ON, keep a CRC header for the NV regions and validate it at startup
+#endif
 
 // pinmap
 #ifndef PINMAP
@@ -19,6 +28,9 @@
 #ifndef DEBUG_ECHO_COMMANDS
 #define DEBUG_ECHO_COMMANDS           OFF
 #endif
+#ifndef TASKS_PROFILER_STATS
+#define TASKS_PROFILER_STATS          OFF
+#endif
 #ifndef SERIAL_DEBUG
 #define SERIAL_DEBUG                  Serial
 #endif
@@ -58,6 +70,9 @@
 #ifndef SERIAL_SERVER
 #define SERIAL_SERVER                 BOTH                        // STANDARD (port 9999) or PERSISTENT (ports 9996 to 9998)
 #endif
+#ifndef SERIAL_SERVER_CLIENTS
+#define SERIAL_SERVER_CLIENTS         4                           // clients served at once on each port (WiFi), 1 to 8
+#endif
 
 // translate Config.h IP settings into low level library settings
 #if SERIAL_IP_MODE == ETHERNET_W5500
@@ -168,6 +183,33 @@
 #define SHARED3_ENABLE_STATE          LOW
 #endif
 
+// servo encoder filters, AXISn_SERVO_FLTR selects OFF, MEDIAN, ALPHA_BETA, or KALMAN per axis
+#ifndef SERVO_FLTR_MEDIAN_WIDTH
+#define SERVO_FLTR_MEDIAN_WIDTH       5                           // samples in the rolling median (odd, 3 to 9)
+#endif
+#ifndef SERVO_FLTR_ALPHA
+#define SERVO_FLTR_ALPHA              0.5                         // alpha-beta-gamma position gain
+#endif
+#ifndef SERVO_FLTR_BETA
+#define SERVO_FLTR_BETA               0.1                         // alpha-beta-gamma velocity gain
+#endif
+#ifndef SERVO_FLTR_GAMMA
+#define SERVO_FLTR_GAMMA              0.0                         // alpha-beta-gamma acceleration gain (0 for alpha-beta)
+#endif
+#ifndef SERVO_FLTR_MEAS_VAR
+#define SERVO_FLTR_MEAS_VAR           4.0                         // Kalman encoder noise variance in counts^2 (AXISn_SERVO_FLTR_MEAS_VAR per axis)
+#endif
+#ifndef SERVO_FLTR_PROC_VAR
+#define SERVO_FLTR_PROC_VAR           0.01                        // Kalman process variance in (counts/cycle^2)^2 (AXISn_SERVO_FLTR_PROC_VAR per axis)
+#endif
+
+// servo control loop, OFF runs the control law from the servo task, or 1000 to 10000 (Hz) to run a fixed point PID from
+// a hardware timer at this rate instead (axes 1 and 2 only, with a DC motor driver and an encoder that can be read from a
+// timer interrupt) both axes share the one timer so on the ESP32, with four, the site clock keeps its own
+#ifndef SERVO_CONTROL_RATE
+#define SERVO_CONTROL_RATE            OFF                         // OFF or 1000 to 10000 (Hz)
+#endif
+
 // -----------------------------------------------------------------------------------
 // mount settings
 
@@ -546,6 +588,9 @@
 #ifndef MOUNT_COORDS_MEMORY
 #define MOUNT_COORDS_MEMORY           OFF                         // ON Enables mount position memory
 #endif
+#ifndef MOUNT_COORDS_SNAPSHOT
+#define MOUNT_COORDS_SNAPSHOT         50                          // in ms, max age of the position shared by status commands, OFF to disable
+#endif
 #ifndef MOUNT_ENABLE_IN_STANDBY
 #define MOUNT_ENABLE_IN_STANDBY       OFF                         // ON Enables mount motor drivers in standby
 #endif
@@ -711,6 +756,9 @@
 #ifndef TRACK_BACKLASH_RATE
 #define TRACK_BACKLASH_RATE           25
 #endif
+#ifndef TRACK_COMPENSATION_RATE
+#define TRACK_COMPENSATION_RATE       1                           // compensated tracking rate updates per second, 1 to 100
+#endif
 
 // slewing
 #ifndef GOTO_FEATURE
@@ -728,6 +776,9 @@
 #ifndef SLEW_ACCELERATION_DIST
 #define SLEW_ACCELERATION_DIST        5.0                         // distance in degrees to complete acceleration/deceleration
 #endif
+#ifndef SLEW_ACCELERATION_SCURVE
+#define SLEW_ACCELERATION_SCURVE      OFF                         // ON for jerk-limited (S-curve) acceleration over SLEW_ACCELERATION_DIST
+#endif
 #ifndef SLEW_RAPID_STOP_DIST
 #define SLEW_RAPID_STOP_DIST          2.0                         // distance in degrees for emergency stop
 #endif
@@ -737,6 +788,9 @@
 #ifndef GOTO_OFFSET_ALIGN
 #define GOTO_OFFSET_ALIGN             OFF                         // skip final phase of goto for align stars so user tends to
 #endif                                                            // approach from the correct direction when centering
+#ifndef GOTO_SYNCHRONIZED
+#define GOTO_SYNCHRONIZED             OFF                         // ON slows the axis that would arrive first so both finish together
+#endif
 #ifndef GOTO_SETTLE_TIME
 #define GOTO_SETTLE_TIME             1500                         // settle time in milliseconds for final phase of goto offset
 #endif                                                            // allows for settle and encoder sync if available
@@ -783,6 +837,10 @@
 #define ALIGN_MODEL_MEMORY            OFF                         // restores any pointing model saved in NV at startup
 #endif
 
+#ifndef ALIGN_MODEL_STREAM
+#define ALIGN_MODEL_STREAM            OFF                         // ON keeps running sums so :AP# can add any number of points to the model
+#endif
+
 #define HIGH_SPEED_ALIGN
 
 // -----------------------------------------------------------------------------------
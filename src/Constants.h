@@ -172,3 +172,8 @@
 #define NV_TELESCOPE_SETTINGS_BASE  849    // bytes: 2   , 2
 
 #define NV_LAST                     850
+
+// NV log keys (for records kept in the wear leveled log)
+#define NV_LOG_MOUNT_LAST_POSITION  1      // bytes: 9
+#define NV_LOG_FOCUSER_POSITION     2      // bytes: 4   , focusers 1 to 6 use keys 2 to 7
+#define NV_LOG_ROTATOR_POSITION     8      // bytes: 4
@@ -98,6 +98,11 @@
   #define MCU_STR "RENESAS RA4M1 (Arduino UNO R4 WIFI)"
   #include "HAL_UNO_R4_WIFI.h"  
 
+#elif defined(ARDUINO_ARCH_SIM)
+  // Host (Linux) simulation with a virtual clock
+  #define MCU_STR "Simulation (Host)"
+  #include "HAL_SIM.h"
+
 #else
   // Generic
   #warning "Unknown Platform! If this is a new platform, it would probably do best with a new HAL designed for it."
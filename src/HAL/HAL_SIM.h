@@ -0,0 +1,62 @@
+// Platform setup ------------------------------------------------------------------------------------
+#pragma once
+
+// Host (Linux) simulation, built against stand-ins for the Arduino core that take their time from the
+// virtual clock (simMillis()/simMicros() in lib/tasks/OnTask.h) which the host advances with simAdvance()
+// the hardware timers are virtual and fire in sub-microsecond order as the virtual clock is advanced
+// the stand-ins and the host build are in sim/ (outside the sketch,) "make -C sim run" to build and run it
+
+// This is for fast processors with hardware FP
+#define HAL_FAST_PROCESSOR
+
+// Base rate for critical task timing
+#define HAL_FRACTIONAL_SEC 100.0F
+
+// Analog read and write
+#ifndef ANALOG_READ_RANGE
+  #define ANALOG_READ_RANGE 1023
+#endif
+#ifndef ANALOG_WRITE_RANGE
+  #define ANALOG_WRITE_RANGE 255
+#endif
+#ifndef ANALOG_WRITE_PWM_BITS
+  #define ANALOG_WRITE_PWM_BITS 8
+#endif
+
+// Lower limit (fastest) step rate in uS for this platform (in SQW mode) and width of step pulse
+#ifndef HAL_MAXRATE_LOWER_LIMIT
+  #define HAL_MAXRATE_LOWER_LIMIT 16
+#endif
+#ifndef HAL_PULSE_WIDTH
+  #define HAL_PULSE_WIDTH 200  // in ns
+#endif
+
+// New symbol for the default I2C port -------------------------------------------------------------
+#include <Wire.h>
+#define HAL_Wire Wire
+#define HAL_WIRE_CLOCK 100000
+
+// Non-volatile storage ----------------------------------------------------------------------------
+#if NV_DRIVER == NV_DEFAULT
+  #define E2END 4095
+  #define NV_ENDURANCE NVE_HIGH
+  #include "../lib/nv/NV_SIM.h"
+  #define HAL_NV_INIT() nv.init(E2END + 1, false, 0, false)
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// General purpose initialize for HAL
+#define HAL_INIT() { ; }
+
+//--------------------------------------------------------------------------------------------------
+// Internal MCU temperature (in degrees C)
+#define HAL_TEMP() ( NAN )
+
+// MCU reset
+#define HAL_RESET() { ; }
+
+// a really short fixed delay (none needed)
+#define HAL_DELAY_25NS()
+
+// stand-in for delayNanoseconds(), time doesn't pass on its own in the simulation
+#define delayNanoseconds(ns) { (void)(ns); }
@@ -20,6 +20,33 @@
   #warning "Configuration (Config.h): AXIS5_SLEW_RATE_DESIRED has been replaced with AXIS5_SLEW_RATE_BASE_DESIRED please update"
   #define AXIS5_SLEW_RATE_BASE_DESIRED AXIS5_SLEW_RATE_DESIRED
 #endif
+#if defined(AXIS1_SERVO_FLTR_MEAS_U) || defined(AXIS1_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS1_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS1_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS2_SERVO_FLTR_MEAS_U) || defined(AXIS2_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS2_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS2_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS3_SERVO_FLTR_MEAS_U) || defined(AXIS3_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS3_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS3_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS4_SERVO_FLTR_MEAS_U) || defined(AXIS4_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS4_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS4_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS5_SERVO_FLTR_MEAS_U) || defined(AXIS5_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS5_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS5_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS6_SERVO_FLTR_MEAS_U) || defined(AXIS6_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS6_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS6_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS7_SERVO_FLTR_MEAS_U) || defined(AXIS7_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS7_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS7_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS8_SERVO_FLTR_MEAS_U) || defined(AXIS8_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS8_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS8_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
+#if defined(AXIS9_SERVO_FLTR_MEAS_U) || defined(AXIS9_SERVO_FLTR_VARIANCE)
+  #warning "Configuration (Config.h): AXIS9_SERVO_FLTR_MEAS_U and _VARIANCE have been replaced with AXIS9_SERVO_FLTR_MEAS_VAR and _PROC_VAR (Kalman variances) please update"
+#endif
 
 // GENERAL ---------------------------------------
 #if defined(STEP_DIR_TMC_UART_PRESENT) && (!defined(SERIAL_TMC) || !defined(SERIAL_TMC_BAUD))
@@ -307,8 +334,12 @@
   #error "Configuration (Config.h): Setting MOUNT_COORDS_MEMORY unknown, use ON or OFF"
 #endif
 
-#if MOUNT_COORDS_MEMORY == ON && NV_ENDURANCE < NVE_VHIGH
-  #error "Configuration (Config.h): Setting MOUNT_COORDS_MEMORY requires a NV storage device with very high write endurance (FRAM)"
+#if MOUNT_COORDS_SNAPSHOT != OFF && (MOUNT_COORDS_SNAPSHOT < 0 || MOUNT_COORDS_SNAPSHOT > 1000)
+  #error "Configuration (Config.h): Setting MOUNT_COORDS_SNAPSHOT unknown, use OFF or 0 to 1000 (milliseconds.)"
+#endif
+
+#if MOUNT_COORDS_MEMORY == ON && NV_ENDURANCE < NVE_VHIGH && NV_LOG == OFF
+  #error "Configuration (Config.h): Setting MOUNT_COORDS_MEMORY requires a NV storage device with very high write endurance (FRAM) or NV_LOG"
 #endif
 
 #if MOUNT_ENABLE_IN_STANDBY != ON && MOUNT_ENABLE_IN_STANDBY != OFF
@@ -319,6 +350,14 @@
   #error "Configuration (Config.h): Setting ALIGN_MAX_STARS unknown, use AUTO or a value from 1 to 9."
 #endif
 
+#if ALIGN_MODEL_STREAM != OFF && ALIGN_MODEL_STREAM != ON
+  #error "Configuration (Config.h): Setting ALIGN_MODEL_STREAM unknown, use OFF or ON."
+#endif
+
+#if ALIGN_MODEL_STREAM == ON && ALIGN_MAX_STARS != AUTO && ALIGN_MAX_STARS <= 1
+  #error "Configuration (Config.h): Setting ALIGN_MODEL_STREAM ON requires ALIGN_MAX_STARS AUTO or 3 to 9, the model needs more than one star."
+#endif
+
 // TIME AND LOCATION
 #if TIME_LOCATION_SOURCE < TLS_FIRST && TIME_LOCATION_SOURCE > TLS_LAST
   #error "Configuration (Config.h): Setting TIME_LOCATION_SOURCE unknown, use OFF or valid TIME LOCATION SOURCE (from Constants.h)"
@@ -401,6 +440,34 @@
   #error "Configuration (Config.h): Setting SLEW_RATE_MEMORY unknown, use OFF or ON."
 #endif
 
+#if SLEW_ACCELERATION_SCURVE != ON && SLEW_ACCELERATION_SCURVE != OFF
+  #error "Configuration (Config.h): Setting SLEW_ACCELERATION_SCURVE unknown, use OFF or ON."
+#endif
+
+#if GOTO_SYNCHRONIZED != ON && GOTO_SYNCHRONIZED != OFF
+  #error "Configuration (Config.h): Setting GOTO_SYNCHRONIZED unknown, use OFF or ON."
+#endif
+
+#if NV_LOG != OFF && (NV_LOG < 512 || NV_LOG > 2048 || NV_LOG % 16 != 0)
+  #error "Configuration (Config.h): Setting NV_LOG unknown, use OFF or 512 to 2048 (bytes, a multiple of 16.)"
+#endif
+
+#if NV_LOG_PERIOD < 100 || NV_LOG_PERIOD > 60000
+  #error "Configuration (Config.h): Setting NV_LOG_PERIOD unknown, use 100 to 60000 (milliseconds.)"
+#endif
+
+#if defined(E2END) && NV_DRIVER == NV_DEFAULT && E2END + 1 - NV_ALIGN_SUMS_SIZE - NV_LOG_SIZE - NV_CHECKSUM_SIZE < NV_END_DATA_BASE_MIN
+  #error "Configuration (Config.h): Setting NV_LOG too large, with ALIGN_MODEL_STREAM and NV_CHECKSUM it overlaps the settings or PEC buffer on this NV device."
+#endif
+
+#if SERIAL_SERVER_CLIENTS < 1 || SERIAL_SERVER_CLIENTS > 8
+  #error "Configuration (Config.h): Setting SERIAL_SERVER_CLIENTS unknown, use 1 to 8."
+#endif
+
+#if NV_CHECKSUM != ON && NV_CHECKSUM != OFF
+  #error "Configuration (Config.h): Setting NV_CHECKSUM unknown, use OFF or ON."
+#endif
+
 // TRACKING BEHAVIOUR
 #if TRACK_AUTOSTART != ON && TRACK_AUTOSTART != OFF
   #error "Configuration (Config.h): Setting TRACK_AUTOSTART unknown, use OFF or ON."
@@ -414,6 +481,10 @@
   #error "Configuration (Config.h): Setting TRACK_COMPENSATION_MEMORY unknown, use OFF or ON."
 #endif
 
+#if TRACK_COMPENSATION_RATE < 1 || TRACK_COMPENSATION_RATE > 100
+  #error "Configuration (Config.h): Setting TRACK_COMPENSATION_RATE unknown, use a value between 1 and 100 (updates per second.)"
+#endif
+
 #if TRACK_BACKLASH_RATE < 2 && TRACK_BACKLASH_RATE > 100
   #error "Configuration (Config.h): Setting TRACK_BACKLASH_RATE unknown, use a value between 2 and 100 (x Sidereal.)"
 #endif
@@ -1104,6 +1175,14 @@
   #endif
 #endif
 
+#if SERVO_FLTR_MEDIAN_WIDTH < 3 || SERVO_FLTR_MEDIAN_WIDTH > 9 || SERVO_FLTR_MEDIAN_WIDTH % 2 == 0
+  #error "Configuration (Config.h): Setting SERVO_FLTR_MEDIAN_WIDTH unknown, use an odd value 3 to 9 (samples.)"
+#endif
+
+#if SERVO_CONTROL_RATE != OFF && (SERVO_CONTROL_RATE < 1000 || SERVO_CONTROL_RATE > 10000)
+  #error "Configuration (Config.h): Setting SERVO_CONTROL_RATE unknown, use OFF or a value 1000 to 10000 (Hz.)"
+#endif
+
 // GENERAL TEMPERATURE ---------------------------
 #if defined(DS1820_DEVICES_PRESENT) && defined(THERMISTOR_DEVICES_PRESENT)
   #error "Configuration (Config.h): Setting DS18B20 devices and THERMISTOR devices can not both be used at the same time, use one or the other"
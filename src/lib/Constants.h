@@ -25,6 +25,8 @@
 #define PERSISTENT                  -20
 #define ERRORS_ONLY                 -21
 #define KALMAN                      -22
+#define MEDIAN                      -23
+#define ALPHA_BETA                  -24
 #define INVALID                     -127
 
 // driver (step/dir interface, usually for stepper motors)
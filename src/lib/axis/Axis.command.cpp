@@ -69,6 +69,23 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *supressFra
         sprintf(reply, "%ld,%s", ((ServoMotor*)motor)->delta, temp);
         *numericReply = false;
       } else
+
+      // :GXL[n]#   Get axis servo encoder filter
+      //            Returns: 0 OFF, 1 MEDIAN, 2 ALPHA_BETA, 3 KALMAN
+      if (parameter[0] == 'L') {
+        int index = parameter[1] - '1';
+        if (index > 8) { *commandError = CE_PARAM_RANGE; return true; }
+        if (index + 1 != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+
+        switch (((ServoMotor*)motor)->getFilter()) {
+          case MEDIAN: strcpy(reply, "1"); break;
+          case ALPHA_BETA: strcpy(reply, "2"); break;
+          case KALMAN: strcpy(reply, "3"); break;
+          default: strcpy(reply, "0"); break;
+        }
+        *numericReply = false;
+      } else
     #endif
 
     // :GXU[n]#   Get stepper driver statUs for axis [n]
@@ -92,6 +109,21 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *supressFra
     } else return false;
   } else
 
+  #ifdef SERVO_MOTOR_PRESENT
+    // :SXL[n],[f]#  Set axis servo encoder filter, [f] = 0 OFF, 1 MEDIAN, 2 ALPHA_BETA, 3 KALMAN
+    //               Returns: 0 failure, 1 success
+    if (command[0] == 'S' && command[1] == 'X' && parameter[0] == 'L' && parameter[2] == ',') {
+      int index = parameter[1] - '1';
+      if (index + 1 != axisNumber) return false; // command wasn't processed
+      if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+
+      const int filterType[4] = {OFF, MEDIAN, ALPHA_BETA, KALMAN};
+      if (parameter[3] >= '0' && parameter[3] <= '3' && parameter[4] == 0) {
+        ((ServoMotor*)motor)->setFilter(filterType[parameter[3] - '0']);
+      } else *commandError = CE_PARAM_RANGE;
+    } else
+  #endif
+
   // :SXA[n]#   Set axis/driver configuration
   if (command[0] == 'S' && command[1] == 'X' && parameter[0] == 'A' && parameter[2] == ',') {
     uint16_t axesToRevert = nv.readUI(NV_AXIS_SETTINGS_REVERT);
@@ -277,6 +277,64 @@ double Axis::getOriginOrTargetDistance() {
   return motor->getOriginOrTargetDistanceSteps()/settings.stepsPerMeasure;
 }
 
+// S-curve rate (0 to 1) at 33 evenly spaced points along the ramp distance, the rate follows
+// (1 - cos(PI*t))/2 over the time a linear ramp would take to cover the same distance
+static const float sCurve[33] = {
+  0.0000F, 0.1694F, 0.2629F, 0.3378F, 0.4019F, 0.4583F, 0.5090F, 0.5551F, 0.5972F, 0.6358F, 0.6716F,
+  0.7046F, 0.7352F, 0.7636F, 0.7899F, 0.8143F, 0.8368F, 0.8576F, 0.8768F, 0.8945F, 0.9106F, 0.9252F,
+  0.9385F, 0.9504F, 0.9609F, 0.9702F, 0.9782F, 0.9849F, 0.9903F, 0.9946F, 0.9976F, 0.9994F, 1.0000F
+};
+
+// S-curve rate for a distance from the origin or target, with accel and rate as for the linear ramp
+float Axis::sCurveRateByDistance(float distance, float accel, float rate) {
+  if (accel <= 0.0F || distance <= 0.0F) return 0.0F;
+
+  float s = (distance/((rate*rate)/(2.0F*accel)))*32.0F;
+  if (s >= 32.0F) return rate;
+
+  // the rate rises as distance^(2/3) from rest (constant jerk) so that part isn't interpolated
+  if (s < 1.0F) return rate*sCurve[1]*cbrtf(s*s);
+
+  int i = (int)s;
+  return rate*(sCurve[i] + (sCurve[i + 1] - sCurve[i])*(s - i));
+}
+
+// S-curve rate one FRACTIONAL_SEC step on from frequency toward the target frequency
+float Axis::sCurveRateByTime(float frequency, float target) {
+  if (slewFreq <= 0.0F) return target;
+
+  // phase along the ramp (0 to 1) for the current and target rates, the target is zero
+  // while still moving in the other direction
+  float sign = (frequency < 0.0F || (frequency == 0.0F && target < 0.0F)) ? -1.0F : 1.0F;
+  float phase = acosf(1.0F - 2.0F*fminf(fabs(frequency)/slewFreq, 1.0F))/PI;
+  float phaseTarget = 0.0F;
+  if (target*sign > 0.0F) phaseTarget = acosf(1.0F - 2.0F*fminf(fabs(target)/slewFreq, 1.0F))/PI;
+
+  float step = slewAccelRateFs/slewFreq;
+  if (phase < phaseTarget) { phase += step; if (phase > phaseTarget) phase = phaseTarget; } else
+                           { phase -= step; if (phase < phaseTarget) phase = phaseTarget; }
+
+  return sign*slewFreq*(1.0F - cosf(PI*phase))/2.0F;
+}
+
+// time in seconds for the autoGoto in progress to cover the given distance in "measures"
+float Axis::autoGotoTime(float distance) {
+  float accel = slewAccelRateFs*gotoScale*FRACTIONAL_SEC;
+  float rate = slewFreq*gotoScale;
+  if (accel <= 0.0F || rate <= 0.0F) return 0.0F;
+
+  // the rate follows sqrt(2*accel*distance) from the origin or target (whichever is closer) but never drops
+  // below the backlash rate, so each ramp takes (rate - backlashFreq/2)/accel seconds and if too short to
+  // reach the slew rate the profile is triangular
+  float minRate = fminf(backlashFreq, rate);
+  if (distance < rate*rate/accel) {
+    float peakRate = sqrtf(accel*distance);
+    if (peakRate <= minRate) return distance/minRate;
+    return (2.0F*peakRate - minRate)/accel;
+  }
+  return distance/rate + (rate - minRate)/accel;
+}
+
 // set acceleration rate in "measures" per second per second (for autoSlew)
 void Axis::setSlewAccelerationRate(float mpsps) {
   if (autoRate == AR_NONE) {
@@ -326,6 +384,7 @@ CommandError Axis::autoGoto(float frequency) {
   motor->setSlewing(true);
   autoRate = AR_RATE_BY_DISTANCE;
   rampFreq = 0.0F;
+  gotoScale = 1.0F;
 
   #if DEBUG == VERBOSE
     if (unitsRadians) V(radToDeg(slewFreq)); else V(slewFreq);
@@ -337,6 +396,49 @@ CommandError Axis::autoGoto(float frequency) {
   return CE_NONE;
 }
 
+// estimated time in seconds for the autoGoto in progress to complete
+float Axis::getAutoGotoTime(float targetRate) {
+  if (autoRate != AR_RATE_BY_DISTANCE) return 0.0F;
+
+  // a moving target adds targetRate*time to the distance, the slew rate is many times the
+  // target rate so a few passes settle on the time
+  float distance = getTargetDistance();
+  float time = autoGotoTime(distance);
+  for (int i = 0; i < 3; i++) time = autoGotoTime(distance + targetRate*time);
+  return time;
+}
+
+// stretch the autoGoto in progress to take the given time in seconds, its slew rate and
+// acceleration are scaled down together so it can finish along with another axis
+void Axis::setAutoGotoTime(float seconds, float targetRate) {
+  float time = getAutoGotoTime(targetRate);
+  if (time <= 0.0F || seconds <= time) return;
+
+  float distance = getTargetDistance() + targetRate*seconds;
+  float accel = slewAccelRateFs*gotoScale*FRACTIONAL_SEC;
+  float rate = slewFreq*gotoScale;
+  float minRate = backlashFreq;
+
+  // with both scaled by k (the backlash rate isn't) a trapezoidal profile takes
+  // distance/(k*rate) + rate/accel - minRate/(k*accel) seconds
+  float k = (distance/rate - minRate/accel)/(seconds - rate/accel);
+
+  // and a triangular profile takes 2*sqrt(distance/(k*accel)) - minRate/(k*accel) seconds, a quadratic in
+  // 1/sqrt(k) solved on the rising side, at most it's distance/minRate seconds with the whole move at the backlash rate
+  if (seconds <= rate/accel || distance < k*rate*rate/accel) {
+    float t = sqrtf(distance/accel);
+    if (minRate > 0.0F) {
+      float u = (t - sqrtf(fmaxf(t*t - minRate*seconds/accel, 0.0F)))*accel/minRate;
+      k = 1.0F/(u*u);
+    } else k = (4.0F*t*t)/(seconds*seconds);
+  }
+
+  if (k > 0.0F && k < 1.0F) {
+    gotoScale *= k;
+    V(axisPrefix); VF("autoGoto synchronized, rate and accel scaled by "); V(k); VF(" for "); V(seconds); VLF(" s");
+  }
+}
+
 // auto slew
 // \param direction: direction of motion, DIR_FORWARD or DIR_REVERSE
 // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
@@ -517,20 +619,26 @@ void Axis::poll() {
         motor->setSynchronized(true);
         V(axisPrefix); VLF("slew stopped");
       } else {
-        freq = sqrtf(2.0F*(slewAccelRateFs*FRACTIONAL_SEC)*getOriginOrTargetDistance());
+        float accel = slewAccelRateFs*gotoScale*FRACTIONAL_SEC;
+        if (slewProfile == SP_SCURVE) freq = sCurveRateByDistance(getOriginOrTargetDistance(), accel, slewFreq*gotoScale); else
+                                      freq = sqrtf(2.0F*accel*getOriginOrTargetDistance());
         if (freq < backlashFreq) freq = backlashFreq;
-        if (freq > slewFreq) freq = slewFreq;
+        if (freq > slewFreq*gotoScale) freq = slewFreq*gotoScale;
         if (motor->getTargetDistanceSteps() < 0) freq = -freq;
         rampFreq = freq;
       }
     } else
     if (autoRate == AR_RATE_BY_TIME_FORWARD) {
-      freq += slewAccelRateFs;
-      if (freq > slewFreq) freq = slewFreq;
+      if (slewProfile == SP_SCURVE) freq = sCurveRateByTime(freq, slewFreq); else {
+        freq += slewAccelRateFs;
+        if (freq > slewFreq) freq = slewFreq;
+      }
     } else
     if (autoRate == AR_RATE_BY_TIME_REVERSE) {
-      freq -= slewAccelRateFs;
-      if (freq < -slewFreq) freq = -slewFreq;
+      if (slewProfile == SP_SCURVE) freq = sCurveRateByTime(freq, -slewFreq); else {
+        freq -= slewAccelRateFs;
+        if (freq < -slewFreq) freq = -slewFreq;
+      }
     } else
     if (autoRate == AR_RATE_BY_TIME_END) {
       if (commonMinMaxSensed) {
@@ -539,6 +647,7 @@ void Axis::poll() {
         return;
       }
 
+      if (slewProfile == SP_SCURVE) freq = sCurveRateByTime(freq, 0.0F); else
       if (freq > slewAccelRateFs) freq -= slewAccelRateFs; else if (freq < -slewAccelRateFs) freq += slewAccelRateFs; else freq = 0.0F;
       if (fabs(freq) <= slewAccelRateFs) {
         motor->setSlewing(false);
@@ -98,6 +98,7 @@ typedef struct AxisErrors {
 } AxisErrors;
 
 enum AutoRate: uint8_t {AR_NONE, AR_RATE_BY_TIME_ABORT, AR_RATE_BY_TIME_END, AR_RATE_BY_DISTANCE, AR_RATE_BY_TIME_FORWARD, AR_RATE_BY_TIME_REVERSE};
+enum SlewProfile: uint8_t {SP_LINEAR, SP_SCURVE};
 enum HomingStage: uint8_t {HOME_NONE, HOME_FINE, HOME_SLOW, HOME_FAST};
 enum AxisMeasure: uint8_t {AXIS_MEASURE_UNKNOWN, AXIS_MEASURE_MICRONS, AXIS_MEASURE_DEGREES, AXIS_MEASURE_RADIANS};
 
@@ -248,6 +249,10 @@ class Axis {
     // set acceleration rate in seconds (for autoSlew)
     void setSlewAccelerationTime(float seconds);
 
+    // set acceleration profile for autoGoto and autoSlew, SP_SCURVE limits jerk by following a raised
+    // cosine ramp over the same time and distance as SP_LINEAR (emergency stops are always linear)
+    void setSlewProfile(SlewProfile profile) { slewProfile = profile; }
+
     // set acceleration for emergency stop movement in "measures" per second per second
     void setSlewAccelerationRateAbort(float mpsps);
 
@@ -258,6 +263,15 @@ class Axis {
     // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
     CommandError autoGoto(float frequency = NAN);
 
+    // estimated time in seconds for the autoGoto in progress to complete
+    // \param targetRate: rate the target moves at in "measures" per second, positive when away from the axis
+    float getAutoGotoTime(float targetRate = 0.0F);
+
+    // stretch the autoGoto in progress to take the given time in seconds, its slew rate and
+    // acceleration are scaled down together so it can finish along with another axis
+    // \param targetRate: rate the target moves at in "measures" per second, positive when away from the axis
+    void setAutoGotoTime(float seconds, float targetRate = 0.0F);
+
     // auto slew
     // \param direction: direction of motion, DIR_FORWARD or DIR_REVERSE
     // \param frequency: optional frequency of slew in "measures" (radians, microns, etc.) per second
@@ -331,6 +345,15 @@ class Axis {
     // distance to origin or target, whichever is closer, in "measures" (degrees, microns, etc.)
     double getOriginOrTargetDistance();
 
+    // S-curve rate for a distance from the origin or target, with accel and rate as for the linear ramp
+    float sCurveRateByDistance(float distance, float accel, float rate);
+
+    // S-curve rate one FRACTIONAL_SEC step on from frequency toward the target frequency
+    float sCurveRateByTime(float frequency, float target);
+
+    // time in seconds for the autoGoto in progress to cover the given distance in "measures"
+    float autoGotoTime(float distance);
+
     // returns true if traveling through backlash
     bool inBacklash();
 
@@ -401,6 +424,8 @@ class Axis {
     float abortAccelRateFs;            // abort slew rate in measures per second per frac-sec
     float slewAccelTime = NAN;         // auto slew acceleration time in seconds
     float abortAccelTime = NAN;        // abort slew acceleration time in seconds
+    SlewProfile slewProfile = SP_LINEAR; // acceleration profile for autoGoto and autoSlew
+    float gotoScale = 1.0F;            // autoGoto slew rate and acceleration scale, for synchronized motion
 
     HomingStage homingStage = HOME_NONE;
 
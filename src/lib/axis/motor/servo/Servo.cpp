@@ -19,6 +19,14 @@ IRAM_ATTR void moveServoMotorAxis7() { servoMotorInstance[6]->move(); }
 IRAM_ATTR void moveServoMotorAxis8() { servoMotorInstance[7]->move(); }
 IRAM_ATTR void moveServoMotorAxis9() { servoMotorInstance[8]->move(); }
 
+// the control loops for axes 1 and 2 run from one hardware timer
+ServoMotor *servoMotorControl[2] = { NULL, NULL };
+uint8_t servoControlHandle = 0;
+IRAM_ATTR void controlServoMotors() {
+  if (servoMotorControl[0] != NULL) servoMotorControl[0]->controlLoop();
+  if (servoMotorControl[1] != NULL) servoMotorControl[1]->controlLoop();
+}
+
 // constructor
 ServoMotor::ServoMotor(uint8_t axisNumber, ServoDriver *Driver, Encoder *encoder, uint32_t encoderOrigin, bool encoderReverse, Feedback *feedback, ServoControl *control, long syncThreshold, bool useFastHardwareTimers) {
   if (axisNumber < 1 || axisNumber > 9) return;
@@ -39,6 +47,7 @@ ServoMotor::ServoMotor(uint8_t axisNumber, ServoDriver *Driver, Encoder *encoder
 
   encoder->init();
   encoder->setOrigin(encoderOrigin);
+  encoderFilterInit();
   this->encoderReverse = encoderReverse;
   this->encoderReverseDefault = encoderReverse;
 
@@ -57,7 +66,6 @@ ServoMotor::ServoMotor(uint8_t axisNumber, ServoDriver *Driver, Encoder *encoder
     case 8: callback = moveServoMotorAxis8; break;
     case 9: callback = moveServoMotorAxis9; break;
   }
-
   // get the feedback control loop ready
   feedback->init(axisNumber, control, driver->getMotorControlRange());
 }
@@ -89,12 +97,80 @@ bool ServoMotor::init() {
     return false;
   }
 
+  controlLoopInit();
+
   return true;
 }
 
+// start controlLoop() on a hardware timer, if possible
+void ServoMotor::controlLoopInit() {
+  #if SERVO_CONTROL_RATE != OFF
+    if (!useFastHardwareTimers || axisNumber > 2) return;
+
+    V(axisPrefix);
+    VF("start control loop at "); V(SERVO_CONTROL_RATE); VF("Hz... ");
+    if (!encoder->isrSafe) { VLF("skipped, encoder can't be read from a timer interrupt"); return; }
+    if (!driver->setFastControlRate(SERVO_CONTROL_RATE)) { VLF("skipped, not supported by the motor driver"); return; }
+
+    // the first axis starts the timer, the second joins it
+    if (!servoControlHandle) {
+      uint8_t handle = tasks.add(0, 0, true, 0, controlServoMotors, "SvoLp");
+      if (!handle || !tasks.requestHardwareTimer(handle, 0)) {
+        if (handle) tasks.remove(handle);
+        VLF("FAILED! (no hardware timer, using the servo task)");
+        return;
+      }
+      tasks.setPeriodSubMicros(handle, lroundf(16000000.0F/SERVO_CONTROL_RATE));
+      servoControlHandle = handle;
+    }
+
+    controlPid.setRange(lroundf(driver->getMotorControlRange()));
+    controlFeedForward = lroundf(velocityEstimate*65536.0F);
+    controlIn = encoderRead();
+    controlLoopGains(true);
+    controlHandle = servoControlHandle;
+    servoMotorControl[axisNumber - 1] = this;
+    VLF("success");
+  #endif
+}
+
+// converts the feedback gains for controlLoop(), if they changed
+void ServoMotor::controlLoopGains(bool force) {
+  #if SERVO_CONTROL_RATE != OFF
+    float p, i, d;
+    feedback->getGains(&p, &i, &d);
+    if (!force && p == controlP && i == controlI && d == controlD) return;
+    controlP = p;
+    controlI = i;
+    controlD = d;
+    controlPid.setGains(p, i, d, SERVO_CONTROL_RATE, controlReverse);
+  #else
+    UNUSED(force);
+  #endif
+}
+
+// holds off controlLoop() while the encoder count is changed from task context, the encoder drivers
+// enable interrupts again themselves so this can't be done with interrupts disabled throughout
+void ServoMotor::controlLoopPause() {
+  controlPaused = true;
+}
+
+// restarts controlLoop() from the encoder count as it is now
+void ServoMotor::controlLoopResume() {
+  long encoderCounts = encoderRead();
+  noInterrupts();
+  lastFilterIn = encoderCounts - motorSteps;
+  filter->reset(lastFilterIn);
+  controlIn = encoderCounts;
+  controlPaused = false;
+  interrupts();
+}
+
 // set driver reverse state
 void ServoMotor::setReverse(int8_t state) {
   feedback->setControlDirection(state);
+  controlReverse = state == ON;
+  if (controlHandle) controlLoopGains(true);
   if (state == ON) encoderReverse = encoderReverseDefault; else encoderReverse = !encoderReverseDefault; 
 }
 
@@ -122,6 +198,7 @@ DriverStatus ServoMotor::getDriverStatus() {
 
 // resets motor and target angular position in steps, also zeros backlash and index
 void ServoMotor::resetPositionSteps(long value) {
+  controlLoopPause();
   Motor::resetPositionSteps(value);
   if (syncThreshold == OFF) {
     encoder->write(value);
@@ -129,6 +206,7 @@ void ServoMotor::resetPositionSteps(long value) {
     V(axisPrefix);
     VL("absolute encoder ignored reset position");
   }
+  controlLoopResume();
 }
 
 // get instrument coordinate, in steps
@@ -201,6 +279,7 @@ void ServoMotor::setFrequencySteps(float frequency) {
 
     currentFrequency = frequency;
     velocityEstimate = -driver->getVelocityEstimate(currentFrequency*dir);
+    controlFeedForward = lroundf(velocityEstimate*65536.0F);
 
     // change the motor rate/direction
     noInterrupts();
@@ -244,22 +323,38 @@ void ServoMotor::poll() {
   }
 
   long motorCounts = 0;
+  float velocity;
 
-  noInterrupts();
-  motorCounts = motorSteps;
-  interrupts();
+  if (controlHandle) {
+    // the control law runs in controlLoop(), just pick up where it's at
+    noInterrupts();
+    motorCounts = controlSet;
+    encoderCounts = controlIn;
+    velocity = controlOut;
+    interrupts();
 
-  encoderCounts = encoderApplyFilter(encoderCounts - motorCounts) + motorCounts;
+    control->set = motorCounts;
+    control->in = encoderCounts;
+    control->out = velocity - velocityEstimate;
+    if (enabled) feedback->pollParameters();
+  } else {
+    noInterrupts();
+    motorCounts = motorSteps;
+    interrupts();
 
-  control->set = motorCounts;
-  control->in = encoderCounts;
-  if (enabled) feedback->poll();
+    encoderCounts = encoderApplyFilter(encoderCounts - motorCounts) + motorCounts;
 
-  float velocity = velocityEstimate + control->out;
-  if (!enabled) velocity = 0.0F;
+    control->set = motorCounts;
+    control->in = encoderCounts;
+    if (enabled) feedback->poll();
+
+    velocity = velocityEstimate + control->out;
+    if (!enabled) velocity = 0.0F;
+    velocity = driver->setMotorVelocity(velocity);
+  }
 
   delta = motorCounts - encoderCounts;
-  velocityPercent = (driver->setMotorVelocity(velocity)/driver->getMotorControlRange()) * 100.0F;
+  velocityPercent = (velocity/driver->getMotorControlRange()) * 100.0F;
   if (driver->getMotorDirection() == DIR_FORWARD) control->directionHint = 1; else control->directionHint = -1;
 
   if (feedback->useVariableParameters) {
@@ -272,6 +367,7 @@ void ServoMotor::poll() {
       feedback->selectSlewingParameters();
     } 
   }
+  if (controlHandle) controlLoopGains();
 
   // if the driver has shutdown itself we should also shutdown
   if (driver->getStatus().fault && enabled) enable(false);
@@ -380,6 +476,30 @@ IRAM_ATTR void ServoMotor::move() {
   #endif
 }
 
+// reads the encoder, updates the fixed point PID and sets servo motor power/direction, at SERVO_CONTROL_RATE
+IRAM_ATTR void ServoMotor::controlLoop() {
+  if (controlPaused) return;
+
+  // everything called from here is in IRAM and makes no virtual calls, it can run while the flash is busy
+  long motorCounts = motorSteps;
+  long encoderCounts = encoder->readIsr();
+  if (encoderReverse) encoderCounts = -encoderCounts;
+  encoderCounts = encoderApplyFilter(encoderCounts - motorCounts) + motorCounts;
+
+  // PID on error (P, I) and on measurement (D) plus the velocity estimate as feed forward
+  int32_t power = 0;
+  if (enabled) power = controlPid.compute(motorCounts - encoderCounts, encoderCounts - controlIn, controlFeedForward); else controlPid.reset();
+
+  controlSet = motorCounts;
+  controlIn = encoderCounts;
+  #ifdef SERVO_DC_PRESENT
+    // only ServoDc has a fast control rate
+    controlOut = ((ServoDc*)driver)->setMotorVelocityFast(power);
+  #else
+    UNUSED(power);
+  #endif
+}
+
 int32_t ServoMotor::encoderRead() {
   int32_t encoderCounts = encoder->read();
 
@@ -390,13 +510,22 @@ int32_t ServoMotor::encoderRead() {
 
 // set zero/origin of absolute encoders
 uint32_t ServoMotor::encoderZero() {
+  controlLoopPause();
   encoder->origin = 0;
   encoder->offset = 0;
 
   uint32_t zero = (uint32_t)(-encoder->read());
   encoder->origin = zero;
+  controlLoopResume();
 
   return zero;
 }
 
+// set origin of absolute encoders
+void ServoMotor::encoderSetOrigin(uint32_t origin) {
+  controlLoopPause();
+  encoder->setOrigin(origin);
+  controlLoopResume();
+}
+
 #endif
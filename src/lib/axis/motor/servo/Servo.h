@@ -19,6 +19,11 @@
 #include "tmc5160/Tmc5160.h"
 
 #include "feedback/Pid/Pid.h"
+#include "feedback/Pid/FixedPid.h"
+
+#include "filter/Median/Median.h"
+#include "filter/AlphaBeta/AlphaBeta.h"
+#include "filter/Kalman/Kalman.h"
 
 #ifndef SERVO_SLEW_DIRECT
   #define SERVO_SLEW_DIRECT OFF
@@ -86,6 +91,9 @@ class ServoMotor : public Motor {
 
     // sets dir as required and moves coord toward target at setFrequencySteps() rate
     void move();
+
+    // reads the encoder, updates the fixed point PID and sets servo motor power/direction, at SERVO_CONTROL_RATE
+    void controlLoop();
     
     // calibrate the motor driver
     void calibrateDriver() { driver->calibrateDriver(); }
@@ -94,11 +102,20 @@ class ServoMotor : public Motor {
     uint32_t encoderZero();
 
     // set origin of absolute encoders
-    void encoderSetOrigin(uint32_t origin) { encoder->setOrigin(origin); }
+    void encoderSetOrigin(uint32_t origin);
 
     // read encoder
     int32_t encoderRead();
 
+    // select the encoder filter: OFF, MEDIAN, ALPHA_BETA, or KALMAN
+    bool setFilter(int type);
+
+    // get the encoder filter selected
+    inline int getFilter() { return filterType; }
+
+    // get the encoder filter velocity estimate in counts per control cycle, zero if not supported
+    inline float getFilterVelocity() { return filter->velocity/(float)FILTER_ONE; }
+
     // servo motor driver
     ServoDriver *driver;
 
@@ -113,6 +130,27 @@ class ServoMotor : public Motor {
     float velocityOverride = 0.0F;
 
     long encoderApplyFilter(long encoderCounts);
+    void encoderFilterInit();
+
+    // start controlLoop() on a hardware timer, if possible
+    void controlLoopInit();
+
+    // converts the feedback gains for controlLoop(), if they changed
+    void controlLoopGains(bool force = false);
+
+    // holds off controlLoop() while the encoder count is changed from task context
+    void controlLoopPause();
+
+    // restarts controlLoop() from the encoder count as it is now
+    void controlLoopResume();
+
+    Filter noFilter;
+    Median medianFilter = Median(SERVO_FLTR_MEDIAN_WIDTH);
+    AlphaBeta alphaBetaFilter = AlphaBeta(SERVO_FLTR_ALPHA, SERVO_FLTR_BETA, SERVO_FLTR_GAMMA);
+    Kalman kalmanFilter = Kalman(SERVO_FLTR_MEAS_VAR, SERVO_FLTR_PROC_VAR);
+    Filter *filter = &noFilter;
+    int filterType = OFF;
+    long lastFilterIn = 0;
 
     uint8_t servoMonitorHandle = 0;
     uint8_t taskHandle = 0;
@@ -137,6 +175,17 @@ class ServoMotor : public Motor {
 
     void (*callback)() = NULL;
 
+    // controlLoop() state
+    uint8_t controlHandle = 0;          // controlLoop() task handle, 0 when the control law runs from poll()
+    volatile bool controlPaused = false; // true while controlLoop() is held off
+    FixedPid controlPid;
+    volatile int32_t controlFeedForward = 0; // velocityEstimate as 16.16 fixed point
+    volatile long controlSet = 0;       // motor counts at the last controlLoop()
+    volatile long controlIn = 0;        // filtered encoder counts at the last controlLoop()
+    volatile int32_t controlOut = 0;    // power set at the last controlLoop()
+    float controlP = 0, controlI = 0, controlD = 0;
+    bool controlReverse = false;
+
     Feedback *feedback;
     ServoControl *control;
 
@@ -60,6 +60,9 @@ class ServoDriver {
     // set motor velocity, returns velocity actually set
     virtual float setMotorVelocity(float velocity);
 
+    // get ready for ServoDc::setMotorVelocityFast() calls at rate (in Hz,) returns false if not supported
+    virtual bool setFastControlRate(float rate) { UNUSED(rate); return false; }
+
     // returns motor direction (DIR_FORWARD or DIR_REVERSE)
     Direction getMotorDirection() { return motorDirection; };
 
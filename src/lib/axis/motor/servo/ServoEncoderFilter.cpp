@@ -33,91 +33,134 @@
   #define AXIS9_SERVO_FLTR OFF
 #endif
 
-#if AXIS1_SERVO_FLTR == KALMAN || AXIS2_SERVO_FLTR == KALMAN || AXIS3_SERVO_FLTR == KALMAN || \
-    AXIS4_SERVO_FLTR == KALMAN || AXIS5_SERVO_FLTR == KALMAN || AXIS6_SERVO_FLTR == KALMAN || \
-    AXIS7_SERVO_FLTR == KALMAN || AXIS8_SERVO_FLTR == KALMAN || AXIS9_SERVO_FLTR == KALMAN
-  #include <SimpleKalmanFilter.h> // https://github.com/denyssene/SimpleKalmanFilter
+#ifndef AXIS1_SERVO_FLTR_MEAS_VAR
+  #define AXIS1_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
 #endif
-
-#if AXIS1_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis1EncoderKalmanFilter(AXIS1_SERVO_FLTR_MEAS_U, AXIS1_SERVO_FLTR_MEAS_U, AXIS1_SERVO_FLTR_VARIANCE);
+#ifndef AXIS1_SERVO_FLTR_PROC_VAR
+  #define AXIS1_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
 #endif
-#if AXIS2_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis2EncoderKalmanFilter(AXIS2_SERVO_FLTR_MEAS_U, AXIS2_SERVO_FLTR_MEAS_U, AXIS2_SERVO_FLTR_VARIANCE);
+#ifndef AXIS2_SERVO_FLTR_MEAS_VAR
+  #define AXIS2_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
 #endif
-#if AXIS3_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis3EncoderKalmanFilter(AXIS3_SERVO_FLTR_MEAS_U, AXIS3_SERVO_FLTR_MEAS_U, AXIS3_SERVO_FLTR_VARIANCE);
+#ifndef AXIS2_SERVO_FLTR_PROC_VAR
+  #define AXIS2_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
 #endif
-#if AXIS4_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis4EncoderKalmanFilter(AXIS4_SERVO_FLTR_MEAS_U, AXIS4_SERVO_FLTR_MEAS_U, AXIS4_SERVO_FLTR_VARIANCE);
+#ifndef AXIS3_SERVO_FLTR_MEAS_VAR
+  #define AXIS3_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
 #endif
-#if AXIS5_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis5EncoderKalmanFilter(AXIS5_SERVO_FLTR_MEAS_U, AXIS5_SERVO_FLTR_MEAS_U, AXIS5_SERVO_FLTR_VARIANCE);
+#ifndef AXIS3_SERVO_FLTR_PROC_VAR
+  #define AXIS3_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
 #endif
-#if AXIS6_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis6EncoderKalmanFilter(AXIS6_SERVO_FLTR_MEAS_U, AXIS6_SERVO_FLTR_MEAS_U, AXIS6_SERVO_FLTR_VARIANCE);
+#ifndef AXIS4_SERVO_FLTR_MEAS_VAR
+  #define AXIS4_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
 #endif
-#if AXIS7_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis7EncoderKalmanFilter(AXIS7_SERVO_FLTR_MEAS_U, AXIS7_SERVO_FLTR_MEAS_U, AXIS7_SERVO_FLTR_VARIANCE);
+#ifndef AXIS4_SERVO_FLTR_PROC_VAR
+  #define AXIS4_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
 #endif
-#if AXIS8_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis8EncoderKalmanFilter(AXIS8_SERVO_FLTR_MEAS_U, AXIS8_SERVO_FLTR_MEAS_U, AXIS8_SERVO_FLTR_VARIANCE);
+#ifndef AXIS5_SERVO_FLTR_MEAS_VAR
+  #define AXIS5_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
 #endif
-#if AXIS9_SERVO_FLTR == KALMAN
-  SimpleKalmanFilter axis9EncoderKalmanFilter(AXIS9_SERVO_FLTR_MEAS_U, AXIS9_SERVO_FLTR_MEAS_U, AXIS9_SERVO_FLTR_VARIANCE);
+#ifndef AXIS5_SERVO_FLTR_PROC_VAR
+  #define AXIS5_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
+#endif
+#ifndef AXIS6_SERVO_FLTR_MEAS_VAR
+  #define AXIS6_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
+#endif
+#ifndef AXIS6_SERVO_FLTR_PROC_VAR
+  #define AXIS6_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
+#endif
+#ifndef AXIS7_SERVO_FLTR_MEAS_VAR
+  #define AXIS7_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
+#endif
+#ifndef AXIS7_SERVO_FLTR_PROC_VAR
+  #define AXIS7_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
+#endif
+#ifndef AXIS8_SERVO_FLTR_MEAS_VAR
+  #define AXIS8_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
+#endif
+#ifndef AXIS8_SERVO_FLTR_PROC_VAR
+  #define AXIS8_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
+#endif
+#ifndef AXIS9_SERVO_FLTR_MEAS_VAR
+  #define AXIS9_SERVO_FLTR_MEAS_VAR SERVO_FLTR_MEAS_VAR
+#endif
+#ifndef AXIS9_SERVO_FLTR_PROC_VAR
+  #define AXIS9_SERVO_FLTR_PROC_VAR SERVO_FLTR_PROC_VAR
 #endif
 
-long ServoMotor::encoderApplyFilter(long encoderCounts) {
-
-  // apply Kalaman filter if enabled
+// set the per axis filter parameters and select the default filter
+void ServoMotor::encoderFilterInit() {
   switch (axisNumber) {
     case 1:
-      #if AXIS1_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis1EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS1_SERVO_FLTR_MEAS_VAR, AXIS1_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS1_SERVO_FLTR);
     break;
     case 2:
-      #if AXIS2_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis2EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS2_SERVO_FLTR_MEAS_VAR, AXIS2_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS2_SERVO_FLTR);
     break;
     case 3:
-      #if AXIS3_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis3EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS3_SERVO_FLTR_MEAS_VAR, AXIS3_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS3_SERVO_FLTR);
     break;
     case 4:
-      #if AXIS4_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis4EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS4_SERVO_FLTR_MEAS_VAR, AXIS4_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS4_SERVO_FLTR);
     break;
     case 5:
-      #if AXIS5_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis5EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS5_SERVO_FLTR_MEAS_VAR, AXIS5_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS5_SERVO_FLTR);
     break;
     case 6:
-      #if AXIS6_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis6EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS6_SERVO_FLTR_MEAS_VAR, AXIS6_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS6_SERVO_FLTR);
     break;
     case 7:
-      #if AXIS7_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis7EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS7_SERVO_FLTR_MEAS_VAR, AXIS7_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS7_SERVO_FLTR);
     break;
     case 8:
-      #if AXIS8_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis8EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS8_SERVO_FLTR_MEAS_VAR, AXIS8_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS8_SERVO_FLTR);
     break;
     case 9:
-      #if AXIS9_SERVO_FLTR == KALMAN
-        encoderCounts = round(axis9EncoderKalmanFilter.updateEstimate(encoderCounts));
-      #endif
+      kalmanFilter.setVariance(AXIS9_SERVO_FLTR_MEAS_VAR, AXIS9_SERVO_FLTR_PROC_VAR);
+      setFilter(AXIS9_SERVO_FLTR);
     break;
   }
-  return encoderCounts;
+}
+
+// select the encoder filter: OFF, MEDIAN, ALPHA_BETA, or KALMAN
+bool ServoMotor::setFilter(int type) {
+  Filter *newFilter;
+  switch (type) {
+    case OFF: newFilter = &noFilter; break;
+    case MEDIAN: newFilter = &medianFilter; break;
+    case ALPHA_BETA: newFilter = &alphaBetaFilter; break;
+    case KALMAN: newFilter = &kalmanFilter; break;
+    default: return false;
+  }
+
+  // start from the latest unfiltered value so switching filters doesn't bump the control loop,
+  // which may be running from a timer interrupt
+  noInterrupts();
+  newFilter->reset(lastFilterIn);
+  filter = newFilter;
+  filterType = type;
+  interrupts();
+  return true;
+}
+
+// filter the encoder counts, this also runs from controlLoop() so the filter is called directly
+// rather than through filter-> as the vtable is in flash on the ESP32
+IRAM_ATTR long ServoMotor::encoderApplyFilter(long encoderCounts) {
+  lastFilterIn = encoderCounts;
+  switch (filterType) {
+    case MEDIAN: return medianFilter.Median::update(encoderCounts);
+    case ALPHA_BETA: return alphaBetaFilter.AlphaBeta::update(encoderCounts);
+    case KALMAN: return kalmanFilter.Kalman::update(encoderCounts);
+    default: return encoderCounts;
+  }
 }
 
 #endif
@@ -5,6 +5,11 @@
 
 #ifdef SERVO_DC_PRESENT
 
+#ifdef SERVO_DC_LEDC
+  #include "soc/gpio_struct.h"
+  #include "soc/ledc_struct.h"
+#endif
+
 #if defined(ARDUINO_TEENSY41) && defined(AXIS1_STEP_PIN) && AXIS1_STEP_PIN == 38 && defined(ANALOG_WRITE_PWM_FREQUENCY)
   // this is only for pin 38 of a Teensy4.1
   IntervalTimer itimer4;
@@ -34,6 +39,10 @@ ServoDc::ServoDc(uint8_t axisNumber, const ServoDcPins *Pins, const ServoDcSetti
   this->axisNumber = axisNumber;
 
   this->Pins = Pins;
+  in1 = Pins->in1;
+  inState1 = Pins->inState1;
+  in2 = Pins->in2;
+  inState2 = Pins->inState2;
   enablePin = Pins->enable;
   enabledState = Pins->enabledState;
   faultPin = Pins->fault;
@@ -44,6 +53,7 @@ ServoDc::ServoDc(uint8_t axisNumber, const ServoDcPins *Pins, const ServoDcSetti
   velocityMax = (Settings->velocityMax/100.0F)*ANALOG_WRITE_RANGE;
   acceleration = (Settings->acceleration/100.0F)*velocityMax;
   accelerationFs = acceleration/FRACTIONAL_SEC;
+  pwmMax = lroundf(velocityMax);
 }
 
 void ServoDc::init() {
@@ -110,16 +120,13 @@ void ServoDc::enable(bool state) {
 
     if (!enabled) {
       if (model == SERVO_EE) {
-        if (Pins->inState1 == HIGH) analogWrite(Pins->in1, round(velocityMax)); else analogWrite(Pins->in1, 0);
-        if (Pins->inState2 == HIGH) analogWrite(Pins->in2, round(velocityMax)); else analogWrite(Pins->in2, 0);
+        if (inState1 == HIGH) pwmWrite(1, pwmMax); else pwmWrite(1, 0);
+        if (inState2 == HIGH) pwmWrite(2, pwmMax); else pwmWrite(2, 0);
       } else
       if (model == SERVO_PE) {
-        digitalWriteF(Pins->in1, Pins->inState1);
-        if (Pins->inState2 == HIGH) power = velocityMax; else power = 0; 
-        #ifdef analogWritePin38
-          if (Pins->in2 == 38) analogWritePin38(round(power)); else
-        #endif
-        analogWrite(Pins->in2, round(power));
+        directionWrite(inState1);
+        if (inState2 == HIGH) power = pwmMax; else power = 0;
+        pwmWrite(2, power);
       }
     }
   } else {
@@ -148,48 +155,139 @@ float ServoDc::setMotorVelocity(float velocity) {
   }
   if (currentVelocity >= 0) motorDirection = DIR_FORWARD; else motorDirection = DIR_REVERSE;
 
-  pwmUpdate(fabs(currentVelocity));
+  pwmUpdate(lroundf(fabs(currentVelocity)));
   return currentVelocity;
 }
 
+// get ready for setMotorVelocityFast() calls at rate (in Hz)
+bool ServoDc::setFastControlRate(float rate) {
+  #ifdef ESP32
+    #ifdef SERVO_DC_LEDC
+      if (axisNumber < 1 || axisNumber > 2 || in1 < 0 || in1 >= 0x100 || in2 < 0 || in2 >= 0x100) return false;
+
+      // move the PWM pins to channels of our own, at their inactive state
+      int8_t channel = SERVO_DC_LEDC_CHANNEL + (axisNumber - 1)*2;
+      if (model == SERVO_EE) {
+        ledcSetup(channel, SERVO_DC_LEDC_FREQUENCY, ANALOG_WRITE_PWM_BITS);
+        ledcWrite(channel, inState1 == HIGH ? pwmMax : 0);
+        ledcAttachPin(in1, channel);
+        channel1 = channel;
+      }
+      ledcSetup(channel + 1, SERVO_DC_LEDC_FREQUENCY, ANALOG_WRITE_PWM_BITS);
+      ledcWrite(channel + 1, inState2 == HIGH ? pwmMax : 0);
+      ledcAttachPin(in2, channel + 1);
+      channel2 = channel + 1;
+    #else
+      return false;
+    #endif
+  #endif
+
+  accelerationFast = lroundf((acceleration/rate)*65536.0F);
+  if (accelerationFast < 1) accelerationFast = 1;
+  currentVelocityFast = lroundf(currentVelocity*65536.0F);
+  return true;
+}
+
+// set motor velocity by adjusting power from a timer interrupt, integer only
+IRAM_ATTR int32_t ServoDc::setMotorVelocityFast(int32_t power) {
+  if (!enabled) power = 0;
+
+  if (power > pwmMax) power = pwmMax; else
+  if (power < -pwmMax) power = -pwmMax;
+  int32_t velocity = power*65536;
+
+  if (velocity > currentVelocityFast) {
+    currentVelocityFast += accelerationFast;
+    if (currentVelocityFast > velocity) currentVelocityFast = velocity;
+  } else
+  if (velocity < currentVelocityFast) {
+    currentVelocityFast -= accelerationFast;
+    if (currentVelocityFast < velocity) currentVelocityFast = velocity;
+  }
+
+  if (currentVelocityFast >= 0) {
+    motorDirection = DIR_FORWARD;
+    power = (currentVelocityFast + 32768) >> 16;
+  } else {
+    motorDirection = DIR_REVERSE;
+    power = -((32768 - currentVelocityFast) >> 16);
+  }
+
+  pwmUpdate(abs(power));
+  return power;
+}
+
 // motor control update
-void ServoDc::pwmUpdate(float power) {
+IRAM_ATTR void ServoDc::pwmUpdate(int32_t power) {
   if (!enabled) return;
 
   if (model == SERVO_EE) {
     if (motorDirection == DIR_FORWARD) {
-      if (Pins->inState1 == HIGH) analogWrite(Pins->in1, round(velocityMax)); else analogWrite(Pins->in1, 0);
-      if (Pins->inState2 == HIGH) power = velocityMax - power;
-      analogWrite(Pins->in2, round(power));
+      if (inState1 == HIGH) pwmWrite(1, pwmMax); else pwmWrite(1, 0);
+      if (inState2 == HIGH) power = pwmMax - power;
+      pwmWrite(2, power);
     } else
     if (motorDirection == DIR_REVERSE) {
-      if (Pins->inState1 == HIGH) power = velocityMax - power;
-      analogWrite(Pins->in1, round(power));
-      if (Pins->inState2 == HIGH) analogWrite(Pins->in2, round(velocityMax)); else analogWrite(Pins->in2, 0);
+      if (inState1 == HIGH) power = pwmMax - power;
+      pwmWrite(1, power);
+      if (inState2 == HIGH) pwmWrite(2, pwmMax); else pwmWrite(2, 0);
     } else {
-      if (Pins->inState1 == HIGH) analogWrite(Pins->in1, round(velocityMax)); else analogWrite(Pins->in1, 0);
-      if (Pins->inState2 == HIGH) analogWrite(Pins->in2, round(velocityMax)); else analogWrite(Pins->in2, 0);
+      if (inState1 == HIGH) pwmWrite(1, pwmMax); else pwmWrite(1, 0);
+      if (inState2 == HIGH) pwmWrite(2, pwmMax); else pwmWrite(2, 0);
     }
   } else
   if (model == SERVO_PE) {
     if (motorDirection == DIR_FORWARD) {
-      digitalWriteF(Pins->in1, Pins->inState1);
-      if (Pins->inState2 == HIGH) power = velocityMax - power;
+      directionWrite(inState1);
+      if (inState2 == HIGH) power = pwmMax - power;
     } else
     if (motorDirection == DIR_REVERSE) {
-      digitalWriteF(Pins->in1, !Pins->inState1);
-      if (Pins->inState2 == HIGH) power = velocityMax - power;
+      directionWrite(!inState1);
+      if (inState2 == HIGH) power = pwmMax - power;
     } else {
-      digitalWriteF(Pins->in1, Pins->inState1);
-      if (Pins->inState2 == HIGH) power = velocityMax; else power = 0;
+      directionWrite(inState1);
+      if (inState2 == HIGH) power = pwmMax; else power = 0;
     }
-    #ifdef analogWritePin38
-      if (Pins->in2 == 38) analogWritePin38(round(power)); else
-    #endif
-    analogWrite(Pins->in2, round(power));
+    pwmWrite(2, power);
   }
 }
 
+// set PWM power on control pin in1 (1) or in2 (2)
+IRAM_ATTR void ServoDc::pwmWrite(uint8_t index, int32_t power) {
+  #ifdef SERVO_DC_LEDC
+    int8_t channel = (index == 1) ? channel1 : channel2;
+    if (channel != OFF) {
+      // the duty has four fractional bits, low speed channels (8 to 15) also need an update
+      uint8_t group = channel/8, n = channel%8;
+      LEDC.channel_group[group].channel[n].duty.duty = (uint32_t)power << 4;
+      LEDC.channel_group[group].channel[n].conf0.sig_out_en = 1;
+      LEDC.channel_group[group].channel[n].conf1.duty_start = 1;
+      if (group == 1) LEDC.channel_group[group].channel[n].conf0.low_speed_update = 1;
+      return;
+    }
+  #endif
+
+  #ifdef analogWritePin38
+    if (model == SERVO_PE && index == 2 && in2 == 38) { analogWritePin38(power); return; }
+  #endif
+  analogWrite((index == 1) ? in1 : in2, power);
+}
+
+// set the direction pin (in1) state
+IRAM_ATTR void ServoDc::directionWrite(uint8_t state) {
+  #ifdef SERVO_DC_LEDC
+    if (channel2 != OFF) {
+      if (in1 < 32) {
+        if (state) GPIO.out_w1ts = 1UL << in1; else GPIO.out_w1tc = 1UL << in1;
+      } else {
+        if (state) GPIO.out1_w1ts.val = 1UL << (in1 - 32); else GPIO.out1_w1tc.val = 1UL << (in1 - 32);
+      }
+      return;
+    }
+  #endif
+  digitalWriteF(in1, state);
+}
+
 // update status info. for driver
 void ServoDc::updateStatus() {
   if (statusMode == LOW || statusMode == HIGH) {
@@ -13,6 +13,20 @@
   #define ANALOG_WRITE_RANGE 255
 #endif
 
+// on the ESP32 setMotorVelocityFast() writes to the GPIO and LEDC registers directly, as analogWrite() is in flash,
+// using LEDC channels of its own (two per axis for axes 1 and 2, analogWrite() allocates channels from the top down)
+#if defined(ESP32) && defined(CONFIG_IDF_TARGET_ESP32)
+  #define SERVO_DC_LEDC
+  #ifndef SERVO_DC_LEDC_CHANNEL
+    #define SERVO_DC_LEDC_CHANNEL 0
+  #endif
+  #ifdef ANALOG_WRITE_PWM_FREQUENCY
+    #define SERVO_DC_LEDC_FREQUENCY ANALOG_WRITE_PWM_FREQUENCY
+  #else
+    #define SERVO_DC_LEDC_FREQUENCY 5000
+  #endif
+#endif
+
 typedef struct ServoDcPins {
   int16_t in1;
   uint8_t inState1;
@@ -44,6 +58,12 @@ class ServoDc : public ServoDriver {
     // set motor velocity by adjusting power (0 to ANALOG_WRITE_RANGE for 0 to 100% power)
     float setMotorVelocity(float power);
 
+    // get ready for setMotorVelocityFast() calls at rate (in Hz)
+    bool setFastControlRate(float rate);
+
+    // set motor velocity by adjusting power from a timer interrupt, integer only
+    int32_t setMotorVelocityFast(int32_t power);
+
     // update status info. for driver
     void updateStatus();
 
@@ -51,13 +71,34 @@ class ServoDc : public ServoDriver {
 
   private:
     // motor control update
-    void pwmUpdate(float power);
+    void pwmUpdate(int32_t power);
+
+    // set PWM power on control pin in1 (1) or in2 (2)
+    void pwmWrite(uint8_t index, int32_t power);
+
+    // set the direction pin (in1) state
+    void directionWrite(uint8_t state);
 
     const ServoDcPins *Pins;
 
+    // control pins copied from Pins, which may be in flash
+    int16_t in1;
+    uint8_t inState1;
+    int16_t in2;
+    uint8_t inState2;
+
+    #ifdef SERVO_DC_LEDC
+      int8_t channel1 = OFF;            // LEDC channels written directly, OFF to use analogWrite()
+      int8_t channel2 = OFF;
+    #endif
+
     float currentVelocity = 0.0F;
     float acceleration;
     float accelerationFs;
+
+    int32_t pwmMax;                     // velocityMax rounded to a whole PWM count
+    int32_t currentVelocityFast = 0;    // in PWM counts, 16.16 fixed point
+    int32_t accelerationFast = 0;       // in PWM counts per control loop cycle, 16.16 fixed point
 };
 
 #endif
@@ -45,6 +45,17 @@ void Feedback::setParameters(float param1, float param2, float param3, float par
   this->param6 = param6;
 }
 
+// get the P, I, D gains in use now
+void Feedback::getGains(float *p, float *i, float *d) {
+  *p = param1;
+  *i = param2;
+  *d = param3;
+}
+
+// just the automatic parameter changes from poll(), for when the control law runs elsewhere
+void Feedback::pollParameters() {
+}
+
 // validate driver parameters
 bool Feedback::validateParameters(float param1, float param2, float param3, float param4, float param5, float param6) {
   return true;
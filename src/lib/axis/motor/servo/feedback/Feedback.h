@@ -47,8 +47,14 @@ class Feedback {
     // set feedback control direction
     virtual void setControlDirection(int8_t state);
 
+    // get the P, I, D gains in use now
+    virtual void getGains(float *p, float *i, float *d);
+
     virtual void poll();
 
+    // just the automatic parameter changes from poll(), for when the control law runs elsewhere
+    virtual void pollParameters();
+
     bool useVariableParameters = false;
 
   protected:
@@ -0,0 +1,33 @@
+// -----------------------------------------------------------------------------------
+// servo motor fixed point PID, for the control loop run from a hardware timer
+
+#include "FixedPid.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+// set the gains, per second as for QuickPID, for a control loop run at rate (in Hz)
+void FixedPid::setGains(float p, float i, float d, float rate, bool reverse) {
+  int64_t kp = llroundf(p*65536.0F);
+  int64_t ki = llroundf((i/rate)*4294967296.0F);
+  int64_t kd = llroundf((d*rate)*65536.0F);
+  if (reverse) { kp = -kp; ki = -ki; kd = -kd; }
+
+  noInterrupts();
+  this->kp = kp;
+  this->ki = ki;
+  this->kd = kd;
+  interrupts();
+}
+
+// set the control range (+/-) and clear the integral
+void FixedPid::setRange(int32_t range) {
+  noInterrupts();
+  this->range = range;
+  rangeMax = (int64_t)range << 16;
+  integralMax = (int64_t)range << 32;
+  integral = 0;
+  lastError = 0;
+  interrupts();
+}
+
+#endif
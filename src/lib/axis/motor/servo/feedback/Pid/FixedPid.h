@@ -0,0 +1,53 @@
+// -----------------------------------------------------------------------------------
+// servo motor fixed point PID, for the control loop run from a hardware timer
+#pragma once
+#include "../../../../../../Common.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+// P and I on the error and D on the measurement with the integral kept to the control range, as QuickPID is set up
+// by default (pOnError, dOnMeas, iAwCondition), gains are 16.16 fixed point per cycle except ki which is 32.32
+class FixedPid {
+  public:
+    // set the gains, per second as for QuickPID, for a control loop run at rate (in Hz)
+    void setGains(float p, float i, float d, float rate, bool reverse);
+
+    // set the control range (+/-) and clear the integral
+    void setRange(int32_t range);
+
+    // clear the integral
+    IRAM_ATTR inline void reset() { integral = 0; lastError = 0; }
+
+    // power for this cycle from the error and the change in measurement since the last cycle,
+    // with feedForward (16.16 fixed point) added in
+    IRAM_ATTR inline int32_t compute(long error, long inputChange, int32_t feedForward) {
+      // with P and I for this cycle past the rails and the error growing the integral goes to the rail, as for iAwCondition
+      int64_t iTerm = ki*error;
+      int64_t iTermOut = kp*error + (iTerm >> 16);
+      if (iTermOut > rangeMax && ki*(error - lastError) > 0) iTerm = integralMax; else
+      if (iTermOut < -rangeMax && ki*(error - lastError) < 0) iTerm = -integralMax;
+      lastError = error;
+
+      integral += iTerm;
+      if (integral > integralMax) integral = integralMax; else
+      if (integral < -integralMax) integral = -integralMax;
+
+      int64_t power = feedForward + kp*error + (integral >> 16) - kd*inputChange;
+      power = (power + 32768) >> 16;
+      if (power > range) power = range; else
+      if (power < -range) power = -range;
+      return (int32_t)power;
+    }
+
+  private:
+    int64_t kp = 0;
+    int64_t ki = 0;
+    int64_t kd = 0;
+    int64_t integral = 0;               // in power, 32.32 fixed point
+    int64_t integralMax = 0;
+    int64_t rangeMax = 0;               // range, 16.16 fixed point
+    int32_t range = 0;                  // in power (+/-)
+    long lastError = 0;
+};
+
+#endif
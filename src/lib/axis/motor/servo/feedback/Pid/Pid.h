@@ -50,9 +50,16 @@ class Pid : public Feedback {
     // variable feedback, variable PID params
     void variableParameters(float percent);
 
+    // get the P, I, D gains in use now
+    void getGains(float *p, float *i, float *d) { *p = this->p; *i = this->i; *d = this->d; }
+
     inline void poll() {
       pid->Compute();
+      pollParameters();
+    }
 
+    // automatic switch from slewing to tracking parameters
+    inline void pollParameters() {
       if (!useVariableParameters) {
         if ((long)(millis() - nextSelectIncrementTime) > 0) {
           if (trackingSelected) parameterSelect--;
@@ -0,0 +1,38 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder alpha-beta-gamma tracking filter, fixed point
+
+#include "AlphaBeta.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+AlphaBeta::AlphaBeta(float alpha, float beta, float gamma) {
+  setGains(alpha, beta, gamma);
+}
+
+void AlphaBeta::setGains(float alpha, float beta, float gamma) {
+  this->alpha = lroundf(alpha*FILTER_ONE);
+  this->beta = lroundf(beta*FILTER_ONE);
+  this->gamma2 = lroundf(2.0F*gamma*FILTER_ONE);
+}
+
+void AlphaBeta::reset(int32_t sample) {
+  position = (int64_t)sample << FILTER_FRACTION_BITS;
+  velocity = 0;
+  acceleration = 0;
+}
+
+IRAM_ATTR int32_t AlphaBeta::update(int32_t sample) {
+  // predict one control cycle ahead
+  int64_t predicted = position + velocity + (acceleration >> 1);
+  int32_t predictedVelocity = velocity + acceleration;
+
+  // and correct by the residual
+  int64_t residual = ((int64_t)sample << FILTER_FRACTION_BITS) - predicted;
+  position = predicted + ((residual*alpha) >> FILTER_FRACTION_BITS);
+  velocity = predictedVelocity + (int32_t)((residual*beta) >> FILTER_FRACTION_BITS);
+  acceleration += (int32_t)((residual*gamma2) >> FILTER_FRACTION_BITS);
+
+  return (int32_t)((position + (FILTER_ONE >> 1)) >> FILTER_FRACTION_BITS);
+}
+
+#endif
@@ -0,0 +1,30 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder alpha-beta-gamma tracking filter, fixed point
+#pragma once
+
+#include "../Filter.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+class AlphaBeta : public Filter {
+  public:
+    // position, velocity, and acceleration correction gains (0 to 1,) gamma 0 for an alpha-beta filter
+    AlphaBeta(float alpha, float beta, float gamma = 0.0F);
+
+    void setGains(float alpha, float beta, float gamma);
+
+    void reset(int32_t sample);
+    int32_t update(int32_t sample);
+
+    // estimated acceleration in counts per control cycle squared (FILTER_FRACTION_BITS fixed point)
+    int32_t acceleration = 0;
+
+  protected:
+    int32_t alpha = 0;
+    int32_t beta = 0;
+    int32_t gamma2 = 0;   // 2*gamma as the acceleration update is 2*gamma*residual/dt^2
+
+    int64_t position = 0; // estimated position (FILTER_FRACTION_BITS fixed point)
+};
+
+#endif
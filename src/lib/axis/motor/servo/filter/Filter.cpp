@@ -0,0 +1,19 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder filter
+
+#include "Filter.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+// restart filtering from this sample
+void Filter::reset(int32_t sample) {
+  UNUSED(sample);
+  velocity = 0;
+}
+
+// no filtering, the sample passes through
+int32_t Filter::update(int32_t sample) {
+  return sample;
+}
+
+#endif
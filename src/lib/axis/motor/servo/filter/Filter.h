@@ -0,0 +1,24 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder filter
+#pragma once
+#include "../../../../../Common.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+// fixed point scale for filter states and gains
+#define FILTER_FRACTION_BITS 16
+#define FILTER_ONE (1L << FILTER_FRACTION_BITS)
+
+class Filter {
+  public:
+    // restart filtering from this sample
+    virtual void reset(int32_t sample);
+
+    // filter a new sample (once per control cycle) and return the estimate
+    virtual int32_t update(int32_t sample);
+
+    // estimated rate of change in counts per control cycle (FILTER_FRACTION_BITS fixed point), if the filter tracks it
+    int32_t velocity = 0;
+};
+
+#endif
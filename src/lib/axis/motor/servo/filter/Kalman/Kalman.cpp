@@ -0,0 +1,44 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder constant velocity Kalman filter, fixed point
+
+#include "Kalman.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+Kalman::Kalman(float measurement, float process) : AlphaBeta(0, 0) {
+  setVariance(measurement, process);
+}
+
+void Kalman::setVariance(float measurement, float process) {
+  if (measurement <= 0.0F) measurement = 1.0F;
+  if (process <= 0.0F) process = 1.0E-6F;
+
+  // iterate the covariance for x(k+1) = F x(k) with F = [1 1; 0 1] and
+  // process noise Q = q [1/4 1/2; 1/2 1] until the gains settle
+  float p00 = measurement, p01 = 0.0F, p11 = measurement;
+  float k0 = 0.0F, k1 = 0.0F;
+  for (int i = 0; i < 1000; i++) {
+    // predict
+    float a00 = p00 + 2.0F*p01 + p11 + process*0.25F;
+    float a01 = p01 + p11 + process*0.5F;
+    float a11 = p11 + process;
+
+    // gain
+    float s = a00 + measurement;
+    float n0 = a00/s, n1 = a01/s;
+
+    // correct
+    p00 = (1.0F - n0)*a00;
+    p01 = (1.0F - n0)*a01;
+    p11 = a11 - n1*a01;
+
+    bool settled = fabs(n0 - k0) < 1.0E-7F && fabs(n1 - k1) < 1.0E-7F;
+    k0 = n0;
+    k1 = n1;
+    if (settled) break;
+  }
+
+  setGains(k0, k1, 0.0F);
+}
+
+#endif
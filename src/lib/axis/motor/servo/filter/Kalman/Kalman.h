@@ -0,0 +1,21 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder constant velocity Kalman filter, fixed point
+#pragma once
+
+#include "../AlphaBeta/AlphaBeta.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+// the state is position and velocity with white noise acceleration, the covariance settles to
+// fixed gains after a few hundred cycles so these are found once up front and the per cycle
+// update is the same fixed point predict/correct as the alpha-beta filter
+class Kalman : public AlphaBeta {
+  public:
+    // measurement is the variance of the encoder noise in counts^2,
+    // process is the variance of the unmodeled acceleration in (counts/cycle^2)^2
+    Kalman(float measurement, float process);
+
+    void setVariance(float measurement, float process);
+};
+
+#endif
@@ -0,0 +1,40 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder rolling median filter, rejects single sample glitches
+
+#include "Median.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+Median::Median(uint8_t width) {
+  if (width > MEDIAN_WIDTH_MAX) width = MEDIAN_WIDTH_MAX;
+  if (width < 3) width = 3;
+  if (!(width & 1)) width--;
+  this->width = width;
+  reset(0);
+}
+
+void Median::reset(int32_t sample) {
+  for (int i = 0; i < width; i++) { history[i] = sample; sorted[i] = sample; }
+  oldest = 0;
+  velocity = 0;
+}
+
+IRAM_ATTR int32_t Median::update(int32_t sample) {
+  int32_t old = history[oldest];
+  history[oldest] = sample;
+  if (++oldest >= width) oldest = 0;
+
+  // remove the oldest sample from the sorted list
+  int i = 0;
+  while (i < width - 1 && sorted[i] != old) i++;
+  for (; i < width - 1; i++) sorted[i] = sorted[i + 1];
+
+  // and insert the new one in order
+  i = width - 1;
+  while (i > 0 && sorted[i - 1] > sample) { sorted[i] = sorted[i - 1]; i--; }
+  sorted[i] = sample;
+
+  return sorted[width/2];
+}
+
+#endif
@@ -0,0 +1,28 @@
+// -----------------------------------------------------------------------------------
+// servo motor encoder rolling median filter, rejects single sample glitches
+#pragma once
+
+#include "../Filter.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#define MEDIAN_WIDTH_MAX 9
+
+class Median : public Filter {
+  public:
+    // width is the number of samples (odd, 3 to MEDIAN_WIDTH_MAX)
+    Median(uint8_t width = 5);
+
+    void reset(int32_t sample);
+    int32_t update(int32_t sample);
+
+  private:
+    uint8_t width;
+
+    // samples in arrival order (ring) and in sorted order
+    int32_t history[MEDIAN_WIDTH_MAX];
+    int32_t sorted[MEDIAN_WIDTH_MAX];
+    uint8_t oldest = 0;
+};
+
+#endif
@@ -128,6 +128,10 @@ bool StepDirMotor::init() {
   #endif
   pinModeEx(Pins->step, OUTPUT);
   digitalWriteF(Pins->step, stepClr);
+  #if GPIO_DEVICE == SSR74HC595 && GPIO_SSR74HC595_FRAME_RATE != OFF && STEP_WAVE_FORM == PULSE
+    // the step pulse is cleared by the next 74HC595 frame
+    if (Pins->step >= 0x200) gpio.setPulsePin(Pins->step - 0x200, stepSet);
+  #endif
 
   // init default driver enable pin
   pinModeEx(Pins->enable, OUTPUT);
@@ -137,6 +141,11 @@ bool StepDirMotor::init() {
   V(axisPrefix); VF("start task to move motor... ");
   char timerName[] = "Motor_";
   timerName[5] = '0' + axisNumber;
+  #ifdef STEP_WAVE_PRESENT
+    // step signals on the 74HC595 are generated by the step wave engine if it's running
+    if (Pins->step >= 0x200 && stepWave.init()) waveHandle = stepWave.add(callback);
+    if (waveHandle) { VLF("success (step wave)"); return true; }
+  #endif
   taskHandle = tasks.add(0, 0, true, 0, callback, timerName);
   if (taskHandle) {
     V("success");
@@ -230,6 +239,15 @@ void StepDirMotor::setFrequencySteps(float frequency) {
     // range is 0 to 134 seconds/step
     if (!isnan(period) && period <= 130000000.0F) {
       period *= 16.0F;
+      #if GPIO_DEVICE == SSR74HC595 && GPIO_SSR74HC595_FRAME_RATE != OFF
+        // step signals through a 74HC595 latched in frames change once per frame at most, a step pulse takes two
+        // frames (one for a square wave timer tick) plus a margin for timer jitter
+        #if STEP_WAVE_FORM == SQUARE
+          if (Pins->step >= 0x200 && period < 20000000.0F/GPIO_SSR74HC595_FRAME_RATE) period = 20000000.0F/GPIO_SSR74HC595_FRAME_RATE;
+        #else
+          if (Pins->step >= 0x200 && period < 40000000.0F/GPIO_SSR74HC595_FRAME_RATE) period = 40000000.0F/GPIO_SSR74HC595_FRAME_RATE;
+        #endif
+      #endif
       lastPeriod = (unsigned long)lroundf(period);
     } else {
       lastPeriod = 0;
@@ -242,6 +260,9 @@ void StepDirMotor::setFrequencySteps(float frequency) {
     // change the motor rate/direction
     if (step != dir) step = 0;
     if (lastPeriodSet != lastPeriod) {
+      #ifdef STEP_WAVE_PRESENT
+        if (waveHandle) stepWave.setPeriodSubMicros(waveHandle, lastPeriod); else
+      #endif
       tasks.setPeriodSubMicros(taskHandle, lastPeriod);
       lastPeriodSet = lastPeriod;
     }
@@ -311,6 +332,13 @@ void StepDirMotor::setSlewing(bool state) {
 
 // swaps in/out fast unidirectional ISR for slewing 
 bool StepDirMotor::enableMoveFast(const bool fast) {
+  #ifdef STEP_WAVE_PRESENT
+    if (waveHandle) {
+      stepWave.setCallback(waveHandle, fast ? (direction == dirRev ? callbackFR : callbackFF) : callback);
+      V(axisPrefix); VF("step wave ISR swapped at "); V(lastFrequency); VLF(" steps/sec.");
+      return true;
+    }
+  #endif
   if (fast) {
     if (direction == dirRev) {
       tasks.setCallback(taskHandle, callbackFR);
@@ -15,6 +15,7 @@
 #include "tmcLegacy/LegacyUART.h"
 #include "tmcStepper/StepperSPI.h"
 #include "tmcStepper/StepperUART.h"
+#include "StepWave.h"
 #include "../Motor.h"
 
 typedef struct StepDirPins {
@@ -107,6 +108,9 @@ class StepDirMotor : public Motor {
 
   private:
     uint8_t taskHandle = 0;
+    #ifdef STEP_WAVE_PRESENT
+      uint8_t waveHandle = 0;            // step wave engine channel, if used instead of a timer
+    #endif
 
     #ifdef DRIVER_STEP_DEFAULTS
       #define stepClr LOW                // pin state to reset driver before taking a step
@@ -0,0 +1,286 @@
+// -----------------------------------------------------------------------------------
+// step waveform engine, precomputes 74HC595 frames for all step/dir axes and streams them out
+
+#include "StepWave.h"
+
+#ifdef STEP_WAVE_PRESENT
+
+#include "../../../tasks/OnTask.h"
+
+#ifdef ESP32
+  #include "soc/i2s_struct.h"
+  #include "soc/gpio_sig_map.h"
+  #include "driver/periph_ctrl.h"
+  #include "esp_intr_alloc.h"
+
+  StepWaveSinkI2S stepWaveSink;
+#else
+  StepWaveSinkTimer stepWaveSink;
+#endif
+
+void stepWavePollWrapper() { stepWave.poll(); }
+
+// frames the 74HC595 queue can't hold go into the ring buffer ahead of the frame being planned
+IRAM_ATTR void stepWaveFrameOutputWrapper(uint32_t frame) { stepWave.ring.push(frame); }
+
+// -----------------------------------------------------------------------------------
+// hardware timer sink
+
+StepWaveSinkTimer *stepWaveSinkTimerInstance = NULL;
+IRAM_ATTR void stepWaveSinkTimerWrapper() { stepWaveSinkTimerInstance->play(); }
+
+bool StepWaveSinkTimer::init(StepWaveRing *ring, float rate) {
+  this->ring = ring;
+  stepWaveSinkTimerInstance = this;
+  lastFrame = gpio.nextFrame();
+
+  VF("MSG: StepWave, start timer sink task (rate "); V(rate); VF("Hz priority 0)... ");
+  uint8_t handle = tasks.add(0, 0, true, 0, stepWaveSinkTimerWrapper, "WaveSnk");
+  if (!handle) { VLF("FAILED!"); return false; }
+  if (!tasks.requestHardwareTimer(handle, 0)) {
+    tasks.remove(handle);
+    VLF("no hardware timer!");
+    return false;
+  }
+  tasks.setPeriodSubMicros(handle, lroundf(16000000.0F/rate));
+  VLF("success");
+
+  return true;
+}
+
+// output the next frame, called from the timer ISR
+IRAM_ATTR void StepWaveSinkTimer::play() {
+  uint32_t frame;
+  if (!ring->pop(&frame)) { underruns++; frame = gpio.idleFrame(lastFrame); }
+  if (frame != lastFrame) {
+    gpio.writeFrame(frame);
+    lastFrame = frame;
+  }
+}
+
+// -----------------------------------------------------------------------------------
+// I2S sink
+
+#ifdef ESP32
+  StepWaveSinkI2S *stepWaveSinkI2SInstance = NULL;
+  IRAM_ATTR void stepWaveSinkI2SWrapper(void *arg) { UNUSED(arg); stepWaveSinkI2SInstance->refill(); }
+
+  bool StepWaveSinkI2S::init(StepWaveRing *ring, float rate) {
+    this->ring = ring;
+    stepWaveSinkI2SInstance = this;
+    depth = STEP_WAVE_I2S_DMA_BUFFERS*STEP_WAVE_I2S_DMA_FRAMES;
+
+    VF("MSG: StepWave, start I2S sink (rate "); V(rate); VF("Hz)... ");
+
+    // each frame is a 32 bit sample in the left channel (the right channel is a constant), the 74HC595
+    // latches on the rising edge of word select after the left channel is shifted in, so 64 bit clocks
+    // per frame from the 160MHz PLL: rate = 160MHz/((N + b/a)*bck*64), pick the closest divider
+    float bestError = 1.0E9F;
+    int bestN = 0, bestB = 0, bestA = 1, bestBck = 2;
+    for (int bck = 2; bck <= 63; bck++) {
+      float div = 160000000.0F/(rate*bck*64.0F);
+      int n = (int)div;
+      if (n < 2 || n > 254) continue;
+      for (int a = 1; a <= 63; a++) {
+        int b = lroundf((div - n)*a);
+        if (b >= a) continue;
+        float error = fabs(div - (n + (float)b/a));
+        if (error < bestError) { bestError = error; bestN = n; bestB = b; bestA = a; bestBck = bck; }
+      }
+    }
+    if (bestN == 0) { VLF("FAILED, rate out of range!"); return false; }
+
+    // the DMA buffers form a loop, the ISR refills each as it finishes so the output never runs dry, if the
+    // ring buffer is empty the last frame repeats with the pulse pins inactive (rather than all zeros)
+    lastFrame = gpio.nextFrame();
+    for (int i = 0; i < STEP_WAVE_I2S_DMA_BUFFERS; i++) {
+      fill(buffer[i]);
+      desc[i].size = STEP_WAVE_I2S_DMA_FRAMES*4;
+      desc[i].length = STEP_WAVE_I2S_DMA_FRAMES*4;
+      desc[i].offset = 0;
+      desc[i].sosf = 0;
+      desc[i].eof = 1;
+      desc[i].owner = 1;
+      desc[i].buf = (uint8_t *)buffer[i];
+      desc[i].empty = (uint32_t)&desc[(i + 1) % STEP_WAVE_I2S_DMA_BUFFERS];
+    }
+    underruns = 0;
+
+    periph_module_enable(PERIPH_I2S0_MODULE);
+
+    I2S0.conf.tx_reset = 1; I2S0.conf.tx_reset = 0;
+    I2S0.conf.tx_fifo_reset = 1; I2S0.conf.tx_fifo_reset = 0;
+    I2S0.lc_conf.out_rst = 1; I2S0.lc_conf.out_rst = 0;
+
+    I2S0.lc_conf.check_owner = 0;
+    I2S0.lc_conf.out_loop_test = 0;
+    I2S0.lc_conf.out_auto_wrback = 0;
+    I2S0.lc_conf.out_data_burst_en = 0;
+    I2S0.lc_conf.outdscr_burst_en = 0;
+    I2S0.lc_conf.out_no_restart_clr = 0;
+    I2S0.lc_conf.out_eof_mode = 1;
+    I2S0.conf2.lcd_en = 0;
+    I2S0.conf2.camera_en = 0;
+    I2S0.pdm_conf.pcm2pdm_conv_en = 0;
+    I2S0.pdm_conf.pdm2pcm_conv_en = 0;
+    I2S0.pdm_conf.tx_pdm_en = 0;
+
+    I2S0.fifo_conf.dscr_en = 0;
+    I2S0.conf_chan.tx_chan_mod = 4;
+    I2S0.conf_single_data = lastFrame;
+    I2S0.fifo_conf.tx_fifo_mod = 3;
+    I2S0.fifo_conf.tx_fifo_mod_force_en = 1;
+    I2S0.sample_rate_conf.tx_bits_mod = 32;
+
+    I2S0.conf.tx_mono = 0;
+    I2S0.conf.tx_start = 0;
+    I2S0.conf.tx_msb_right = 1;
+    I2S0.conf.tx_right_first = 0;
+    I2S0.conf.tx_slave_mod = 0;
+    I2S0.conf.tx_short_sync = 0;
+    I2S0.conf.tx_msb_shift = 0;
+    I2S0.conf1.tx_stop_en = 0;
+
+    I2S0.clkm_conf.clka_en = 0;
+    I2S0.clkm_conf.clkm_div_num = bestN;
+    I2S0.clkm_conf.clkm_div_b = bestB;
+    I2S0.clkm_conf.clkm_div_a = bestA;
+    I2S0.clkm_conf.clk_en = 1;
+    I2S0.sample_rate_conf.tx_bck_div_num = bestBck;
+
+    // the ISR is in IRAM so the outputs keep going (holding the last frame) while flash is busy
+    I2S0.int_ena.val = 0;
+    I2S0.int_clr.val = 0xFFFFFFFF;
+    if (esp_intr_alloc(ETS_I2S0_INTR_SOURCE, ESP_INTR_FLAG_IRAM, stepWaveSinkI2SWrapper, NULL, NULL) != ESP_OK) {
+      VLF("FAILED, no interrupt!");
+      return false;
+    }
+
+    I2S0.out_link.addr = (uint32_t)&desc[0];
+    I2S0.fifo_conf.dscr_en = 1;
+    I2S0.out_link.start = 1;
+    I2S0.int_ena.out_eof = 1;
+    I2S0.conf.tx_start = 1;
+
+    // the pins are handed over to the I2S peripheral once it is running from the DMA buffers, until
+    // then the 74HC595 just holds the last value latched
+    pinMatrixOutAttach(GPIO_SSR74HC595_DATA_PIN, I2S0O_DATA_OUT23_IDX, false, false);
+    pinMatrixOutAttach(GPIO_SSR74HC595_CLOCK_PIN, I2S0O_BCK_OUT_IDX, false, false);
+    pinMatrixOutAttach(GPIO_SSR74HC595_LATCH_PIN, I2S0O_WS_OUT_IDX, false, false);
+
+    VF("success (actual rate "); V(160000000.0F/((bestN + (float)bestB/bestA)*bestBck*64.0F)); VLF("Hz)");
+    return true;
+  }
+
+  // refills the DMA buffers that finished playing, called from the I2S ISR
+  IRAM_ATTR void StepWaveSinkI2S::refill() {
+    if (I2S0.int_st.out_eof) {
+      // the buffers are refilled in order up to the one that just finished, in case an interrupt was missed
+      lldesc_t *finished = (lldesc_t *)I2S0.out_eof_des_addr;
+      for (int i = 0; i < STEP_WAVE_I2S_DMA_BUFFERS; i++) {
+        bool last = &desc[fillIndex] == finished;
+        fill(buffer[fillIndex]);
+        fillIndex = (fillIndex + 1) % STEP_WAVE_I2S_DMA_BUFFERS;
+        if (last) break;
+      }
+    }
+    I2S0.int_clr.val = I2S0.int_st.val;
+  }
+
+  // moves frames from the ring buffer into a DMA buffer, the last frame is held if the ring runs dry
+  IRAM_ATTR void StepWaveSinkI2S::fill(uint32_t *buffer) {
+    uint32_t frame;
+    for (int i = 0; i < STEP_WAVE_I2S_DMA_FRAMES; i++) {
+      if (ring->pop(&frame)) lastFrame = frame; else { underruns++; lastFrame = gpio.idleFrame(lastFrame); }
+      buffer[i] = lastFrame;
+    }
+  }
+#endif
+
+// -----------------------------------------------------------------------------------
+// memory sink
+
+bool StepWaveSinkMemory::drain() {
+  uint32_t frame;
+  bool taken = false;
+  while (count < size && ring->pop(&frame)) { buffer[count++] = frame; taken = true; }
+  return taken;
+}
+
+// -----------------------------------------------------------------------------------
+// planner
+
+bool StepWave::init() {
+  if (ready) return true;
+
+  framePeriod = lroundf(16000000.0F/GPIO_SSR74HC595_FRAME_RATE);
+  if (sink == NULL) sink = &stepWaveSink;
+
+  leadFrames = lroundf(STEP_WAVE_LEAD_MS*(GPIO_SSR74HC595_FRAME_RATE/1000.0F));
+  if (leadFrames < 1) leadFrames = 1;
+  // leaving room for the frames a full 74HC595 queue passes on early, up to two for each channel per frame period
+  if (leadFrames > STEP_WAVE_RING_SIZE - STEP_WAVE_CHANNELS_MAX*2) leadFrames = STEP_WAVE_RING_SIZE - STEP_WAVE_CHANNELS_MAX*2;
+
+  if (!sink->init(&ring, GPIO_SSR74HC595_FRAME_RATE)) return false;
+
+  VF("MSG: StepWave, step counts lead the outputs by up to ");
+  V(lroundf((leadFrames + sink->depth)*(1000.0F/GPIO_SSR74HC595_FRAME_RATE))); VLF("ms");
+
+  VF("MSG: StepWave, start planner task (rate 1ms priority 0)... ");
+  if (tasks.add(1, 0, true, 0, stepWavePollWrapper, "WavePln")) { VLF("success"); } else { VLF("FAILED!"); return false; }
+
+  // from here on writes to the 74HC595 are held for the next frame
+  gpio.setFrameOutput(stepWaveFrameOutputWrapper);
+  gpio.setFrameMode(true);
+
+  ready = true;
+  return true;
+}
+
+uint8_t StepWave::add(void (*volatile callback)()) {
+  if (channelCount >= STEP_WAVE_CHANNELS_MAX) return 0;
+  channel[channelCount].callback = callback;
+  channel[channelCount].period = 0;
+  channel[channelCount].phase = 0;
+  channelCount++;
+  return channelCount;
+}
+
+void StepWave::setCallback(uint8_t handle, void (*volatile callback)()) {
+  if (handle == 0 || handle > channelCount) return;
+  channel[handle - 1].callback = callback;
+}
+
+void StepWave::setPeriodSubMicros(uint8_t handle, unsigned long period) {
+  if (handle == 0 || handle > channelCount) return;
+  if (period != 0 && period < framePeriod*2) period = framePeriod*2;
+  channel[handle - 1].period = period;
+}
+
+void StepWave::setSink(StepWaveSink *sink) {
+  if (ready) return;
+  this->sink = sink;
+}
+
+void StepWave::poll() {
+  do {
+    // run each channel forward in time, one frame period at a time, up to the lead time (this includes any frames
+    // passed on early by a full 74HC595 queue)
+    while (ring.available() < leadFrames) {
+      for (uint8_t c = 0; c < channelCount; c++) {
+        StepWaveChannel *ch = &channel[c];
+        if (ch->period == 0) continue;
+        ch->phase += framePeriod;
+        if (ch->phase >= ch->period) {
+          ch->phase -= ch->period;
+          ch->callback();
+        }
+      }
+      ring.push(gpio.nextFrame());
+    }
+  } while (sink->drain());
+}
+
+StepWave stepWave;
+
+#endif
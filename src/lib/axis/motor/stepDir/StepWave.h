@@ -0,0 +1,184 @@
+// -----------------------------------------------------------------------------------
+// step waveform engine, precomputes 74HC595 frames for all step/dir axes and streams them out
+#pragma once
+
+#include "../../../../Common.h"
+
+#if defined(STEP_DIR_MOTOR_PRESENT) && GPIO_DEVICE == SSR74HC595 && GPIO_SSR74HC595_STREAM == ON
+
+#define STEP_WAVE_PRESENT
+
+#ifndef STEP_WAVE_RING_SIZE
+  #define STEP_WAVE_RING_SIZE 1024   // frames buffered ahead of the sink, must be a power of two
+#endif
+
+#ifndef STEP_WAVE_LEAD_MS
+  #define STEP_WAVE_LEAD_MS 10       // the planner runs at most this far ahead of the sink, step counts lead the
+                                     // outputs by this plus the frames buffered by the sink itself
+#endif
+
+#ifndef STEP_WAVE_CHANNELS_MAX
+  #define STEP_WAVE_CHANNELS_MAX 9
+#endif
+
+// lock-free ring buffer of frames, for a single producer (the planner) and a single consumer (the sink)
+class StepWaveRing {
+  public:
+    // number of frames waiting
+    inline uint16_t available() { return (uint16_t)(head - tail); }
+
+    // number of frames that can be added
+    inline uint16_t space() { return STEP_WAVE_RING_SIZE - available(); }
+
+    // add a frame, call only if there is space
+    inline void push(uint32_t frame) { buffer[head & (STEP_WAVE_RING_SIZE - 1)] = frame; head = head + 1; }
+
+    // get the next frame without removing it, false if empty
+    inline bool peek(uint32_t *frame) {
+      if (head == tail) return false;
+      *frame = buffer[tail & (STEP_WAVE_RING_SIZE - 1)];
+      return true;
+    }
+
+    // get a waiting frame without removing it, call only with index < available()
+    inline uint32_t at(uint16_t index) { return buffer[(uint16_t)(tail + index) & (STEP_WAVE_RING_SIZE - 1)]; }
+
+    // remove the next frame(s), call only with count <= available()
+    inline void drop(uint16_t count = 1) { tail = tail + count; }
+
+    // get and remove the next frame, false if empty
+    inline bool pop(uint32_t *frame) {
+      if (!peek(frame)) return false;
+      drop();
+      return true;
+    }
+
+  private:
+    volatile uint16_t head = 0;
+    volatile uint16_t tail = 0;
+    uint32_t buffer[STEP_WAVE_RING_SIZE];
+};
+
+// drains frames from the ring buffer to the outputs at a fixed rate
+class StepWaveSink {
+  public:
+    // prepare to output frames from the ring buffer at the rate given in Hz
+    virtual bool init(StepWaveRing *ring, float rate) = 0;
+
+    // moves frames from the ring buffer to the output (if the sink doesn't do this on its own)
+    // returns true if any frames were taken
+    virtual bool drain() = 0;
+
+    // count of frames the sink needed that weren't ready, the last frame is repeated with the pulse pins inactive
+    volatile unsigned long underruns = 0;
+
+    // frames buffered by the sink itself, past the ring buffer
+    unsigned long depth = 0;
+
+  protected:
+    StepWaveRing *ring = NULL;
+};
+
+// hardware timer sink, shifts out and latches one frame per timer tick
+class StepWaveSinkTimer : public StepWaveSink {
+  public:
+    bool init(StepWaveRing *ring, float rate);
+    inline bool drain() { return false; }
+
+    // output the next frame, called from the timer ISR
+    void play();
+
+  private:
+    uint32_t lastFrame = 0;
+};
+
+#ifdef ESP32
+  #include "rom/lldesc.h"
+
+  #ifndef STEP_WAVE_I2S_DMA_BUFFERS
+    #define STEP_WAVE_I2S_DMA_BUFFERS 4
+  #endif
+  #ifndef STEP_WAVE_I2S_DMA_FRAMES
+    #define STEP_WAVE_I2S_DMA_FRAMES 64
+  #endif
+  #if STEP_WAVE_I2S_DMA_FRAMES*4 > 4092
+    #error "StepWave, STEP_WAVE_I2S_DMA_FRAMES exceeds the DMA descriptor limit of 1023 frames"
+  #endif
+
+  // I2S sink, frames are clocked out to the 74HC595 by DMA with the word select signal as the latch
+  class StepWaveSinkI2S : public StepWaveSink {
+    public:
+      bool init(StepWaveRing *ring, float rate);
+      inline bool drain() { return false; }
+
+      // refills the DMA buffers that finished playing, called from the I2S ISR
+      void refill();
+
+    private:
+      // moves frames from the ring buffer into a DMA buffer, the last frame is held if the ring runs dry
+      void fill(uint32_t *buffer);
+
+      lldesc_t desc[STEP_WAVE_I2S_DMA_BUFFERS];
+      uint32_t buffer[STEP_WAVE_I2S_DMA_BUFFERS][STEP_WAVE_I2S_DMA_FRAMES];
+      uint8_t fillIndex = 0;
+      uint32_t lastFrame = 0;
+  };
+#endif
+
+// memory sink, captures frames into a buffer for comparison or analysis
+class StepWaveSinkMemory : public StepWaveSink {
+  public:
+    StepWaveSinkMemory(uint32_t *buffer, unsigned long size) { this->buffer = buffer; this->size = size; }
+    inline bool init(StepWaveRing *ring, float rate) { UNUSED(rate); this->ring = ring; return true; }
+    bool drain();
+
+    // number of frames captured
+    unsigned long count = 0;
+
+  private:
+    uint32_t *buffer;
+    unsigned long size;
+};
+
+typedef struct StepWaveChannel {
+  void (*volatile callback)();
+  unsigned long period;    // in sub-micros, 0 for idle
+  unsigned long phase;     // in sub-micros
+} StepWaveChannel;
+
+class StepWave {
+  public:
+    // starts the planner task and the sink, returns true if the engine is running
+    bool init();
+
+    // add a channel that runs callback at a period set later (like a motor timer would)
+    // returns a handle or 0 on failure
+    uint8_t add(void (*volatile callback)());
+
+    // change the channel callback
+    void setCallback(uint8_t handle, void (*volatile callback)());
+
+    // set channel period in sub-microseconds (1/16 microsecond units), use 0 for idle
+    // periods shorter than two frames are limited to two frames since a pulse needs a frame to return inactive
+    void setPeriodSubMicros(uint8_t handle, unsigned long period);
+
+    // use another sink, for capturing the waveform for instance
+    void setSink(StepWaveSink *sink);
+
+    // runs the channels ahead of time to fill the ring buffer with frames and passes them to the sink
+    void poll();
+
+    StepWaveRing ring;
+    StepWaveSink *sink = NULL;
+
+  private:
+    bool ready = false;
+    uint8_t channelCount = 0;
+    unsigned long framePeriod = 0;
+    uint16_t leadFrames = STEP_WAVE_RING_SIZE;
+    StepWaveChannel channel[STEP_WAVE_CHANNELS_MAX];
+};
+
+extern StepWave stepWave;
+
+#endif
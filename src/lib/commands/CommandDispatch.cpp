@@ -0,0 +1,50 @@
+// -----------------------------------------------------------------------------------
+// Command dispatch, routes commands to only the handlers registered for their first one or two characters
+
+#include "CommandDispatch.h"
+
+#define isRoutable(c) ((c) >= ' ' && (c) <= '~')
+
+bool CommandDispatch::add(const char *commands, CommandHandler handler) {
+  if (handlerCount >= COMMAND_HANDLERS_MAX) return false;
+
+  const char *c = commands;
+  while (*c != 0) {
+    if (*c == ' ') { c++; continue; }
+
+    char first = c[0];
+    char second = (c[1] != ' ') ? c[1] : 0;
+    c += (second != 0) ? 2 : 1;
+    if (!isRoutable(first)) continue;
+
+    if (second != 0 && isRoutable(second)) {
+      uint8_t letter = first - ' ';
+      if (routeLetter[letter] == 0 && routeLetterCount < COMMAND_ROUTED_LETTERS_MAX) routeLetter[letter] = ++routeLetterCount;
+
+      // with no row left for this letter fall back to taking all its commands, that's slower but still correct
+      if (routeLetter[letter] != 0) {
+        bitSet(routeSecond[routeLetter[letter] - 1][second - ' '], handlerCount);
+        continue;
+      }
+    }
+
+    bitSet(route[first - ' '], handlerCount);
+  }
+  this->handler[handlerCount++] = handler;
+  return true;
+}
+
+bool CommandDispatch::command(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError) {
+  if (!isRoutable(command[0])) return false;
+
+  uint8_t letter = command[0] - ' ';
+  uint32_t handlers = route[letter];
+  if (routeLetter[letter] != 0 && isRoutable(command[1])) handlers |= routeSecond[routeLetter[letter] - 1][command[1] - ' '];
+
+  while (handlers) {
+    uint8_t i = __builtin_ctzl(handlers);
+    if (handler[i](reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    handlers &= handlers - 1;
+  }
+  return false;
+}
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------
+// Command dispatch, routes commands to only the handlers registered for their first one or two characters
+#pragma once
+
+#include <Arduino.h>
+#include "CommandErrors.h"
+
+#define COMMAND_HANDLERS_MAX 32
+
+// first characters (like the 'G' and 'S' shared by most handlers) that can also route on the second character
+#define COMMAND_ROUTED_LETTERS_MAX 4
+
+typedef bool (*CommandHandler)(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError);
+
+class CommandDispatch {
+  public:
+    // registers a handler for the commands given as a space separated list of prefixes, a single character
+    // for all commands starting with it or two characters for just that command (i.e. "GR GD T" for :GR#, :GD#, and :T..#)
+    // handlers are tried in the order they were added, returns false if the table is full
+    bool add(const char *commands, CommandHandler handler);
+
+    // passes the command to each handler registered for it until one handles it
+    // returns true if the command was handled
+    bool command(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError);
+
+  private:
+    CommandHandler handler[COMMAND_HANDLERS_MAX];
+    uint8_t handlerCount = 0;
+
+    // bit for each handler that takes commands starting with this character (' ' to '~')
+    uint32_t route[95] = {};
+
+    // for first characters routed on the second character, the index + 1 of their row in routeSecond
+    uint8_t routeLetter[95] = {};
+    uint8_t routeLetterCount = 0;
+
+    // bit for each handler that takes commands starting with this pair of characters
+    uint32_t routeSecond[COMMAND_ROUTED_LETTERS_MAX][95] = {};
+};
@@ -411,3 +411,66 @@ void SerialWrapper::flush() {
   #endif
   UNUSED(channel);
 }
+
+#if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+  IPSerial *SerialWrapper::ipSerial() {
+    uint8_t channel = 0;
+    #ifdef SERIAL_A
+      channel++;
+    #endif
+    #ifdef SERIAL_B
+      channel++;
+    #endif
+    #ifdef SERIAL_C
+      channel++;
+    #endif
+    #ifdef SERIAL_D
+      channel++;
+    #endif
+    #ifdef SERIAL_ST4
+      channel++;
+    #endif
+    #ifdef SERIAL_BT
+      channel++;
+    #endif
+    #ifdef SERIAL_PIP1
+      if (isChannel(channel++)) return &SERIAL_PIP1;
+    #endif
+    #ifdef SERIAL_PIP2
+      if (isChannel(channel++)) return &SERIAL_PIP2;
+    #endif
+    #ifdef SERIAL_PIP3
+      if (isChannel(channel++)) return &SERIAL_PIP3;
+    #endif
+    #ifdef SERIAL_SIP
+      if (isChannel(channel++)) return &SERIAL_SIP;
+    #endif
+    UNUSED(channel);
+    return NULL;
+  }
+#endif
+
+uint8_t SerialWrapper::getClient() {
+  #if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+    IPSerial *port = ipSerial();
+    if (port != NULL) return port->getClient();
+  #endif
+  return 0;
+}
+
+void SerialWrapper::setClient(uint8_t client) {
+  #if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+    IPSerial *port = ipSerial();
+    if (port != NULL) port->setClient(client);
+  #endif
+  UNUSED(client);
+}
+
+uint8_t SerialWrapper::getConnection(uint8_t client) {
+  #if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+    IPSerial *port = ipSerial();
+    if (port != NULL) return port->getConnection(client);
+  #endif
+  UNUSED(client);
+  return 0;
+}
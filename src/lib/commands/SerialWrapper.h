@@ -39,6 +39,15 @@ class SerialWrapper : public Stream {
     inline size_t write(unsigned int n) { return write((uint8_t)n); }
     inline size_t write(int n) { return write((uint8_t)n); }
 
+    // the client the last command was read from, on channels that serve several at once (WiFi IP serial), otherwise 0
+    uint8_t getClient();
+
+    // sends writes to the given client, until the next command is read
+    void setClient(uint8_t client);
+
+    // a number that changes each time a new client takes the given client's place
+    uint8_t getConnection(uint8_t client);
+
     inline bool hasChannel(uint8_t channel) { return bitRead(_wrapper_channels, channel); }
     inline void setChannel(uint8_t channel) { bitSet(_wrapper_channels, channel); }
     inline void clrChannel(uint8_t channel) { bitClear(_wrapper_channels, channel); }
@@ -46,5 +55,10 @@ class SerialWrapper : public Stream {
     using Print::write;
 
   private:
+    #if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+      // the IP serial port for this channel, NULL for other kinds of channel
+      IPSerial *ipSerial();
+    #endif
+
     uint8_t thisChannel = 0;
 };
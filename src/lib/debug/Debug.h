@@ -6,6 +6,8 @@
 
 #if DEBUG == PROFILER
   #define TASKS_PROFILER_ENABLE
+#elif TASKS_PROFILER_STATS == ON
+  #define TASKS_PROFILER_STATS_ENABLE
 #endif
 
 #if defined(DEBUG) && DEBUG != OFF && DEBUG != PROFILER
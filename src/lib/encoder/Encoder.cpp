@@ -10,3 +10,8 @@ void Encoder::init() {
 void Encoder::setOrigin(uint32_t count) {
   origin = count;
 }
+
+// get current position from a timer interrupt, a 32 bit read is atomic so no need to disable interrupts
+IRAM_ATTR int32_t Encoder::readIsr() {
+  return *isrCount + origin + offset;
+}
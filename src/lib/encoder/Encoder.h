@@ -58,6 +58,10 @@ class Encoder {
     // get current position
     virtual int32_t read();
 
+    // get current position from a timer interrupt, for encoders that are isrSafe only
+    // this isn't virtual (the vtable is in flash on the ESP32) and leaves interrupts as they are
+    int32_t readIsr();
+
     // set current position to value
     virtual void write(int32_t count);
 
@@ -70,6 +74,9 @@ class Encoder {
     // true if issues with operation were detected
     bool warn = false;
 
+    // true if readIsr() can be called from a timer interrupt
+    bool isrSafe = false;
+
     // index offset (r/w)
     int32_t offset = 0;
 
@@ -79,6 +86,9 @@ class Encoder {
     int32_t count = 0;
 
   protected:
+    // the count readIsr() returns (plus origin and offset,) set along with isrSafe
+    volatile int32_t *isrCount = NULL;
+
     bool initialized = false;
 
     int16_t axis = 0;
@@ -4,13 +4,42 @@
 
 #ifdef HAS_BISS_C
 
+#if BISSC_SPI == ON
+  #include <SPI.h>
+
+  #ifdef ESP32
+    // a bus of our own so the pins can be routed to whichever encoder is being read
+    SPIClass bisscSPI(HSPI);
+    int16_t bisscSpiMaPin = OFF;
+  #else
+    #define bisscSPI SPI
+  #endif
+#endif
+
+// BiSS-C 6-bit CRC table (x^6 + x^1 + 1)
+const uint8_t bisscCrc6Table[64] = {
+  0x00, 0x03, 0x06, 0x05, 0x0C, 0x0F, 0x0A, 0x09,
+  0x18, 0x1B, 0x1E, 0x1D, 0x14, 0x17, 0x12, 0x11,
+  0x30, 0x33, 0x36, 0x35, 0x3C, 0x3F, 0x3A, 0x39,
+  0x28, 0x2B, 0x2E, 0x2D, 0x24, 0x27, 0x22, 0x21,
+  0x23, 0x20, 0x25, 0x26, 0x2F, 0x2C, 0x29, 0x2A,
+  0x3B, 0x38, 0x3D, 0x3E, 0x37, 0x34, 0x31, 0x32,
+  0x13, 0x10, 0x15, 0x16, 0x1F, 0x1C, 0x19, 0x1A,
+  0x0B, 0x08, 0x0D, 0x0E, 0x07, 0x04, 0x01, 0x02};
+
 // get device ready for use
 void Bissc::init() {
   if (initialized) { VF("WRN: Encoder BiSS-C"); V(axis); VLF(" init(), already initialized!"); return; }
 
-  pinMode(maPin, OUTPUT);
-  digitalWriteF(maPin, LOW);
-  pinMode(sloPin, INPUT_PULLUP);
+  #if BISSC_SPI == ON
+    #ifndef ESP32
+      bisscSPI.begin();
+    #endif
+  #else
+    pinMode(maPin, OUTPUT);
+    digitalWriteF(maPin, LOW);
+    pinMode(sloPin, INPUT_PULLUP);
+  #endif
 
   initialized = true;
 }
@@ -56,6 +85,145 @@ void Bissc::write(int32_t count) {
   }
 }
 
+// clock in a frame and decode it, checks Ack, Start, Cds, Err and the CRC
+bool Bissc::readFrame(uint32_t &turns, uint32_t &position) {
+  // Ack, Start, Cds, data, Err, Wrn, CRC
+  uint8_t frame[(BISSC_LATENCY_BITS + 1 + 32 + 32 + 2 + 6 + 7)/8];
+  uint8_t bytes = (BISSC_LATENCY_BITS + 1 + turnBits + positionBits + 2 + 6 + 7)/8;
+
+  readBits(frame, bytes);
+
+  int16_t errors = decode(frame, bytes*8, turns, position);
+  if (errors > 0) {
+    if (errors <= 2) warn = true; else error = true;
+    return false;
+  }
+  return true;
+}
+
+// clock in a frame of raw SLO bits, MSB first
+IRAM_ATTR void Bissc::readBits(uint8_t *frame, uint8_t bytes) {
+  #if BISSC_SPI == ON
+    #ifdef ESP32
+      if (bisscSpiMaPin != maPin) {
+        if (bisscSpiMaPin != OFF) {
+          bisscSPI.end();
+          pinMode(bisscSpiMaPin, OUTPUT);
+          digitalWriteF(bisscSpiMaPin, HIGH);
+        }
+        bisscSPI.begin(maPin, sloPin, -1, -1);
+        bisscSpiMaPin = maPin;
+      }
+    #endif
+
+    // MA idles high and SLO is sampled on the falling edge, MOSI is unused
+    memset(frame, 0xFF, bytes);
+    bisscSPI.beginTransaction(SPISettings(BISSC_CLOCK_RATE_KHZ*1000UL, MSBFIRST, SPI_MODE2));
+    bisscSPI.transfer(frame, bytes);
+    bisscSPI.endTransaction();
+  #else
+    // bit delay in nanoseconds
+    int rate = lround(500000.0/BISSC_CLOCK_RATE_KHZ);
+
+    #ifdef ESP32
+      portMUX_TYPE bisscMutex = portMUX_INITIALIZER_UNLOCKED;
+      taskENTER_CRITICAL(&bisscMutex);
+    #elif defined(__TEENSYDUINO__)
+      noInterrupts();
+    #endif
+
+    for (int i = 0; i < bytes; i++) {
+      uint8_t b = 0;
+      for (int j = 0; j < 8; j++) {
+        digitalWriteF(maPin, LOW);
+        b = (b << 1) | (digitalReadF(sloPin) == HIGH);
+        delayNanoseconds(rate);
+        digitalWriteF(maPin, HIGH);
+        delayNanoseconds(rate);
+      }
+      frame[i] = b;
+    }
+
+    // send a CDM (invert)
+    digitalWriteF(maPin, LOW);
+    delayNanoseconds(rate*4);
+    digitalWriteF(maPin, HIGH);
+
+    #ifdef ESP32
+      taskEXIT_CRITICAL(&bisscMutex);
+    #elif defined(__TEENSYDUINO__)
+      interrupts();
+    #endif
+  #endif
+}
+
+#define bisscBit(i) ((frame[(i) >> 3] >> (7 - ((i) & 7))) & 1)
+
+// decode a frame of raw SLO bits, returns the number of errors found
+int16_t Bissc::decode(const uint8_t *frame, uint16_t bits, uint32_t &turns, uint32_t &position) {
+  uint16_t i = 0;
+  turns = 0;
+  position = 0;
+
+  // Ack is SLO going low, then Start is SLO going high, followed by a low Cds bit
+  while (i < BISSC_LATENCY_BITS && bisscBit(i)) i++;
+  bool foundAck = i < BISSC_LATENCY_BITS;
+  while (i < BISSC_LATENCY_BITS && !bisscBit(i)) i++;
+  bool foundStart = foundAck && i < BISSC_LATENCY_BITS;
+  i++;
+  bool foundCds = foundStart && !bisscBit(i);
+  i++;
+
+  uint8_t  encErr = 0;
+  uint8_t  encWrn = 0;
+  uint8_t  encCrc = 0;
+  uint64_t encData = 0;
+
+  if (foundCds && i + turnBits + positionBits + 2 + 6 <= bits) {
+    if (turnsFirst) {
+      for (int j = 0; j < turnBits; j++, i++) turns = (turns << 1) | bisscBit(i);
+      for (int j = 0; j < positionBits; j++, i++) position = (position << 1) | bisscBit(i);
+      encData = ((uint64_t)turns << positionBits) | position;
+    } else {
+      for (int j = 0; j < positionBits; j++, i++) position = (position << 1) | bisscBit(i);
+      for (int j = 0; j < turnBits; j++, i++) turns = (turns << 1) | bisscBit(i);
+      encData = ((uint64_t)position << turnBits) | turns;
+    }
+    encErr = bisscBit(i); i++;
+    encWrn = bisscBit(i); i++;
+    for (int j = 0; j < 6; j++, i++) encCrc = (encCrc << 1) | bisscBit(i);
+
+    encData = (encData << 1) | encErr;
+    encData = (encData << 1) | encWrn;
+  } else foundCds = false;
+
+  int16_t errors = 0;
+  if (foundCds && crcCheck && crc6(encData, turnBits + positionBits + 2) != encCrc) {
+    bad++;
+    VF("WRN: Encoder "); V(name); V(axis); VF(", Crc invalid (overall "); V(((float)bad/good)*100.0F); V('%'); VLF(")"); errors++;
+  } else {
+    good++;
+    if (!foundAck) { VF("WRN: Encoder "); V(name); V(axis); VLF(", Ack bit invalid"); errors++; } else
+    if (!foundStart) { VF("WRN: Encoder "); V(name); V(axis); VLF(", Start bit invalid"); errors++; } else
+    if (!foundCds) { VF("WRN: Encoder "); V(name); V(axis); VLF(", Cds bit invalid"); errors++; } else
+    if (encErr) { VF("WRN: Encoder "); V(name); V(axis); VLF(", Error bit set"); errors++; }
+  }
+
+  return errors;
+}
+
+// Designed according protocol description found in as38-H39e-b-an100.pdf and
+// Renishaw application note E201D02_02
+
+// BiSS-C 6-bit CRC (x^6 + x^1 + 1) of the low order bits of data
+uint8_t Bissc::crc6(uint64_t data, uint8_t bits) {
+  // the leading partial group first, then six bits at a time
+  int shift = bits - (bits % 6 == 0 ? 6 : bits % 6);
+  uint8_t idx = (data >> shift) & 0b111111;
+  for (shift -= 6; shift >= 0; shift -= 6) idx = ((data >> shift) & 0b111111) ^ bisscCrc6Table[idx];
+  return ~bisscCrc6Table[idx] & 0b111111;
+}
+
 // read encoder count with (1 second) error recovery
 bool Bissc::readEncLatest(uint32_t &position) {
   uint32_t temp = position;
@@ -17,6 +17,15 @@
     #define BISSC_SINGLE_TURN ON
   #endif
 
+  // ON to clock frames with the hardware SPI bus (MA on SCK, SLO on MISO) so interrupts stay enabled
+  // OFF to bit-bang MA/SLO on any pins with interrupts disabled for the frame
+  #ifndef BISSC_SPI
+    #define BISSC_SPI OFF
+  #endif
+
+  // clocks allowed for the Ack and Start bits to arrive
+  #define BISSC_LATENCY_BITS 16
+
   class Bissc : public Encoder {
     public:
       // get device ready for use
@@ -38,6 +47,29 @@
       // read encoder position
       virtual bool readEnc(uint32_t &position);
 
+      // clock in a frame and decode it, checks Ack, Start, Cds, Err and the CRC
+      bool readFrame(uint32_t &turns, uint32_t &position);
+
+      // clock in a frame of raw SLO bits, MSB first
+      void readBits(uint8_t *frame, uint8_t bytes);
+
+      // decode a frame of raw SLO bits, returns the number of errors found
+      int16_t decode(const uint8_t *frame, uint16_t bits, uint32_t &turns, uint32_t &position);
+
+      // BiSS-C 6-bit CRC (x^6 + x^1 + 1) of the low order bits of data
+      static uint8_t crc6(uint64_t data, uint8_t bits);
+
+      // frame layout, multi-turn bits are sent first followed by the position bits unless turnsFirst is false
+      uint8_t turnBits = 0;
+      uint8_t positionBits = 0;
+      bool turnsFirst = true;
+
+      // false to skip the CRC check
+      bool crcCheck = true;
+
+      // name for messages
+      const char *name = "";
+
       uint32_t good = 0;
       uint32_t bad = 0;
       int16_t axis;
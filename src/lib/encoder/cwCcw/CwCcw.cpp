@@ -59,6 +59,8 @@ CwCcw::CwCcw(int16_t cwPin, int16_t ccwPin, int16_t axis) {
   this->cwPin = cwPin;
   this->ccwPin = ccwPin;
   this->axis = axis - 1;
+  isrCount = &_cw_ccw_count[this->axis];
+  isrSafe = true;
 }
 
 void CwCCW::init() {
@@ -50,6 +50,8 @@ PulseDir::PulseDir(int16_t pulsePin, int16_t dirPin, int16_t axis) {
   this->pulsePin = pulsePin;
   this->dirPin = dirPin;
   this->axis = axis - 1;
+  isrCount = &_pulse_dir_count[this->axis];
+  isrSafe = true;
 }
 
 void PulseDir::init() {
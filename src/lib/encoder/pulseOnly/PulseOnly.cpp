@@ -51,6 +51,8 @@ PulseOnly::PulseOnly(int16_t pulsePin, int16_t *direction, int16_t axis) {
   this->pulsePin = pulsePin;
   this->axis = axis - 1;
   _direction[this->axis] = direction;
+  isrCount = &_pulse_count[this->axis];
+  isrSafe = true;
 }
 
 void PulseOnly::init() {
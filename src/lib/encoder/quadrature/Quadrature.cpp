@@ -63,6 +63,8 @@ Quadrature::Quadrature(int16_t APin, int16_t BPin, int16_t axis) {
   this->BPin = BPin;
   this->axis = axis;
   quadratureInstance[this->axis - 1] = this;
+  isrCount = &count;
+  isrSafe = true;
 }
 
 void Quadrature::init() {
@@ -161,60 +163,32 @@ void Quadrature::write(int32_t count) {
 // Phase 2: LHHL LHHL
 // ...00 01 11 10 00 01 11 10 00 01 11 10...
 
+// edge decode table indexed by state A, state B, last A, last B, replaces the switch with one lookup per edge
+// low two bits hold dir + 1, skipped pulses keep the last dir (warn) or are way too fast if this is happening (error)
+// edge() still tests the warn flag to decide if dir changes
+#define QE_WARN  0b0100
+#define QE_ERROR 0b1000
+static const uint8_t quadratureEdge[16] = {
+  1|QE_ERROR, 0, 2, QE_WARN, 2, 1|QE_ERROR, QE_WARN, 0, 0, QE_WARN, 1|QE_ERROR, 2, QE_WARN, 2, 0, 1|QE_ERROR
+};
+
 ICACHE_RAM_ATTR void Quadrature::A(const int16_t pin) {
   stateA = digitalReadF(pin);
-
-  uint8_t v = stateA*8 + stateB*4 + lastA*2 + lastB;
-  static int16_t dir;
-  switch (v) {
-    case 0b0000: dir = 0; error = true; break; // skipped pulse use last dir (way too fast if this is happening)
-    case 0b0001: dir = -1; break;
-    case 0b0010: dir = 1; break;
-    case 0b0011: warn = true; break;           // skipped pulse use last dir
-    case 0b0100: dir = 1; break;
-    case 0b0101: dir = 0; error = true; break; // skipped pulse use last dir (way too fast if this is happening)
-    case 0b0110: warn = true; break;           // skipped pulse use last dir
-    case 0b0111: dir = -1; break;
-    case 0b1000: dir = -1; break;
-    case 0b1001: warn = true; break;           // skipped pulse use last dir
-    case 0b1010: dir = 0; error = true; break; // skipped pulse use last dir (way too fast if this is happening)
-    case 0b1011: dir = 1; break;
-    case 0b1100: warn = true; break;           // skipped pulse use last dir
-    case 0b1101: dir = 1; break;
-    case 0b1110: dir = -1; break;
-    case 0b1111: dir = 0; error = true; break; // skipped pulse use last dir (way too fast if this is happening)
-  }
-  count += dir;
-  
-  lastA = stateA;
-  lastB = stateB;
+  edge();
 }
 
 ICACHE_RAM_ATTR void Quadrature::B(const int16_t pin) {
   stateB = digitalReadF(pin);
+  edge();
+}
 
-  uint8_t v = stateA*8 + stateB*4 + lastA*2 + lastB;
-  static int16_t dir;
-  switch (v) {
-    case 0b0000: dir = 0; error = true; break;
-    case 0b0001: dir = -1; break;
-    case 0b0010: dir = 1; break;
-    case 0b0011: warn = true; break;
-    case 0b0100: dir = 1; break;
-    case 0b0101: dir = 0; error = true; break;
-    case 0b0110: warn = true; break;
-    case 0b0111: dir = -1; break;
-    case 0b1000: dir = -1; break;
-    case 0b1001: warn = true; break;
-    case 0b1010: dir = 0; error = true; break;
-    case 0b1011: dir = 1; break;
-    case 0b1100: warn = true; break;
-    case 0b1101: dir = 1; break;
-    case 0b1110: dir = -1; break;
-    case 0b1111: dir = 0; error = true; break;
-  }
+ICACHE_RAM_ATTR void Quadrature::edge() {
+  const uint8_t e = quadratureEdge[(stateA << 3) | (stateB << 2) | (lastA << 1) | lastB];
+  if (!(e & QE_WARN)) dir = (int8_t)(e & 0b11) - 1;
+  warn |= (e & QE_WARN) != 0;
+  error |= (e & QE_ERROR) != 0;
   count += dir;
-  
+
   lastA = stateA;
   lastB = stateB;
 }
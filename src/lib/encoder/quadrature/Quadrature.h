@@ -35,6 +35,10 @@ class Quadrature : public Encoder {
     volatile int16_t stateB;
     volatile int16_t lastA;
     volatile int16_t lastB;
+    volatile int8_t dir = 0;
+
+    // decode the A/B states on any edge
+    void edge();
 };
 
 #endif
@@ -6,7 +6,7 @@
      AXIS4_ENCODER == SERIAL_BRIDGE || AXIS5_ENCODER == SERIAL_BRIDGE || AXIS6_ENCODER == SERIAL_BRIDGE || \
      AXIS7_ENCODER == SERIAL_BRIDGE || AXIS8_ENCODER == SERIAL_BRIDGE || AXIS9_ENCODER == SERIAL_BRIDGE) && defined(SERIAL_ENCODER)
 
-bool _serial_bridge_initialized = false;
+#include "../../tasks/OnTask.h"
 
 #if SERIAL_ENCODER == HardSerial
   #undef SERIAL_ENCODER
@@ -15,22 +15,154 @@ bool _serial_bridge_initialized = false;
   #define SERIAL_ENCODER_RXTX_SET
 #endif
 
+void serialBridgeWrapper() { serialBridgePort.poll(); }
+
+// start the serial port and poll task, once
+void SerialBridgePort::init() {
+  if (initialized) return;
+
+  #if defined(SERIAL_ENCODER_RX) && defined(SERIAL_ENCODER_TX) && !defined(SERIAL_ENCODER_RXTX_SET)
+    SERIAL_ENCODER.begin(SERIAL_ENCODER_BAUD, SERIAL_8N1, SERIAL_ENCODER_RX, SERIAL_ENCODER_TX);
+  #else
+    SERIAL_ENCODER.begin(SERIAL_ENCODER_BAUD);
+  #endif
+  delay(100);
+  while (SERIAL_ENCODER.available()) SERIAL_ENCODER.read();
+
+  VF("MSG: Encoder SerialBridge, start poll task (rate 1ms priority 1)... ");
+  if (tasks.add(1, 0, true, 1, serialBridgeWrapper, "EncBrdg")) { VLF("success"); } else { VLF("FAILED!"); }
+
+  initialized = true;
+}
+
+// add a channel (1 to 9) to those sampled
+void SerialBridgePort::begin(uint8_t channel) {
+  if (channel < 1 || channel > 9) return;
+  channels |= 1 << (channel - 1);
+}
+
+// read replies, expire stale requests, and send new ones
+void SerialBridgePort::poll() {
+  int available = SERIAL_ENCODER.available();
+  while (available-- > 0) {
+    uint8_t c = SERIAL_ENCODER.read();
+
+    #if SERIAL_ENCODER_BINARY == ON
+      if (frameIndex == 0 && c != SERIAL_BRIDGE_FRAME_SYNC) continue;
+      frame[frameIndex++] = c;
+      if (frameIndex == SERIAL_BRIDGE_FRAME_SIZE) {
+        frameIndex = 0;
+        uint8_t checksum = 0;
+        for (int i = 0; i < SERIAL_BRIDGE_FRAME_SIZE - 1; i++) checksum += frame[i];
+        if (checksum == frame[SERIAL_BRIDGE_FRAME_SIZE - 1] && frame[1] >= 1 && frame[1] <= 9) {
+          reply(frame[1], (int32_t)((uint32_t)frame[2] | ((uint32_t)frame[3] << 8) | ((uint32_t)frame[4] << 16) | ((uint32_t)frame[5] << 24)));
+        }
+      }
+    #else
+      if (c >= '0' && c <= '9') {
+        if (digits < 10) { value = (int32_t)((uint32_t)value*10 + (c - '0')); digits++; }
+      } else
+      if (c == '-') negative = true; else
+      if (c == 13 && queueCount > 0) {
+        // replies arrive in the order requested
+        if (digits > 0) reply(queue[queueHead], negative ? -value : value); else {
+          timedOut |= 1 << (queue[queueHead] - 1);
+          pending &= ~(1 << (queue[queueHead] - 1));
+          queueHead = (queueHead + 1) % 9;
+          queueCount--;
+        }
+        value = 0;
+        negative = false;
+        digits = 0;
+      }
+    #endif
+  }
+
+  for (uint8_t channel = 1; channel <= 9; channel++) {
+    if ((pending & (1 << (channel - 1))) && millis() - requestTimeMs[channel - 1] > SERIAL_ENCODER_TIMEOUT_MS) {
+      VLF("WRN: SerialBridge poll(), timed out!");
+      reset();
+      break;
+    }
+  }
+
+  // ASCII replies aren't tagged with their channel so a burst of requests goes out only once the last is answered,
+  // otherwise a lost reply would shift every count that follows onto the wrong channel
+  #if SERIAL_ENCODER_BINARY != ON
+    if (queueCount > 0) return;
+  #endif
+
+  uint16_t due = channels & ~pending;
+  if (due == 0) return;
+
+  for (uint8_t channel = 1; channel <= 9; channel++) {
+    if (!(due & (1 << (channel - 1)))) continue;
+    #if SERIAL_ENCODER_BINARY == ON
+      SERIAL_ENCODER.write((uint8_t)(0x80 | channel));
+    #else
+      SERIAL_ENCODER.write((uint8_t)('0' + channel));
+    #endif
+    requestTimeMs[channel - 1] = millis();
+    queue[(queueHead + queueCount) % 9] = channel;
+    queueCount++;
+    pending |= 1 << (channel - 1);
+  }
+}
+
+void SerialBridgePort::reply(uint8_t channel, int32_t count) {
+  uint16_t bit = 1 << (channel - 1);
+  if (!(pending & bit)) return;
+
+  sample[channel - 1] = count;
+  sampleTimeMs[channel - 1] = millis();
+  sampled |= bit;
+  timedOut &= ~bit;
+  pending &= ~bit;
+  samples++;
+
+  queueHead = (queueHead + 1) % 9;
+  queueCount--;
+}
+
+// drop the requests in flight and any partial reply
+void SerialBridgePort::reset() {
+  timedOut |= pending;
+  timeouts += queueCount;
+  pending = 0;
+  queueHead = 0;
+  queueCount = 0;
+
+  frameIndex = 0;
+  value = 0;
+  negative = false;
+  digits = 0;
+  while (SERIAL_ENCODER.available()) SERIAL_ENCODER.read();
+}
+
+SerialBridgePort serialBridgePort;
+
 SerialBridge::SerialBridge(int16_t axis) {
   if (axis < 1 || axis > 9) return;
   initialized = true;
-  
+
   this->axis = axis;
-  axis--;
-  this->channel[0] = '1' + axis;
+  channel = axis;
+  ready = false;
+  isrCount = &serialBridgePort.sample[channel - 1];
+  isrSafe = true;
+}
+
+void SerialBridge::init() {
+  if (!initialized) { VF("WRN: Encoder SerialBridge"); V(axis); VLF(" init(), not initialized!"); return; }
+
+  serialBridgePort.init();
+  serialBridgePort.begin(channel);
 }
 
 int32_t SerialBridge::read() {
   if (!initialized) { VF("WRN: Encoder SerialBridge"); V(axis); VLF(" read(), not initialized!"); return 0; }
 
-  if (millis() - lastReadMillis > 10) {
-    count = raw();
-    lastReadMillis = millis();
-  }
+  count = raw();
 
   return count + offset;
 }
@@ -41,38 +173,18 @@ void SerialBridge::write(int32_t count) {
   offset = count - raw();
 }
 
+// milliseconds since the count served by read() arrived
+unsigned long SerialBridge::age() {
+  return millis() - serialBridgePort.sampleTimeMs[channel - 1];
+}
+
+// latest sample for this channel, the bridge poll task keeps it fresh
 int32_t SerialBridge::raw() {
-  if (!_serial_bridge_initialized) {
-    #if defined(SERIAL_ENCODER_RX) && defined(SERIAL_ENCODER_TX) && !defined(SERIAL_ENCODER_RXTX_SET)
-      SERIAL_ENCODER.begin(SERIAL_ENCODER_BAUD, SERIAL_8N1, SERIAL_ENCODER_RX, SERIAL_ENCODER_TX);
-    #else
-      SERIAL_ENCODER.begin(SERIAL_ENCODER_BAUD);
-    #endif
-    delay(100);
-    _serial_bridge_initialized = true;
-  }
+  uint16_t bit = 1 << (channel - 1);
+  ready = (serialBridgePort.sampled & bit) != 0;
+  if (serialBridgePort.timedOut & bit) error = true;
 
-  SERIAL_ENCODER.print(channel);
-  
-  char c;
-  char result[32] = "";
-  int index = 0;
-  unsigned long start = millis();
-  do {
-    if (SERIAL_ENCODER.available()) c = SERIAL_ENCODER.read(); else c = 'x';
-    if ((c >= '0' && c <= '9') || c == '-') {
-      result[index++] = c;
-      result[index] = 0;
-    }
-  } while (c != 13 && (millis() - start) < 4 && index < 16);
-
-  if (strlen(result) > 0) {
-    return atoi(result) + origin;
-  } else {
-    VLF("WRN: SerialBridge raw(), timed out!");
-    error = true;
-    return 0  + origin;
-  }
-} 
+  return serialBridgePort.sample[channel - 1] + origin;
+}
 
 #endif
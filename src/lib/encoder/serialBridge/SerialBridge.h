@@ -11,19 +11,83 @@
   #define SERIAL_ENCODER_BAUD 460800
 #endif
 
+// wait this long for a reply before dropping the requests in flight
+#ifndef SERIAL_ENCODER_TIMEOUT_MS
+  #define SERIAL_ENCODER_TIMEOUT_MS 4
+#endif
+
+// OFF for ASCII requests "1" to "9" answered by the count then CR
+// ON for binary requests 0x81 to 0x89 answered by a 7 byte frame: 0xA5, channel (1 to 9), count (int32 LE), checksum
+// where the checksum is the low byte of the sum of the prior six bytes
+#ifndef SERIAL_ENCODER_BINARY
+  #define SERIAL_ENCODER_BINARY OFF
+#endif
+
+#define SERIAL_BRIDGE_FRAME_SYNC 0xA5
+#define SERIAL_BRIDGE_FRAME_SIZE 7
+
+// request/response engine shared by all channels on the bridge serial port
+// keeps one request in flight per channel and parses replies as they arrive from a poll task
+// in ASCII mode requests go out as a burst for all channels, in binary mode each channel is asked again once answered
+class SerialBridgePort {
+  public:
+    // start the serial port and poll task, once
+    void init();
+
+    // add a channel (1 to 9) to those sampled
+    void begin(uint8_t channel);
+
+    // read replies, expire stale requests, and send new ones
+    void poll();
+
+    // latest sample and time it arrived for each channel
+    volatile int32_t sample[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    volatile unsigned long sampleTimeMs[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    uint16_t sampled = 0;     // bit mask of channels that have a sample
+    uint16_t timedOut = 0;    // bit mask of channels that timed out
+    uint32_t samples = 0;     // replies received
+    uint32_t timeouts = 0;    // requests dropped
+
+  private:
+    void reply(uint8_t channel, int32_t count);
+    void reset();
+
+    bool initialized = false;
+
+    uint16_t channels = 0;    // bit mask of channels to sample
+    uint16_t pending = 0;     // bit mask of channels with a request in flight
+
+    // channels in the order requested, replies come back in this order in ASCII mode
+    uint8_t queue[9];
+    uint8_t queueHead = 0;
+    uint8_t queueCount = 0;
+    unsigned long requestTimeMs[9];
+
+    // incremental reply parser
+    uint8_t frame[SERIAL_BRIDGE_FRAME_SIZE];
+    uint8_t frameIndex = 0;
+    int32_t value = 0;
+    bool negative = false;
+    uint8_t digits = 0;
+};
+
+extern SerialBridgePort serialBridgePort;
+
 class SerialBridge : public Encoder {
   public:
     SerialBridge(int16_t axis);
+    void init();
     int32_t read();
     void write(int32_t count);
 
+    // milliseconds since the count served by read() arrived
+    unsigned long age();
+
   private:
     int32_t raw();
 
-    int32_t offset = 0;
-
-    char channel[2] = "0";
-    unsigned long lastReadMillis = 0;
+    uint8_t channel = 1;
 };
 
 #endif
@@ -4,6 +4,10 @@
 #include "WebServer.h"
 #include "../../tasks/OnTask.h"
 
+#ifdef ESP32
+  #include "esp_heap_caps.h"
+#endif
+
 #if (OPERATIONAL_MODE == ETHERNET_W5100 || OPERATIONAL_MODE == ETHERNET_W5500) && WEB_SERVER == ON
 
   void WebServer::begin(long port, long timeToClose, bool autoReset) {
@@ -29,8 +33,11 @@
       WLF("--------------------------------------------------");
       WF("MSG: Webserver, new client socket "); WL(client.getSocketNumber());
 
+      unsigned long startTimeMs = millis();
       parameter_count = 0;
-      String line = "";
+      arenaLength = 0;
+      contentLength = 0;
+      int lineLength = 0;
       int currentSection = 1;
       int handler_number = -1;
       lastMethod = HTTP_UNKNOWN;
@@ -42,38 +49,36 @@
           char c = client.read(); if (c == '\r') continue;
 
           // build up ea. line
-          if (line.length() <= 1024) line += c;
+          if (lineLength < WEB_LINE_SIZE - 1) line[lineLength++] = c;
+          line[lineLength] = 0;
 
           // loop until an entire line is present
           if (c != '\n' && client.available()) continue;
 
           // look for end of sections
-          if (line.equals("\n")) { line = ""; currentSection++; continue; }
+          if (strcmp(line, "\n") == 0) { lineLength = 0; currentSection++; continue; }
 
           // scan the header
           if (currentSection == 1) {
-            if (!modifiedSinceFound && line.indexOf("If-Modified-Since:") >= 0) modifiedSinceFound = true;
+            if (!modifiedSinceFound && strstr(line, "If-Modified-Since:") != NULL) modifiedSinceFound = true;
             if (lastMethod == HTTP_UNKNOWN) {
-              int index = line.indexOf("GET ");
-              if (index >= 0) {
+              char *s = strstr(line, "GET ");
+              if (s != NULL) {
                 lastMethod = HTTP_GET;
-                line = line.substring(index + 4);
-                handler_number = getHandler(&line);
-                if (handler_number >= 0) processGet(&line);
+                handler_number = getHandler(s + 4);
+                if (handler_number >= 0) processParameters(s + 4, true);
                 break;
               } else {
-                index = line.indexOf("POST ");
-                if (index >= 0) {
+                s = strstr(line, "POST ");
+                if (s != NULL) {
                   lastMethod = HTTP_POST;
-                  line = line.substring(index + 5);
-                  handler_number = getHandler(&line);
+                  handler_number = getHandler(s + 5);
                 } else {
-                  index = line.indexOf("PUT ");
-                  if (index >= 0) {
+                  s = strstr(line, "PUT ");
+                  if (s != NULL) {
                     lastMethod = HTTP_PUT;
-                    line = line.substring(index + 4);
-                    handler_number = getHandler(&line);
-                    if (handler_number >= 0) processPut(&line);
+                    handler_number = getHandler(s + 4);
+                    if (handler_number >= 0) processParameters(s + 4, true);
                   }
                 }
               }
@@ -82,11 +87,11 @@
 
           // scan the request
           if (currentSection == 2 && handler_number >= 0) {
-            if (lastMethod == HTTP_PUT) processPut(&line); else
-            if (lastMethod == HTTP_POST) processPost(&line);
+            if (lastMethod == HTTP_PUT) processParameters(line, true); else
+            if (lastMethod == HTTP_POST) processParameters(line, false);
           }
 
-          line = "";
+          lineLength = 0;
         }
         Y;
       }
@@ -107,6 +112,12 @@
         (*notFoundHandler)();
       }
 
+      flushContent();
+
+      requests++;
+      unsigned long requestTimeMs = millis() - startTimeMs;
+      if (requestTimeMs > requestTimeMaxMs) requestTimeMaxMs = requestTimeMs;
+
       // port timeout to close
       tasks.yield(timeToClose);
 
@@ -125,25 +136,34 @@
     }
   }
 
-  int WebServer::getHandler(String* line) {
-    int url_end = line->indexOf("HTTP/");
-    if (url_end <= 0) return -1;
+  int WebServer::getHandler(char *line) {
+    char *url_end = strstr(line, "HTTP/");
+    if (url_end == NULL || url_end == line) return -1;
 
     WF("MSG: Webserver, checking handler for ");
 
-    // isolate the content
-    *line = line->substring(0, url_end);
-    int url_start = 0;
-    int url_end2 = line->lastIndexOf('?');
-    if (url_end2 > 0) url_end = url_end2;
-    requestedHandler = line->substring(url_start, url_end);
-    *line = line->substring(url_end);
-    requestedHandler.trim();
-    if (requestedHandler.length() == 0) requestedHandler = "/";
+    // isolate the content, the url ends at the last '?' if there are parameters
+    while (url_end > line && url_end[-1] == ' ') url_end--;
+    *url_end = 0;
+    char *parameters = strrchr(line, '?');
+    if (parameters == NULL || parameters == line) parameters = url_end;
+
+    // trimmed
+    char *url_start = line;
+    while (url_start < parameters && *url_start == ' ') url_start++;
+    int count = parameters - url_start;
+    while (count > 0 && url_start[count - 1] == ' ') count--;
+    if (count > WEB_URI_SIZE - 1) count = WEB_URI_SIZE - 1;
+    memcpy(requestedHandler, url_start, count);
+    requestedHandler[count] = 0;
+    if (count == 0) strcpy(requestedHandler, "/");
+
+    // leave just the parameters in line
+    memmove(line, parameters, strlen(parameters) + 1);
     WF("["); W(requestedHandler); WL("]");
 
     for (int i = 0; i < handler_count; i++) {
-      if (requestedHandler.equals(handlers_fn[i])) {
+      if (strcmp(requestedHandler, handlers_fn[i]) == 0) {
         WF("MSG: Webserver, found handler# "); WL(i);
         return i;
       }
@@ -151,97 +171,40 @@
     return -1;
   }
 
-  void WebServer::processGet(String* line) {
-    WLF("MSG: Webserver, checking header GET parameters");
-
-    if (line->equals(EmptyStr)) { WLF("MSG: Webserver, GET empty"); return; }
-
-    // isolate any parameters, get their values
-    // look for form "?a=1&" or "&a=1"
-    while ((*line)[0] == '?' || (*line)[0] == '&') {
-      *line = line->substring(1);
-      int j  = line->indexOf('=');
-      if (j == -1) j = line->length();
-      if (j == -1) break; // invalid formatting
-      int j1 = line->indexOf('&');
-      if (j1 == -1) j1 = line->length() + 1;
-      String thisArg = line->substring(0, j);
-      String thisVal = line->substring(j + 1, j1);
-      if (thisArg != "") {
-        if (++parameter_count > PARAMETER_COUNT_MAX) parameter_count = PARAMETER_COUNT_MAX;
-        parameters[parameter_count - 1] = thisArg;
-        thisVal.trim();
-        values[parameter_count - 1] = thisVal;
+  void WebServer::processParameters(char *line, bool trimValues) {
+    WLF("MSG: Webserver, checking parameters");
+
+    // look for form "?a=1&b=2", "&a=1" or "a=1"
+    char *s = line;
+    while (*s != 0 && *s != '\n') {
+      while (*s == '?' || *s == '&') s++;
+      int j1 = strcspn(s, "&\n");
+      int j = strcspn(s, "=&\n");
+
+      const char *thisArg = s;
+      int argLength = j;
+      const char *thisVal = s + j + (s[j] == '=' ? 1 : 0);
+      int valLength = j1 - (thisVal - s);
+      if (valLength < 0) valLength = 0;
+      if (trimValues) {
+        while (valLength > 0 && *thisVal == ' ') { thisVal++; valLength--; }
+        while (valLength > 0 && thisVal[valLength - 1] == ' ') valLength--;
       }
-      if ((int)line->length() > j1) *line = line->substring(j1); else *line = "";
-
-      WF("MSG: Webserver, found "); W(thisArg); W(" = "); WL(thisVal);
-    }
-  }
-
-  void WebServer::processPut(String* line) {
-    WLF("MSG: Webserver, checking header PUT parameters");
-
-    // make all tokens start with '&'
-    *line = "&" + *line;
-
-    if (line->equals("&")) { WLF("MSG: Webserver, PUT empty"); return; }
-
-    // isolate any parameters, get their values
-    // look for form "&a=1"
-    while ((*line)[0] == '?' || (*line)[0] == '&') {
-      *line = line->substring(1);
-      int j  = line->indexOf('=');
-      if (j == -1) j = line->length();
-      if (j == -1) break; // invalid formatting
-      int j1 = line->indexOf('&');
-      if (j1 == -1) j1 = line->length() + 1;
-      String thisArg = line->substring(0, j);
-      if (thisArg.startsWith("?")) thisArg = thisArg.substring(1);
-      String thisVal = line->substring(j + 1, j1);
-      if (thisArg != "") {
-        if (++parameter_count > PARAMETER_COUNT_MAX) parameter_count = PARAMETER_COUNT_MAX;
-        parameters[parameter_count - 1] = thisArg;
-        thisVal.trim();
-        values[parameter_count - 1] = thisVal;
-      }
-      if ((int)line->length() > j1) *line = line->substring(j1); else *line = "";
-
-      WF("MSG: Webserver found "); W(thisArg); W(" = "); WL(thisVal);
-    }
-  }
 
-  void WebServer::processPost(String* line) {
-    WLF("MSG: Webserver, checking header POST parameters");
-
-    // make all tokens start with '&'
-    *line = "&" + *line;
-
-    if (line->equals(EmptyStr)) { WLF("MSG: Webserver, POST empty"); return; }
-
-    // isolate any parameters, get their values
-    // look for form "&a=1"
-    while ((*line)[0] == '&') {
-      *line = line->substring(1);
-      int j  = line->indexOf('=');
-      if (j == -1) j = line->length();
-      if (j == -1) break; // invalid formatting
-      int j1 = line->indexOf('&');
-      if (j1 == -1) j1 = line->length() + 1;
-      String thisArg = line->substring(0, j);
-      String thisVal = line->substring(j + 1, j1);
-      if (thisArg != "") {
-        if (++parameter_count > PARAMETER_COUNT_MAX) parameter_count = PARAMETER_COUNT_MAX;
-        parameters[parameter_count - 1] = thisArg;
-        values[parameter_count - 1] = thisVal;
+      if (argLength > 0 && parameter_count < PARAMETER_COUNT_MAX && arenaLength + argLength + valLength + 2 <= WEB_PARAMETER_ARENA) {
+        parameters[parameter_count] = &arena[arenaLength];
+        memcpy(&arena[arenaLength], thisArg, argLength); arenaLength += argLength; arena[arenaLength++] = 0;
+        values[parameter_count] = &arena[arenaLength];
+        memcpy(&arena[arenaLength], thisVal, valLength); arenaLength += valLength; arena[arenaLength++] = 0;
+        WF("MSG: Webserver, found "); W(parameters[parameter_count]); W(" = "); WL(values[parameter_count]);
+        parameter_count++;
       }
-      if ((int)line->length() > j1) *line = line->substring(j1); else *line = "";
 
-      WF("MSG: Webserver, found "); W(thisArg); W(" = "); WL(thisVal);
+      s += j1;
     }
   }
 
-  void WebServer::on(String fn, webFunction handler) {
+  void WebServer::on(const char *fn, webFunction handler) {
     handler_count++; if (handler_count > WEB_HANDLER_COUNT_MAX) { handler_count = WEB_HANDLER_COUNT_MAX; return; }
     handlers[handler_count - 1] = handler;
     handlers_fn[handler_count - 1] = fn;
@@ -253,10 +216,9 @@
   
   // get argument value by identifier
   String WebServer::arg(String id) {
-    for (int i = 0; i < parameter_count; i++) {
-      if (id == parameters[i]) return values[i];
-    }
-    return EmptyStr;
+    const char *value = argValue(id.c_str());
+    if (value == NULL) return EmptyStr;
+    return value;
   }
 
   // get argument value by index
@@ -280,10 +242,15 @@
   
   // check if argument exists
   bool WebServer::hasArg(String id) {
+    return argValue(id.c_str()) != NULL;
+  }
+
+  // get argument value by identifier without making a String
+  const char *WebServer::argValue(const char *id) {
     for (int i = 0; i < parameter_count; i++) {
-      if (id == parameters[i]) return true;
+      if (strcmp(id, parameters[i]) == 0) return values[i];
     }
-    return false;
+    return NULL;
   }
   
   void WebServer::setContentLength(long length) {
@@ -296,38 +263,71 @@
   }
   
   void WebServer::sendHeader(const char* key, const char* val, bool first) {
-    String line = key;
-    line.concat(": ");
-    line.concat(val);
-    line.concat("\r\n");
-    if (first) header = line + header; else header.concat(line);
+    int count = strlen(key) + strlen(val) + 4;
+    int headerLength = strlen(header);
+    if (headerLength + count >= WEB_HEADER_SIZE) { DLF("WRN: Webserver, header too long"); return; }
+    char *s = header + headerLength;
+    if (first) { memmove(header + count, header, headerLength + 1); s = header; }
+    memcpy(s, key, strlen(key)); s += strlen(key);
+    memcpy(s, ": ", 2); s += 2;
+    memcpy(s, val, strlen(val)); s += strlen(val);
+    memcpy(s, "\r\n", 2);
+    if (!first) s[2] = 0;
   }
 
+  // the header goes through the content buffer too, so it usually shares a packet with the start of the page
   void WebServer::send(int code, const char* content_type, const String& content) {
-    header = "HTTP/1.1 " + String(code) + " OK\r\n" + header;
-    header += "Content-Type: "; header += content_type; header += "\r\n";
+    char s[40];
+    sprintf(s, "HTTP/1.1 %d OK\r\n", code);
+    sendContent(s);
+    sendContent(header);
+    sendContent("Content-Type: "); sendContent(content_type); sendContent("\r\n");
     if (length == CONTENT_LENGTH_UNKNOWN) {
-      header += "Connection: close\r\n";
+      sendContent("Connection: close\r\n");
     } else {
       if (length == CONTENT_LENGTH_NOT_SET) length = content.length();
-      header += "content-length: " + String(length) + "\r\n";
+      sprintf(s, "content-length: %ld\r\n", length);
+      sendContent(s);
     }
-    header += "\r\n";
-
-    client.print(header);
+    sendContent("\r\n");
 
-    if (length) client.print(content);
+    if (length) sendContent(content);
 
     length = CONTENT_LENGTH_NOT_SET;
-    header = "";
+    header[0] = 0;
   }
 
-  void WebServer::sendContent(String s) {
-    client.print(s);
+  void WebServer::sendContent(const String &s) {
+    sendContent(s.c_str());
   }
 
+  // content is gathered and goes out in packets of up to WEB_CHUNK_SIZE bytes
   void WebServer::sendContent(const char * s) {
-    client.print(s);
+    int count = strlen(s);
+    while (count > 0) {
+      int room = WEB_CHUNK_SIZE - contentLength;
+      int n = count < room ? count : room;
+      memcpy(&content[contentLength], s, n);
+      contentLength += n;
+      s += n;
+      count -= n;
+      if (contentLength >= WEB_CHUNK_SIZE) flushContent();
+    }
+  }
+
+  void WebServer::flushContent() {
+    if (contentLength > 0) client.write((const uint8_t *)content, contentLength);
+    contentLength = 0;
+  }
+
+  int WebServer::heapFragmentation() {
+    #ifdef ESP32
+      size_t free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+      if (free == 0) return 0;
+      return 100 - (int)(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT)*100/free);
+    #else
+      return -1;
+    #endif
   }
 
   WebServer www;
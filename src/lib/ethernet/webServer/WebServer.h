@@ -34,6 +34,21 @@
   #define WEB_HANDLER_COUNT_MAX  24
   #endif
   #define PARAMETER_COUNT_MAX    12
+  #ifndef WEB_LINE_SIZE
+  #define WEB_LINE_SIZE          1024     // longest request line kept, the rest is dropped
+  #endif
+  #ifndef WEB_PARAMETER_ARENA
+  #define WEB_PARAMETER_ARENA    512      // bytes shared by all parameter names and values of a request
+  #endif
+  #ifndef WEB_URI_SIZE
+  #define WEB_URI_SIZE           64
+  #endif
+  #ifndef WEB_HEADER_SIZE
+  #define WEB_HEADER_SIZE        512
+  #endif
+  #ifndef WEB_CHUNK_SIZE
+  #define WEB_CHUNK_SIZE         1024     // response content is sent in packets of up to this size
+  #endif
   #define CONTENT_LENGTH_UNKNOWN -1
   #define CONTENT_LENGTH_NOT_SET -2
   #define HTTP_UNKNOWN           0
@@ -51,7 +66,8 @@
 
       void handleClient();
 
-      void on(String fn, webFunction handler);
+      // fn must stay valid while the server runs (a string literal)
+      void on(const char *fn, webFunction handler);
       void onNotFound(webFunction handler);
 
       // get argument value by identifier
@@ -64,6 +80,8 @@
       int args();                     
       // check if argument exists
       bool hasArg(String id);
+      // get argument value by identifier without making a String, NULL if not found
+      const char *argValue(const char *id);
 
       // check http last method used, returns HTTP_UNKNOWN, HTTP_GET, HTTP_PUT, or HTTP_POST
       inline int method() { return lastMethod; }
@@ -78,37 +96,53 @@
       void setResponseHeader(const char *str);
       void sendHeader(const char* key, const char* val, bool first = false);
       void send(int code, const char* content_type = "text/html", const String& content = "");
-      void sendContent(String s);
+      void sendContent(const String &s);
       void sendContent(const char * s);
 
+      // heap fragmentation in %, 0 if the free heap is all in one block, -1 if not known on this platform
+      int heapFragmentation();
+
+      // requests handled and the slowest one (in ms)
+      unsigned long requests = 0;
+      unsigned long requestTimeMaxMs = 0;
+
       EthernetServer *webServer = NULL;
       EthernetClient client;
     private:
-      int  getHandler(String* line);
-      void processGet(String* line);
-      void processPut(String* line);
-      void processPost(String* line);
- 
+      // finds the handler for the url in line, leaves any parameters in line
+      int  getHandler(char *line);
+
+      // splits "?a=1&b=2" style parameters into the arena
+      void processParameters(char *line, bool trimValues);
+
+      // send anything waiting in the content buffer
+      void flushContent();
+
       char responseHeader[200] = "";
       bool modifiedSinceFound = false;
   
       webFunction notFoundHandler = NULL;
       webFunction handlers[WEB_HANDLER_COUNT_MAX];
-      String handlers_fn[WEB_HANDLER_COUNT_MAX];
+      const char *handlers_fn[WEB_HANDLER_COUNT_MAX];
       int handler_count = 0;
       
-      String requestedHandler;
-      String parameters[PARAMETER_COUNT_MAX];
-      String values[PARAMETER_COUNT_MAX];
-      int parameter_count;
+      char requestedHandler[WEB_URI_SIZE] = "";
+      char line[WEB_LINE_SIZE];
+      char arena[WEB_PARAMETER_ARENA];
+      int arenaLength = 0;
+      const char *parameters[PARAMETER_COUNT_MAX];
+      const char *values[PARAMETER_COUNT_MAX];
+      int parameter_count = 0;
       int port = -1;
       bool autoReset = false;
       long timeToClose = 100;
 
       int lastMethod = HTTP_UNKNOWN;
 
-      long length;
-      String header;
+      long length = CONTENT_LENGTH_NOT_SET;
+      char header[WEB_HEADER_SIZE] = "";
+      char content[WEB_CHUNK_SIZE];
+      int contentLength = 0;
   };
 
   extern WebServer www;
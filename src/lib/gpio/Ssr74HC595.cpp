@@ -20,6 +20,15 @@
 #if GPIO_SSR74HC595_COUNT != 8 && GPIO_SSR74HC595_COUNT != 16 && GPIO_SSR74HC595_COUNT != 24 && GPIO_SSR74HC595_COUNT != 32
   #error "GPIO device SSR74HC595 supports GPIO_SSR74HC595_COUNT of 8, 16, 24, or 32 only."
 #endif
+#if GPIO_SSR74HC595_FRAME_RATE != OFF && (GPIO_SSR74HC595_FRAME_RATE < 1000 || GPIO_SSR74HC595_FRAME_RATE > 100000)
+  #error "GPIO device SSR74HC595 GPIO_SSR74HC595_FRAME_RATE must be OFF or 1000 to 100000 (Hz.)"
+#endif
+#if GPIO_SSR74HC595_STREAM == ON && GPIO_SSR74HC595_FRAME_RATE == OFF
+  #error "GPIO device SSR74HC595 GPIO_SSR74HC595_STREAM requires GPIO_SSR74HC595_FRAME_RATE be set."
+#endif
+#if GPIO_SSR74HC595_STREAM == ON && GPIO_SSR74HC595_COUNT > 16
+  #error "GPIO device SSR74HC595 GPIO_SSR74HC595_STREAM supports GPIO_SSR74HC595_COUNT of 8 or 16 only."
+#endif
 
 #ifdef ESP32
   // ESP32 GPIO SSR74HC595 macros (if used, code below only works for pins 0 to 31)
@@ -31,12 +40,12 @@
   #define GPIO_SSR74HC595_DATA_HIGH() { GPIO.out_w1ts = ((uint32_t)1 << GPIO_SSR74HC595_DATA_PIN); }
 #else
   // generic GPIO SSR74HC595 macros
-  #define GPIO_SSR74HC595_LATCH_LOW() digitalWrite(GPIO_SSR74HC595_LATCH_PIN, LOW)
-  #define GPIO_SSR74HC595_LATCH_HIGH() digitalWrite(GPIO_SSR74HC595_LATCH_PIN, HIGH)
-  #define GPIO_SSR74HC595_CLOCK_LOW() digitalWrite(GPIO_SSR74HC595_CLOCK_PIN, LOW)
-  #define GPIO_SSR74HC595_CLOCK_HIGH() digitalWrite(GPIO_SSR74HC595_CLOCK_PIN, HIGH)
-  #define GPIO_SSR74HC595_DATA_LOW() digitalWrite(GPIO_SSR74HC595_DATA_PIN, LOW)
-  #define GPIO_SSR74HC595_DATA_HIGH() digitalWrite(GPIO_SSR74HC595_DATA_PIN, HIGH)
+  #define GPIO_SSR74HC595_LATCH_LOW() ::digitalWrite(GPIO_SSR74HC595_LATCH_PIN, LOW)
+  #define GPIO_SSR74HC595_LATCH_HIGH() ::digitalWrite(GPIO_SSR74HC595_LATCH_PIN, HIGH)
+  #define GPIO_SSR74HC595_CLOCK_LOW() ::digitalWrite(GPIO_SSR74HC595_CLOCK_PIN, LOW)
+  #define GPIO_SSR74HC595_CLOCK_HIGH() ::digitalWrite(GPIO_SSR74HC595_CLOCK_PIN, HIGH)
+  #define GPIO_SSR74HC595_DATA_LOW() ::digitalWrite(GPIO_SSR74HC595_DATA_PIN, LOW)
+  #define GPIO_SSR74HC595_DATA_HIGH() ::digitalWrite(GPIO_SSR74HC595_DATA_PIN, HIGH)
 #endif
 
 #include "../tasks/OnTask.h"
@@ -69,6 +78,10 @@ IRAM_ATTR void shiftOut20MHz(uint32_t val) {
   GPIO_SSR74HC595_CLOCK_LOW();
 }
 
+#if GPIO_SSR74HC595_FRAME_RATE != OFF && GPIO_SSR74HC595_STREAM != ON
+  IRAM_ATTR void ssr74HC595FrameWrapper() { gpio.commitFrame(); }
+#endif
+
 // get device ready
 bool Ssr74HC595::init() {
   static bool initialized = false;
@@ -86,6 +99,23 @@ bool Ssr74HC595::init() {
   VLF("MSG: GPIO, SSR74HC595 Initialized");
 
   found = true;
+
+  #if GPIO_SSR74HC595_FRAME_RATE != OFF && GPIO_SSR74HC595_STREAM != ON
+    // all changes are latched together at the frame rate, this requires a hardware timer
+    VF("MSG: GPIO, start SSR74HC595 frame task (rate "); V(GPIO_SSR74HC595_FRAME_RATE); VF("Hz priority 0)... ");
+    uint8_t frameHandle = tasks.add(0, 0, true, 0, ssr74HC595FrameWrapper, "GpioFrm");
+    if (frameHandle) {
+      if (tasks.requestHardwareTimer(frameHandle, 0)) {
+        tasks.setPeriodSubMicros(frameHandle, lroundf(16000000.0F/GPIO_SSR74HC595_FRAME_RATE));
+        frameMode = true;
+        VLF("success");
+      } else {
+        tasks.remove(frameHandle);
+        VLF("no hardware timer, frames disabled!");
+      }
+    } else { VLF("FAILED!"); }
+  #endif
+
   return found;
 }
 
@@ -118,23 +148,126 @@ int Ssr74HC595::digitalRead(int pin) {
 }
 
 // up to four eight channel 74HC595 GPIOs are supported, this sets each output on or off
-void Ssr74HC595::digitalWrite(int pin, bool value) {
+IRAM_ATTR void Ssr74HC595::digitalWrite(int pin, bool value) {
   if (found && pin >= 0 && pin < GPIO_SSR74HC595_COUNT) {
     cli();
     state[pin] = value;
     if (mode[pin] == OUTPUT) {
+      #if GPIO_SSR74HC595_FRAME_RATE != OFF
+        if (frameMode) {
+          uint32_t bit = 1UL << pin;
+          uint8_t i = lastFrame();
+          if (pulseMask & bit) {
+            // pulse pins are returned to their inactive state by the frame itself
+            if (value == (bool)(pulseActive & bit)) {
+              // so the pulse goes in a frame after any change written before it and after the pin was inactive
+              while (frameCount == 0 || frameChanged[i] || ((framePulsed[i] | frameBlocked[i]) & bit)) { pushFrame(); i = lastFrame(); }
+              if (value) frameValue[i] |= bit; else frameValue[i] &= ~bit;
+              framePulsed[i] |= bit;
+            }
+          } else {
+            uint32_t current = frameCount > 0 ? frameValue[i] : register_value;
+            if ((bool)(current & bit) != value) {
+              // and changes go in a frame after any pulse written before them
+              if (frameCount == 0 || framePulsed[i]) pushFrame();
+              i = lastFrame();
+              if (value) frameValue[i] |= bit; else frameValue[i] &= ~bit;
+              frameChanged[i] = true;
+            }
+          }
+          sei();
+          return;
+        }
+      #endif
       if (value) bitSet(register_value, pin); else bitClear(register_value, pin);
-      GPIO_SSR74HC595_LATCH_LOW();
-      if (GPIO_SSR74HC595_COUNT >= 32) shiftOut20MHz((register_value>>24) & 0xff);
-      if (GPIO_SSR74HC595_COUNT >= 24) shiftOut20MHz((register_value>>16) & 0xff);
-      if (GPIO_SSR74HC595_COUNT >= 16) shiftOut20MHz((register_value>>8) & 0xff);
-      shiftOut20MHz((register_value) & 0xff);
-      GPIO_SSR74HC595_LATCH_HIGH();
+      writeFrame(register_value);
     }
     sei();
   } else return;
 }
 
+#if GPIO_SSR74HC595_FRAME_RATE != OFF
+  // marks a pin for pulse output, once latched in the active state it returns to inactive on the next frame
+  void Ssr74HC595::setPulsePin(int pin, bool activeState) {
+    if (found && pin >= 0 && pin < GPIO_SSR74HC595_COUNT) {
+      cli();
+      bitSet(pulseMask, pin);
+      if (activeState) bitSet(pulseActive, pin); else bitClear(pulseActive, pin);
+      sei();
+    }
+  }
+
+  // adds a frame after those waiting, with the pulse pins inactive, returns false if the queue is full
+  IRAM_ATTR bool Ssr74HC595::addFrame() {
+    if (frameCount >= GPIO_SSR74HC595_FRAME_QUEUE) return false;
+
+    uint32_t value = register_value;
+    uint32_t pulsed = latchedPulsed;
+    if (frameCount > 0) { value = frameValue[lastFrame()]; pulsed = framePulsed[lastFrame()]; }
+
+    uint8_t i = (frameHead + frameCount) % GPIO_SSR74HC595_FRAME_QUEUE;
+    frameValue[i] = idleFrame(value);
+    framePulsed[i] = 0;
+    frameBlocked[i] = pulsed;
+    frameChanged[i] = false;
+    frameCount++;
+    return true;
+  }
+
+  // adds a frame as above, if the queue is full the frame waiting longest goes out first to make room
+  // this keeps the frames in order (never merging a pulse into a frame with a change written after it) at the
+  // cost of that frame being latched for less than a frame period
+  IRAM_ATTR void Ssr74HC595::pushFrame() {
+    if (frameCount >= GPIO_SSR74HC595_FRAME_QUEUE) {
+      uint32_t value = popFrame();
+      if (frameOutput != NULL) frameOutput(value); else writeFrame(value);
+    }
+    addFrame();
+  }
+
+  // removes and returns the frame waiting longest (or the register value if none), call with interrupts disabled
+  IRAM_ATTR uint32_t Ssr74HC595::popFrame() {
+    uint32_t value = register_value;
+    latchedPulsed = 0;
+    if (frameCount > 0) {
+      value = frameValue[frameHead];
+      latchedPulsed = framePulsed[frameHead];
+      frameHead = (frameHead + 1) % GPIO_SSR74HC595_FRAME_QUEUE;
+      frameCount--;
+    }
+    register_value = idleFrame(value);
+
+    return value;
+  }
+
+  // gets the register value for the next frame, afterwards any pulse pins return to their inactive state
+  IRAM_ATTR uint32_t Ssr74HC595::nextFrame() {
+    cli();
+    uint32_t value = popFrame();
+    sei();
+
+    return value;
+  }
+
+  // shifts out and latches the next frame, if anything changed
+  IRAM_ATTR void Ssr74HC595::commitFrame() {
+    if (frameCount == 0 && latchedPulsed == 0) return;
+    cli();
+    writeFrame(popFrame());
+    sei();
+  }
+#endif
+
+// shifts out and latches the given value
+IRAM_ATTR void Ssr74HC595::writeFrame(uint32_t value) {
+  GPIO_SSR74HC595_LATCH_LOW();
+  if (GPIO_SSR74HC595_COUNT >= 32) shiftOut20MHz((value>>24) & 0xff);
+  if (GPIO_SSR74HC595_COUNT >= 24) shiftOut20MHz((value>>16) & 0xff);
+  if (GPIO_SSR74HC595_COUNT >= 16) shiftOut20MHz((value>>8) & 0xff);
+  shiftOut20MHz((value) & 0xff);
+  GPIO_SSR74HC595_LATCH_HIGH();
+}
+
 Ssr74HC595 gpio;
 
 #endif
@@ -8,6 +8,9 @@
 
 #include "../commands/CommandErrors.h"
 
+// frames that can be waiting to be latched
+#define GPIO_SSR74HC595_FRAME_QUEUE 4
+
 class Ssr74HC595 {
   public:
     // init for SSR74HC595 device
@@ -25,10 +28,64 @@ class Ssr74HC595 {
     // up to four eight channel 74HC595 GPIOs are supported, this sets each output on or off
     void digitalWrite(int pin, bool value);
 
+    #if GPIO_SSR74HC595_FRAME_RATE != OFF
+      // marks a pin for pulse output, once latched in the active state it returns to inactive on the next frame
+      void setPulsePin(int pin, bool activeState);
+
+      // writes are held in the register until the next frame when enabled, otherwise they are latched immediately
+      inline void setFrameMode(bool state) { frameMode = state; }
+
+      // gets the register value for the next frame, afterwards any pulse pins return to their inactive state
+      uint32_t nextFrame();
+
+      // gets the given register value with any pulse pins in their inactive state
+      inline uint32_t idleFrame(uint32_t value) { return (value & ~pulseMask) | (~pulseActive & pulseMask); }
+
+      // shifts out and latches the next frame, if anything changed
+      void commitFrame();
+
+      // frames that must go out early to make room in a full queue are passed here rather than latched directly
+      inline void setFrameOutput(void (*output)(uint32_t value)) { frameOutput = output; }
+    #endif
+
+    // shifts out and latches the given value
+    void writeFrame(uint32_t value);
+
   private:
-    uint32_t register_value = 0;
+    volatile uint32_t register_value = 0;
     bool found = false;
 
+    #if GPIO_SSR74HC595_FRAME_RATE != OFF
+      // adds a frame after those waiting, with the pulse pins inactive, returns false if the queue is full
+      bool addFrame();
+
+      // adds a frame as above, if the queue is full the frame waiting longest goes out first to make room
+      void pushFrame();
+
+      // removes and returns the frame waiting longest (or the register value if none), call with interrupts disabled
+      uint32_t popFrame();
+
+      // index of the last frame waiting
+      inline uint8_t lastFrame() { return (frameHead + frameCount - 1) % GPIO_SSR74HC595_FRAME_QUEUE; }
+
+      void (*frameOutput)(uint32_t value) = NULL;
+
+      volatile bool frameMode = false;     // true if writes are held for the next frame
+      uint32_t pulseMask = 0;              // pins that return to their inactive state after being latched
+      uint32_t pulseActive = 0;            // active state of the pulse pins
+
+      // frames waiting to be latched, in order, so a pulse never latches together with a change to another pin
+      // written before it (a direction change before a step for instance) and a pulse pin is inactive for at
+      // least one frame between pulses
+      uint32_t frameValue[GPIO_SSR74HC595_FRAME_QUEUE];
+      uint32_t framePulsed[GPIO_SSR74HC595_FRAME_QUEUE];   // pulse pins active in the frame
+      uint32_t frameBlocked[GPIO_SSR74HC595_FRAME_QUEUE];  // pulse pins active in the frame before
+      bool frameChanged[GPIO_SSR74HC595_FRAME_QUEUE];      // other pins changed in the frame
+      uint8_t frameHead = 0;
+      volatile uint8_t frameCount = 0;
+      uint32_t latchedPulsed = 0;          // pulse pins active in the frame last latched
+    #endif
+
     int mode[32];
     bool state[32];
 };
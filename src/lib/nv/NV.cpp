@@ -63,6 +63,46 @@ void NonVolatileStorage::wait() {
   VL(".");
 }
 
+// read the whole NV image into the cache in bursts (for a fast startup), blocking
+// returns false if there is no cache
+bool NonVolatileStorage::load() {
+  if (cacheSize == 0) return false;
+
+  uint16_t readSize = pageReadSize;
+  if (readSize > 32) readSize = 32;
+
+  unsigned long startTimeMs = millis();
+  for (uint16_t i = 0; i < cacheSize; i += readSize) {
+    uint8_t count = readSize;
+    if (i + count > cacheSize) count = cacheSize - i;
+
+    // only bytes still marked for reading are replaced, any already written stay as they are
+    uint8_t data[32];
+    while (busy()) {}
+    readPageFromStorage(i, data, count);
+    for (uint16_t k = 0; k < count; k++) {
+      if (bitRead(cacheStateRead[(i + k)/8], (i + k)%8)) {
+        cache[i + k] = data[k];
+        bitWrite(cacheStateRead[(i + k)/8], (i + k)%8, 0);
+      }
+    }
+  }
+  loadTimeMs = millis() - startTimeMs;
+
+  VF("MSG: NV, loaded "); V(cacheSize); VF(" bytes into cache in "); V(loadTimeMs); VLF(" ms");
+  return true;
+}
+
+// CRC-16 (CCITT) of count bytes starting at position i
+uint16_t NonVolatileStorage::checksum(uint16_t i, uint16_t count) {
+  uint16_t crc = 0xFFFF;
+  for (uint16_t k = 0; k < count; k++) {
+    crc ^= (uint16_t)read(i + k) << 8;
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
 // returns true if NV holds the correct key value in addresses 0..4
 // except returns false if #define NV_WIPE ON exists
 bool NonVolatileStorage::isKeyValid(uint32_t uniqueKey) {
@@ -133,39 +173,56 @@ void NonVolatileStorage::poll(bool disableInterrupts) {
 
   if (busy()) return;
 
-  // check 20 byte chunks of cache for data that needs processing
+  bool writeReady = !delayedCommitEnabled || (long)(millis() - commitReadyTimeMs) >= 0;
+
+  // check 20 bytes of the cache state (160 bytes of cache) for data that needs processing
   for (uint8_t j = 0; j < 20; j++) {
     cacheIndex++;
     if (cacheIndex >= cacheSize) {
-      if (cacheCleanThisPass) cacheClean = true;
+      if (cacheCleanThisPass) {
+        cacheClean = true;
+        if (commitActive) {
+          commitTimeMs = millis() - commitStartTimeMs;
+          if (commitTimeMs > commitTimeMaxMs) commitTimeMaxMs = commitTimeMs;
+          commitActive = false;
+        }
+      }
       cacheIndex = 0;
       cacheCleanThisPass = true;
     }
 
-    if (!delayedCommitEnabled || (long)(millis() - commitReadyTimeMs) >= 0)
-      dirtyW = bitRead(cacheStateWrite[cacheIndex/8], cacheIndex%8); else cacheCleanThisPass = false;
-    dirtyR = bitRead(cacheStateRead[cacheIndex/8], cacheIndex%8);
+    uint8_t stateW = cacheStateWrite[cacheIndex/8];
+    uint8_t stateR = cacheStateRead[cacheIndex/8];
+    if (!writeReady) { if (stateW) cacheCleanThisPass = false; stateW = 0; }
+
+    // nothing to do for the rest of these 8 bytes, skip to the next
+    if (((stateW | stateR) >> (cacheIndex%8)) == 0) { cacheIndex |= 7; continue; }
+
+    dirtyW = bitRead(stateW, cacheIndex%8);
+    dirtyR = bitRead(stateR, cacheIndex%8);
     if (dirtyW || dirtyR) { cacheCleanThisPass = false; break; }
   }
 
   if (dirtyW) {
-    uint16_t p = pageWriteSize;
-
-    // if not a page boundary use a page size of 1
-    if ((cacheIndex % p) != 0) p = 1; else
-
-    for (uint16_t k = 0; k < p; k++) {
-      // if a page write would exceed the NV size use a page size of 1
-      if (cacheIndex + k >= cacheSize) { p = 1; break; }
-      // check that the read cache for these locations is clean otherwise use a page size of 1
-      if (bitRead(cacheStateRead[(cacheIndex + k)/8], (cacheIndex + k)%8)) { p = 1; break; }
+    // burst over the following bytes that have valid cache data up to the page size (or boundary)
+    uint16_t count = 1;
+    while ((int)count < pageWriteSize) {
+      uint16_t k = cacheIndex + count;
+      if (k >= cacheSize || (pageBoundaries && k % pageWriteSize == 0)) break;
+      if (bitRead(cacheStateRead[k/8], k%8)) break;
+      count++;
     }
 
-    // write the page and update the cache write state
-    writePageToStorage(cacheIndex, &cache[cacheIndex], p);
-    for (uint16_t k = 0; k < p; k++) {
+    // no need to include trailing bytes that are already stored
+    while (count > 1 && !bitRead(cacheStateWrite[(cacheIndex + count - 1)/8], (cacheIndex + count - 1)%8)) count--;
+
+    // write the burst and update the cache write state
+    if (count == 1) writeToStorage(cacheIndex, cache[cacheIndex]); else writePageToStorage(cacheIndex, &cache[cacheIndex], count);
+    for (uint16_t k = 0; k < count; k++) {
       bitWrite(cacheStateWrite[(cacheIndex + k)/8], (cacheIndex + k)%8, 0);
     }
+    commitBytes += count;
+    cacheIndex += count - 1;
   } else {
     if (dirtyR) {
       cache[cacheIndex] = readFromStorage(cacheIndex);
@@ -173,18 +230,6 @@ void NonVolatileStorage::poll(bool disableInterrupts) {
     }
   }
 
-  /*
-  int32_t dirtyWriteCount = 0;
-  static int32_t lastDirtyWriteCount = 0;
-  for (uint16_t i = 0; i < cacheSize; i++) { if (bitRead(cacheStateWrite[i/8], i%8)) dirtyWriteCount++; }
-  if (lastDirtyWriteCount != dirtyWriteCount) { V("MSG: NV, cache "); V(dirtyWriteCount); VL(" bytes to be written"); }
-
-  int32_t dirtyReadCount = 0;
-  static int32_t lastDirtyReadCount = 0;
-  for (uint16_t i = 0; i < cacheSize; i++) { if (bitRead(cacheStateRead[i/8], i%8)) dirtyReadCount++; }
-  if (lastDirtyReadCount != dirtyReadCount) { V("MSG: NV, cache "); V(dirtyReadCount); VL(" bytes to be read"); }
-  */
-
   // stop compiler warnings
   (void)(disableInterrupts);
 }
@@ -192,10 +237,8 @@ void NonVolatileStorage::poll(bool disableInterrupts) {
 bool NonVolatileStorage::committed() {
   cacheSizeDirtyCount = 0;
 
-  for (uint16_t i = 0; i < cacheSize; i++) {
-    if (bitRead(cacheStateWrite[i/8], i%8)) {
-      cacheSizeDirtyCount++;
-    }
+  for (uint16_t i = 0; i < cacheSize/8; i++) {
+    for (uint8_t state = cacheStateWrite[i]; state; state &= state - 1) cacheSizeDirtyCount++;
   }
 
   return !cacheSizeDirtyCount;
@@ -225,16 +268,17 @@ uint8_t NonVolatileStorage::readFromCache(uint16_t i) {
 }
 
 void NonVolatileStorage::writeToCache(uint16_t i, uint8_t j) {
-  // no longer clean
+  // no longer clean, and that takes a full pass to confirm again
   cacheClean = false;
+  cacheCleanThisPass = false;
 
   if (readAndWriteThrough) if (!readOnlyMode) writeToStorage(i, j);
 
   if (cacheSize == 0) {
     if (!readOnlyMode) {
       if (!readAndWriteThrough) {
-        if (j != readFromStorage(i)) writeToStorage(i, j);
-      } else writeToStorage(i, j);
+        if (j != readFromStorage(i)) { writeToStorage(i, j); changes++; }
+      } else { writeToStorage(i, j); changes++; }
     }
 
     commitReadyTimeMs = millis() + waitMs;
@@ -244,9 +288,15 @@ void NonVolatileStorage::writeToCache(uint16_t i, uint8_t j) {
   uint8_t k = readFromCache(i);
   if (j != k) {
     cache[i] = j;
+    changes++;
 
     // mark write as dirty (needs to be written)
     bitWrite(cacheStateWrite[i/8], i%8, 1);
+    if (!commitActive) {
+      commitActive = true;
+      commitStartTimeMs = millis();
+      commitBytes = 0;
+    }
 
     // mark read as clean (so we don't overwrite the cache)
     bitWrite(cacheStateRead[i/8], i%8, 0);
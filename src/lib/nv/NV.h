@@ -27,6 +27,13 @@ class NonVolatileStorage {
     // wait for all commits to finish, blocking
     void wait();
 
+    // read the whole NV image into the cache in bursts (for a fast startup), blocking
+    // returns false if there is no cache
+    bool load();
+
+    // CRC-16 (CCITT) of count bytes starting at position i
+    uint16_t checksum(uint16_t i, uint16_t count);
+
     // returns true if NV holds the correct key value in addresses 0..4
     // except returns false if #define NV_WIPE ON exists
     bool isKeyValid(uint32_t uniqueKey);
@@ -122,6 +129,20 @@ class NonVolatileStorage {
     // NV size in bytes
     uint16_t size = 0;
 
+    // commit statistics, for drivers that keep them
+    // commit times are from the first write until everything is stored, the block time is the longest
+    // single storage operation (flash based devices can hold off timer interrupts for this long)
+    unsigned long commitTimeMs = 0;
+    unsigned long commitTimeMaxMs = 0;
+    unsigned long commitBytes = 0;      // bytes stored by the last commit
+    unsigned long blockTimeMaxUs = 0;
+
+    // time the load() took
+    unsigned long loadTimeMs = 0;
+
+    // counts changes to the stored data, so users can tell if anything was written
+    uint32_t changes = 0;
+
     bool initError = false;
 
   protected:
@@ -129,18 +150,27 @@ class NonVolatileStorage {
     virtual bool busy();
 
     // read byte at position i from storage
-    virtual uint8_t readFromStorage(uint16_t i);
+    virtual uint8_t readFromStorage(uint16_t i) = 0;
 
     // write value j to position i in storage 
-    virtual void writeToStorage(uint16_t i, uint8_t j);
+    virtual void writeToStorage(uint16_t i, uint8_t j) = 0;
 
     // write value j of count bytes to position starting at i in storage
     // these writes must be aligned with the page size!
     virtual void writePageToStorage(uint16_t i, uint8_t *j, uint8_t count) { writeToStorage(i, *j); (void)(count); }
 
-    // default page write size is 1
+    // read count bytes starting at position i in storage into j
+    virtual void readPageFromStorage(uint16_t i, uint8_t *j, uint8_t count) { for (uint8_t k = 0; k < count; k++) j[k] = readFromStorage(i + k); }
+
+    // default page write size is 1, the cache is written in bursts of up to this many bytes
     int pageWriteSize = 1;
 
+    // true if bursts can't cross a multiple of pageWriteSize (EEPROM pages), false if they can start anywhere (FRAM)
+    bool pageBoundaries = true;
+
+    // bytes read at once by load(), up to 32
+    int pageReadSize = 1;
+
     bool readAndWriteThrough = false;
     bool readOnlyMode = false;
 
@@ -165,4 +195,8 @@ class NonVolatileStorage {
     bool cacheClean = false;
 
     uint32_t commitReadyTimeMs = 0;
+
+    // true from the first write into a clean cache until all of it is stored
+    bool commitActive = false;
+    uint32_t commitStartTimeMs = 0;
 };
@@ -6,6 +6,16 @@
 // universal value works for all known 24XX series, 10ms
 #define EEPROM_WRITE_WAIT 10
 
+// universal value works for all known 24XX series, 8 bytes, larger devices often allow 32 or more
+#ifndef EEPROM_PAGE_SIZE
+#define EEPROM_PAGE_SIZE 8
+#endif
+
+// limited by the Wire buffer (32 bytes on most platforms)
+#ifndef EEPROM_READ_SIZE
+#define EEPROM_READ_SIZE 32
+#endif
+
 #define MSB(i) (i >> 8)
 #define LSB(i) (i & 0xFF)
 
@@ -13,8 +23,11 @@ bool NonVolatileStorage24XX::init(uint16_t size, bool cacheEnable, uint16_t wait
   // setup size, cache, etc.
   NonVolatileStorage::init(size, cacheEnable, wait, checkEnable, wire, address);
 
-  // device page size must be >= 8 and a multipule of 8
-  if (cacheEnable) pageWriteSize = 8;
+  // device page size must be >= 8 and a multipule of 8 (and no more than the Wire buffer allows)
+  if (cacheEnable) pageWriteSize = EEPROM_PAGE_SIZE;
+
+  // sequential reads run across pages, so these are limited only by the Wire buffer
+  pageReadSize = EEPROM_READ_SIZE;
 
   this->wire = wire;
   eepromAddress = address;
@@ -65,3 +78,16 @@ void NonVolatileStorage24XX::writePageToStorage(uint16_t i, uint8_t *j, uint8_t
   wire->endTransmission();
   nextOpMs = millis() + EEPROM_WRITE_WAIT;
 }
+
+// read count bytes starting at position i in storage into j
+void NonVolatileStorage24XX::readPageFromStorage(uint16_t i, uint8_t *j, uint8_t count) {
+  while (busy()) {}
+
+  wire->beginTransmission(eepromAddress);
+  wire->write(MSB(i));
+  wire->write(LSB(i));
+  wire->endTransmission();
+
+  size_t result = wire->requestFrom(eepromAddress, count);
+  for (uint8_t k = 0; k < count; k++) j[k] = (k < result && wire->available()) ? wire->read() : 0;
+}
@@ -31,6 +31,9 @@ class NonVolatileStorage24XX : public NonVolatileStorage {
     // write value j of count bytes to position starting at i in storage
     // these writes must be aligned with the page size!
     void writePageToStorage(uint16_t i, uint8_t *j, uint8_t count);
+
+    // read count bytes starting at position i in storage into j
+    void readPageFromStorage(uint16_t i, uint8_t *j, uint8_t count);
  
     TwoWire* wire;
     uint8_t eepromAddress = 0;
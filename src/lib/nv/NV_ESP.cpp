@@ -5,50 +5,161 @@
 
 #if defined(ESP8266) || defined(ESP32)
 
-  // from the NV library
+  #include "../debug/Debug.h"
+
   #if defined(ESP32)
-    extern void timerAlarmsDisable();
-    extern void timerAlarmsEnable();
+    #include <nvs.h>
   #endif
 
   bool NonVolatileStorageESP::init(uint16_t size, bool cacheEnable, uint16_t wait, bool checkEnable, TwoWire* wire, uint8_t address) {
     if (size > 4096 || wait == false) return false;
 
+    #if defined(ESP32)
+      if (size % NV_ESP_CHUNK_SIZE != 0 || size/NV_ESP_CHUNK_SIZE > 32) return false;
+    #endif
+
     // setup size, cache, etc.
     NonVolatileStorage::init(size, cacheEnable, wait, checkEnable, wire, address);
 
-    EEPROM.begin(size);
+    #if defined(ESP32)
+      // each chunk is an NVS blob, these are written out as a new copy before the old one is
+      // dropped so a commit can stop between chunks (or at power off) without losing anything
+      nvs_handle_t handle;
+      if (nvs_open("nv", NVS_READWRITE, &handle) != ESP_OK) return false;
+      nvsHandle = handle;
+
+      image = new uint8_t[size];
+      chunkCount = size/NV_ESP_CHUNK_SIZE;
+
+      for (uint8_t c = 0; c < chunkCount; c++) {
+        char key[8];
+        sprintf(key, "c%02d", c);
+        size_t length = NV_ESP_CHUNK_SIZE;
+        if (nvs_get_blob(nvsHandle, key, &image[c*NV_ESP_CHUNK_SIZE], &length) != ESP_OK || length != NV_ESP_CHUNK_SIZE) {
+          importEEPROM();
+          break;
+        }
+      }
+    #else
+      EEPROM.begin(size);
+    #endif
+
     return true;
   }
 
   void NonVolatileStorageESP::poll(bool disableInterrupts) {
-    if (dirty && ((long)(millis() - commitReadyTimeMs) >= 0)) {
-      #if defined(ESP32)
-        if (disableInterrupts) timerAlarmsDisable();
-      #endif
-      EEPROM.commit();
-      #if defined(ESP32)
-        if (disableInterrupts) timerAlarmsEnable();
-      #endif
-      dirty = false;
-    }
-    #if !defined(ESP32)
-      // stop compiler warnings
-      (void)(disableInterrupts);
+    // the flash driver holds off (non-IRAM) interrupts itself for the time it needs the flash
+    (void)(disableInterrupts);
+
+    #if defined(ESP32)
+      if (dirtyChunks == 0) return;
+      if ((long)(millis() - commitReadyTimeMs) < 0) return;
+
+      // one chunk per call
+      uint8_t c = 0;
+      while (!bitRead(dirtyChunks, c)) c++;
+      char key[8];
+      sprintf(key, "c%02d", c);
+
+      unsigned long startTimeUs = micros();
+      bool success = nvs_set_blob(nvsHandle, key, &image[c*NV_ESP_CHUNK_SIZE], NV_ESP_CHUNK_SIZE) == ESP_OK &&
+                     nvs_commit(nvsHandle) == ESP_OK;
+      unsigned long blockTimeUs = micros() - startTimeUs;
+      if (blockTimeUs > blockTimeMaxUs) blockTimeMaxUs = blockTimeUs;
+
+      if (!success) {
+        DF("ERR: NV, commit of chunk "); D(c); DLF(" failed retrying later");
+        commitReadyTimeMs = millis() + waitMs;
+        return;
+      }
+
+      bitClear(dirtyChunks, c);
+      commitBytes += NV_ESP_CHUNK_SIZE;
+      if (dirtyChunks == 0) {
+        commitTimeMs = millis() - commitStartTimeMs;
+        if (commitTimeMs > commitTimeMaxMs) commitTimeMaxMs = commitTimeMs;
+      }
+    #else
+      if (dirty && ((long)(millis() - commitReadyTimeMs) >= 0)) {
+        unsigned long startTimeUs = micros();
+        EEPROM.commit();
+        blockTimeMaxUs = max(blockTimeMaxUs, micros() - startTimeUs);
+        dirty = false;
+      }
     #endif
   }
 
   bool NonVolatileStorageESP::committed() {
-    return !dirty;
+    #if defined(ESP32)
+      return dirtyChunks == 0;
+    #else
+      return !dirty;
+    #endif
   }
 
   uint8_t NonVolatileStorageESP::readFromStorage(uint16_t i) {
-    return EEPROM.read(i);
+    #if defined(ESP32)
+      return image[i];
+    #else
+      return EEPROM.read(i);
+    #endif
   }
 
   void NonVolatileStorageESP::writeToStorage(uint16_t i,  uint8_t j) {
-    EEPROM.write(i, j);
-    dirty = true;
+    #if defined(ESP32)
+      if (image[i] == j) return;
+      image[i] = j;
+      if (dirtyChunks == 0) { commitStartTimeMs = millis(); commitBytes = 0; }
+      bitSet(dirtyChunks, i/NV_ESP_CHUNK_SIZE);
+    #else
+      EEPROM.write(i, j);
+      dirty = true;
+    #endif
   }
 
-#endif
\ No newline at end of file
+  #if defined(ESP32)
+    // copy in the data stored by the EEPROM library (as used before chunked commits) and store it as chunks
+    // before anything else can be written, so a later boot never imports the old data over newer writes
+    void NonVolatileStorageESP::importEEPROM() {
+      memset(image, 0, size);
+
+      bool imported = false;
+      nvs_handle_t handle;
+      if (nvs_open("eeprom", NVS_READWRITE, &handle) == ESP_OK) {
+        size_t length = 0;
+        if (nvs_get_blob(handle, "eeprom", NULL, &length) == ESP_OK && length > 0) {
+          uint8_t *data = new uint8_t[length];
+          if (nvs_get_blob(handle, "eeprom", data, &length) == ESP_OK) {
+            memcpy(image, data, length < size ? length : size);
+            imported = true;
+            VLF("MSG: NV, importing EEPROM library data into chunks");
+          }
+          delete[] data;
+        }
+
+        bool success = true;
+        for (uint8_t c = 0; c < chunkCount && success; c++) {
+          char key[8];
+          sprintf(key, "c%02d", c);
+          success = nvs_set_blob(nvsHandle, key, &image[c*NV_ESP_CHUNK_SIZE], NV_ESP_CHUNK_SIZE) == ESP_OK;
+        }
+        if (success) success = nvs_commit(nvsHandle) == ESP_OK;
+
+        // the old EEPROM library blob goes once its data is safely stored in chunks
+        if (success) {
+          if (imported) { nvs_erase_key(handle, "eeprom"); nvs_commit(handle); }
+          nvs_close(handle);
+          return;
+        }
+        nvs_close(handle);
+      }
+
+      // otherwise the chunks are written out as usual
+      DLF("ERR: NV, storing chunks failed retrying later");
+      commitStartTimeMs = millis();
+      commitBytes = 0;
+      dirtyChunks = chunkCount == 32 ? 0xFFFFFFFFUL : (1UL << chunkCount) - 1;
+    }
+  #endif
+
+#endif
@@ -10,6 +10,13 @@
   #include "NV.h"
   #include "EEPROM.h"
 
+  #if defined(ESP32)
+    // the ESP32 keeps NV in chunks, each stored on its own so a commit never holds off the timers for long
+    #ifndef NV_ESP_CHUNK_SIZE
+      #define NV_ESP_CHUNK_SIZE 128  // in bytes, NV size must be a multiple of this and have no more than 32 chunks
+    #endif
+  #endif
+
   class NonVolatileStorageESP : public NonVolatileStorage {
     public:
       // prepare      FLASH based EEPROM emulation for operation
@@ -35,9 +42,19 @@
       // write value j to position i in storage 
       void writeToStorage(uint16_t i, uint8_t j);  
 
-      bool dirty = false;
+      #if defined(ESP32)
+        // copy in the data stored by the EEPROM library (as used before chunked commits) and store it as chunks
+        void importEEPROM();
+
+        uint32_t nvsHandle = 0;
+        uint8_t *image = NULL;
+        uint8_t chunkCount = 0;
+        uint32_t dirtyChunks = 0;
+      #else
+        bool dirty = false;
+      #endif
   };
 
   #define NVS NonVolatileStorageESP
 
-#endif
\ No newline at end of file
+#endif
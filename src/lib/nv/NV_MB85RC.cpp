@@ -11,10 +11,27 @@
 #define FRAM_WRITE_WAIT 3
 #endif
 
+// FRAM has no pages so writes of any length can start anywhere, this is limited by the Wire buffer (32 bytes
+// on most platforms) less the two address bytes
+#ifndef FRAM_BURST_SIZE
+#define FRAM_BURST_SIZE 30
+#endif
+
+// reads are limited by the Wire buffer only
+#ifndef FRAM_READ_SIZE
+#define FRAM_READ_SIZE 32
+#endif
+
 bool NonVolatileStorageMB85RC::init(uint16_t size, bool cacheEnable, uint16_t wait, bool checkEnable, TwoWire* wire, uint8_t address) {
   // setup size, cache, etc.
   NonVolatileStorage::init(size, cacheEnable, wait, checkEnable, wire, address);
 
+  if (cacheEnable) {
+    pageWriteSize = FRAM_BURST_SIZE;
+    pageBoundaries = false;
+  }
+  pageReadSize = FRAM_READ_SIZE;
+
   this->wire = wire;
   framAddress = address;
   wire->begin();
@@ -56,3 +73,27 @@ void NonVolatileStorageMB85RC::writeToStorage(uint16_t i,  uint8_t j) {
   nextOpMs = millis() + FRAM_WRITE_WAIT;
 }
 
+// write value j of count bytes to position starting at i in storage
+void NonVolatileStorageMB85RC::writePageToStorage(uint16_t i, uint8_t *j, uint8_t count) {
+  while (busy()) {}
+
+  wire->beginTransmission(framAddress);
+  wire->write(MSB(i));
+  wire->write(LSB(i));
+  for (int k = 0; k < count; k++) { wire->write(*j); j++; }
+  wire->endTransmission();
+  nextOpMs = millis() + FRAM_WRITE_WAIT;
+}
+
+// read count bytes starting at position i in storage into j
+void NonVolatileStorageMB85RC::readPageFromStorage(uint16_t i, uint8_t *j, uint8_t count) {
+  while (busy()) {}
+
+  wire->beginTransmission(framAddress);
+  wire->write(MSB(i));
+  wire->write(LSB(i));
+  wire->endTransmission();
+
+  size_t result = wire->requestFrom(framAddress, count);
+  for (uint8_t k = 0; k < count; k++) j[k] = (k < result && wire->available()) ? wire->read() : 0;
+}
@@ -28,6 +28,12 @@ class NonVolatileStorageMB85RC : public NonVolatileStorage {
     // write value j to position i in storage 
     void writeToStorage(uint16_t i, uint8_t j);
 
+    // write value j of count bytes to position starting at i in storage
+    void writePageToStorage(uint16_t i, uint8_t *j, uint8_t count);
+
+    // read count bytes starting at position i in storage into j
+    void readPageFromStorage(uint16_t i, uint8_t *j, uint8_t count);
+
     TwoWire* wire;
     uint8_t framAddress = 0;
     uint32_t nextOpMs = 0;
@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------------
+// non-volatile storage (host simulation, RAM or optionally a file)
+
+#include "NV_SIM.h"
+
+#if defined(ARDUINO_ARCH_SIM)
+
+  #ifdef NV_SIM_FILE
+    #include <stdio.h>
+  #endif
+
+  bool NonVolatileStorageSIM::init(uint16_t size, bool cacheEnable, uint16_t wait, bool checkEnable, TwoWire* wire, uint8_t address) {
+    if (size > NV_SIM_SIZE_MAX) return false;
+
+    // setup size, cache, etc.
+    NonVolatileStorage::init(size, cacheEnable, wait, checkEnable, wire, address);
+
+    // erased state
+    memset(storage, 0xff, sizeof(storage));
+
+    #ifdef NV_SIM_FILE
+      FILE *file = fopen(NV_SIM_FILE, "rb");
+      if (file != NULL) {
+        if (fread(storage, 1, size, file) != size) memset(storage, 0xff, sizeof(storage));
+        fclose(file);
+      }
+    #endif
+
+    return true;
+  }
+
+  void NonVolatileStorageSIM::poll(bool disableInterrupts) {
+    (void)(disableInterrupts);
+
+    if (dirty && ((long)(millis() - commitReadyTimeMs) >= 0)) {
+      #ifdef NV_SIM_FILE
+        FILE *file = fopen(NV_SIM_FILE, "wb");
+        if (file != NULL) {
+          fwrite(storage, 1, size, file);
+          fclose(file);
+        }
+      #endif
+      dirty = false;
+    }
+  }
+
+  bool NonVolatileStorageSIM::committed() {
+    return !dirty;
+  }
+
+  uint8_t NonVolatileStorageSIM::readFromStorage(uint16_t i) {
+    return storage[i];
+  }
+
+  void NonVolatileStorageSIM::writeToStorage(uint16_t i,  uint8_t j) {
+    storage[i] = j;
+    dirty = true;
+  }
+
+#endif
@@ -0,0 +1,50 @@
+// -----------------------------------------------------------------------------------
+// non-volatile storage (host simulation, RAM or optionally a file)
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_SIM)
+
+  #include "NV.h"
+
+  // to keep NV contents between runs of the simulation add:
+  // #define NV_SIM_FILE "onstepx_nv.bin"
+
+  #ifndef NV_SIM_SIZE_MAX
+    #define NV_SIM_SIZE_MAX 32768
+  #endif
+
+  class NonVolatileStorageSIM : public NonVolatileStorage {
+    public:
+      // prepare      RAM based storage for operation, loaded from NV_SIM_FILE if present
+      // size:        NV size in bytes
+      // cacheEnable: enable or disable the cache (note NV size must be divisible by 8 if enabled)
+      // wait:        minimum time in milliseconds to wait (after last write) before writing cache or doing the commit
+      // checkEnable: enable or disable checksum error detection
+      // wire:        I2C interface pointer (set to NULL if not used)
+      // address:     I2C address
+      // result:      true if the device was found, or false if not
+      bool init(uint16_t size, bool cacheEnable, uint16_t wait, bool checkEnable, TwoWire* wire = NULL, uint8_t address = 0);
+
+      // call frequently to perform any operations that need to happen in the background
+      void poll(bool disableInterrupts = true);
+
+      // returns true if all data in any cache has been written
+      bool committed();
+
+    private:
+      // read byte at position i from storage
+      uint8_t readFromStorage(uint16_t i);
+
+      // write value j to position i in storage 
+      void writeToStorage(uint16_t i, uint8_t j);  
+
+      uint8_t storage[NV_SIM_SIZE_MAX];
+      bool dirty = false;
+  };
+
+  #define NVS NonVolatileStorageSIM
+
+#endif
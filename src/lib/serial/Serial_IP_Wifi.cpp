@@ -31,81 +31,132 @@
   }
 
   void IPSerial::end() {
-    if (cmdSvrClient.connected()) {
-      #if DEBUG_CMDSERVER == ON
-        VLF("MSG: end(), STOP cmdSvrClient");
-      #endif
-      cmdSvrClient.stop();
+    for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) {
+      if (clients[i].client.connected()) {
+        #if DEBUG_CMDSERVER == ON
+          VF("MSG: end(), STOP cmdSvrClient "); VL(i);
+        #endif
+        clients[i].client.stop();
+      }
+      clients[i].length = 0;
     }
+    commandLength = 0;
+    commandIndex = 0;
   }
 
   int IPSerial::available(void) {
     if (!active) return 0;
 
-    if (!cmdSvrClient) {
-      if (cmdSvr->hasClient()) {
-        cmdSvrClient = cmdSvr->available();
-        clientEndTimeMs = millis() + clientTimeoutMs;
-      }
-      if (cmdSvrClient) {
-        #if DEBUG_CMDSERVER == ON
-          VLF("MSG: available(), NEW cmdSvrClient");
-        #endif
-      } else return 0;
-    } else {
-      if (!cmdSvrClient.connected()) { 
+    if (commandIndex >= commandLength) {
+      pollClients();
+      if (!nextCommand()) return 0;
+    }
+
+    return commandLength - commandIndex;
+  }
+
+  void IPSerial::pollClients() {
+    while (cmdSvr->hasClient()) {
+      int i;
+      for (i = 0; i < SERIAL_SERVER_CLIENTS; i++) if (!clients[i].client) break;
+      if (i >= SERIAL_SERVER_CLIENTS) {
         #if DEBUG_CMDSERVER == ON
-          VLF("MSG: available(), not connected STOP cmdSvrClient");
+          VLF("MSG: available(), no room REJECT new cmdSvrClient");
         #endif
-        cmdSvrClient.stop();
-        return 0;
+        cmdSvr->available().stop();
+        break;
       }
-      if ((long)(clientEndTimeMs - millis()) < 0) {
+      clients[i].client = cmdSvr->available();
+      clients[i].length = 0;
+      clients[i].endTimeMs = millis() + clientTimeoutMs;
+      clients[i].connection++;
+      #if DEBUG_CMDSERVER == ON
+        VF("MSG: available(), NEW cmdSvrClient "); VL(i);
+      #endif
+    }
+
+    for (int i = 0; i < SERIAL_SERVER_CLIENTS; i++) {
+      IPSerialClient *c = &clients[i];
+      if (!c->client) continue;
+
+      if (!c->client.connected() || (long)(c->endTimeMs - millis()) < 0) {
         #if DEBUG_CMDSERVER == ON
-          VLF("MSG: available(), timed out STOP cmdSvrClient");
+          VF("MSG: available(), closed or timed out STOP cmdSvrClient "); VL(i);
         #endif
-        cmdSvrClient.stop();
-        return 0;
+        c->client.stop();
+        c->length = 0;
+        continue;
       }
+
+      // read what fits, the rest waits at the client until commands are taken from the buffer, only
+      // a full buffer without a complete command is junk
+      int count = c->client.available();
+      if (count <= 0) continue;
+      if (c->length >= IP_CLIENT_BUFFER_SIZE) { if (commandEnd(c) > 0) continue; c->length = 0; }
+      if (count > IP_CLIENT_BUFFER_SIZE - c->length) count = IP_CLIENT_BUFFER_SIZE - c->length;
+      c->length += c->client.read((uint8_t *)&c->buffer[c->length], count);
     }
+  }
 
-    int i = cmdSvrClient.available();
+  int IPSerial::commandEnd(IPSerialClient *c) {
+    // a command ends with '#', or is the single ACK character
+    for (int end = 0; end < c->length; end++) if (c->buffer[end] == '#' || c->buffer[end] == (char)6) return end + 1;
+    return 0;
+  }
 
-    #if DEBUG_CMDSERVER == ON
-      if (i > 0) { VF("MSG: available(), recv. buffer has "); V(i); VLF(" chars"); }
-    #endif
+  bool IPSerial::nextCommand() {
+    for (int k = 1; k <= SERIAL_SERVER_CLIENTS; k++) {
+      int i = (current + k) % SERIAL_SERVER_CLIENTS;
+      IPSerialClient *c = &clients[i];
+      if (!c->client || c->length == 0) continue;
+
+      int end = commandEnd(c);
+      if (end == 0) continue;
+
+      memcpy(command, c->buffer, end);
+      commandLength = end;
+      commandIndex = 0;
+      c->length -= end;
+      memmove(c->buffer, &c->buffer[end], c->length);
 
-    return i;
+      current = i;
+      #if DEBUG_CMDSERVER == ON
+        VF("MSG: available(), cmdSvrClient "); V(i); VF(" has a command of "); V(end); VLF(" chars");
+      #endif
+      return true;
+    }
+    return false;
   }
 
   int IPSerial::peek(void) {
-    if (!active || !cmdSvrClient) return -1;
-    return cmdSvrClient.peek();
+    if (!active || commandIndex >= commandLength) return -1;
+    return command[commandIndex];
   }
 
   void IPSerial::flush(void) {
-    if (!active || !cmdSvrClient) return;
-    cmdSvrClient.flush();
+    if (!active || !clients[current].client) return;
+    clients[current].client.flush();
   }
 
   int IPSerial::read(void) {
-    if (!active || !cmdSvrClient) return -1;
-    if (persist) clientEndTimeMs = millis() + clientTimeoutMs;
-    int c = cmdSvrClient.read();
+    if (!active || commandIndex >= commandLength) return -1;
+    if (persist) clients[current].endTimeMs = millis() + clientTimeoutMs;
+    int c = command[commandIndex++];
     #if DEBUG_CMDSERVER == ON
       VF("MSG: read(), found: "); VL((char)c);
     #endif
     return c;
   }
 
+  // replies go to the client whose command was read last, or the one given by setClient()
   size_t IPSerial::write(uint8_t data) {
-    if (!active || !cmdSvrClient) return 0;
-    return cmdSvrClient.write(data);
+    if (!active || !clients[current].client) return 0;
+    return clients[current].client.write(data);
   }
 
   size_t IPSerial::write(const uint8_t *data, size_t count) {
-    if (!active || !cmdSvrClient) return 0;
-    return cmdSvrClient.write(data, count);
+    if (!active || !clients[current].client) return 0;
+    return clients[current].client.write(data, count);
   }
 
   #if SERIAL_SERVER == STANDARD || SERIAL_SERVER == BOTH
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------------
-// Polling serial IP for ESP32
+// Polling serial IP for ESP32, serves several clients per port one complete command at a time
 #pragma once
 
 #include "../../Common.h"
@@ -15,10 +15,23 @@
     #include <ESP8266WiFi.h>
     #include <WiFiClient.h>
     #include <ESP8266WiFiAP.h>
+  #elif defined(ARDUINO_ARCH_SIM)
+    #include <WiFi.h>
   #else
     #error "Configuration (Config.h): No Wifi support is present for this device"
   #endif
 
+  // room for the longest command plus some of the next
+  #define IP_CLIENT_BUFFER_SIZE 64
+
+  typedef struct IPSerialClient {
+    WiFiClient client;
+    char buffer[IP_CLIENT_BUFFER_SIZE];
+    uint8_t length;
+    unsigned long endTimeMs;
+    uint8_t connection;      // counts clients accepted into this slot
+  } IPSerialClient;
+
   class IPSerial : public Stream {
     public:
       void begin(long port, unsigned long clientTimeoutMs = 2000, bool persist = false);
@@ -44,13 +57,36 @@
 
       using Print::write;
 
+      // the client the last command was read from
+      inline uint8_t getClient() { return current; }
+
+      // sends writes to the given client, until the next command is read
+      inline void setClient(uint8_t client) { if (client < SERIAL_SERVER_CLIENTS) current = client; }
+
+      // a number that changes each time a new client takes the given client's place
+      inline uint8_t getConnection(uint8_t client) { return client < SERIAL_SERVER_CLIENTS ? clients[client].connection : 0; }
+
     private:
+      // accept new clients, drop closed or timed out ones, and read what has arrived from the others
+      void pollClients();
+
+      // length of the first complete command in a client's buffer, 0 if there isn't one
+      int commandEnd(IPSerialClient *c);
+
+      // take the next complete command, going round the clients in turn
+      bool nextCommand();
+
       WiFiServer *cmdSvr;
-      WiFiClient cmdSvrClient;
+      IPSerialClient clients[SERIAL_SERVER_CLIENTS];
+      int current = 0;
+
+      // the command being handed to read()
+      char command[IP_CLIENT_BUFFER_SIZE];
+      uint8_t commandLength = 0;
+      uint8_t commandIndex = 0;
 
       int port = -1;
       unsigned long clientTimeoutMs;
-      unsigned long clientEndTimeMs = 0;
       bool active = false;
       bool persist = false;
   };
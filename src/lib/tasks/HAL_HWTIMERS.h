@@ -42,6 +42,8 @@
   #include "HAL_TEENSY_HWTIMER.h"
 #elif defined(ESP32)
   #include "HAL_ESP32_HWTIMER.h"
+#elif defined(ARDUINO_ARCH_SIM)
+  #include "HAL_SIM_HWTIMER.h"
 #else
   #include "HAL_EMPTY_HWTIMER.h"
 #endif
@@ -34,6 +34,68 @@
     total_runtime_count++; \
     if (labs(at) > max_runtime) max_runtime = labs(at);
 
+#elif defined(TASKS_PROFILER_STATS_ENABLE)
+  // low overhead profiler, integer accumulators and log2 histograms, cheap enough to leave running
+  #if defined(ESP32) && !defined(ARDUINO_ESP32C3_DEV)
+    #include "xtensa/core-macros.h"
+    #define TASKS_PROFILER_TICKS() xthal_get_ccount()
+    unsigned long tasksProfilerTicksPerMicro() { return getCpuFrequencyMhz(); }
+  #elif defined(__IMXRT1062__)
+    #define TASKS_PROFILER_TICKS() ARM_DWT_CYCCNT
+    unsigned long tasksProfilerTicksPerMicro() { return F_CPU_ACTUAL/1000000UL; }
+  #else
+    #define TASKS_PROFILER_TICKS() micros()
+    unsigned long tasksProfilerTicksPerMicro() { return 1; }
+  #endif
+
+  // ticks to (approximate) microseconds as a right shift, for binning runtimes without a divide
+  uint8_t _task_profiler_shift = 0;
+
+  TaskProfile _task_hw_profile[4];
+
+  // histogram bin for a value in microseconds
+  IRAM_ATTR inline uint8_t _task_profiler_bin(unsigned long us) {
+    if (us == 0) return 0;
+    uint8_t bin = sizeof(unsigned long)*8 - __builtin_clzl(us);
+    return bin < TASKS_PROFILER_BINS ? bin : TASKS_PROFILER_BINS - 1;
+  }
+
+  IRAM_ATTR inline void _task_profiler_run(TaskProfile *profile, unsigned long ticks) {
+    profile->runs++;
+    profile->runTotal += ticks;
+    if (ticks > profile->runMax) { profile->runMax = ticks; profile->runMaxTime = millis(); }
+    uint16_t *bin = &profile->runHist[_task_profiler_bin(ticks >> _task_profiler_shift)];
+    if (*bin != 0xffff) (*bin)++;
+  }
+
+  #ifdef TASKS_HWTIMER1_ENABLE
+    #define TASKS_HWTIMER1_PROFILER_PREFIX unsigned long runtime_t0 = TASKS_PROFILER_TICKS()
+    #define TASKS_HWTIMER1_PROFILER_SUFFIX _task_profiler_run(&_task_hw_profile[0], TASKS_PROFILER_TICKS() - runtime_t0)
+  #endif
+  #ifdef TASKS_HWTIMER2_ENABLE
+    #define TASKS_HWTIMER2_PROFILER_PREFIX unsigned long runtime_t0 = TASKS_PROFILER_TICKS()
+    #define TASKS_HWTIMER2_PROFILER_SUFFIX _task_profiler_run(&_task_hw_profile[1], TASKS_PROFILER_TICKS() - runtime_t0)
+  #endif
+  #ifdef TASKS_HWTIMER3_ENABLE
+    #define TASKS_HWTIMER3_PROFILER_PREFIX unsigned long runtime_t0 = TASKS_PROFILER_TICKS()
+    #define TASKS_HWTIMER3_PROFILER_SUFFIX _task_profiler_run(&_task_hw_profile[2], TASKS_PROFILER_TICKS() - runtime_t0)
+  #endif
+  #ifdef TASKS_HWTIMER4_ENABLE
+    #define TASKS_HWTIMER4_PROFILER_PREFIX unsigned long runtime_t0 = TASKS_PROFILER_TICKS()
+    #define TASKS_HWTIMER4_PROFILER_SUFFIX _task_profiler_run(&_task_hw_profile[3], TASKS_PROFILER_TICKS() - runtime_t0)
+  #endif
+
+  // lateness is counted from the earliest time the task could have run
+  #define TASKS_PROFILER_PREFIX \
+    unsigned long late = -time_to_next_task - 1; \
+    if (period_units != PU_MICROS) late *= 1000UL; \
+    profile.lateTotal += late; \
+    if (late > profile.lateMax) { profile.lateMax = late; profile.lateMaxTime = millis(); } \
+    { uint16_t *bin = &profile.lateHist[_task_profiler_bin(late)]; if (*bin != 0xffff) (*bin)++; } \
+    unsigned long runtime_t0 = TASKS_PROFILER_TICKS();
+  #define TASKS_PROFILER_SUFFIX \
+    _task_profiler_run(&profile, TASKS_PROFILER_TICKS() - runtime_t0);
+
 #else
   #define TASKS_HWTIMER1_PROFILER_PREFIX
   #define TASKS_HWTIMER1_PROFILER_SUFFIX
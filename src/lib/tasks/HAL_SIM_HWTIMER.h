@@ -0,0 +1,202 @@
+//--------------------------------------------------------------------------------------------------
+// Host simulation virtual clock and hardware timers
+
+// the virtual clock only moves when simAdvance() is called (from the Arduino core stand-in's yield()
+// and delay() for instance) and the virtual timers fire in order, at the exact sub-microsecond
+// they come due, so a simulation run is fully deterministic
+
+#define TIMER_RATE_MHZ 16L                           // virtual timers run at 16MHz so use full resolution
+#define TIMER_RATE_16MHZ_TICKS 1L                    // 16L/TIMER_RATE_MHZ, for the default 16MHz "sub-micros" (16MHz)
+
+// virtual clock in sub-microseconds (1/16us)
+volatile uint64_t _simClock = 0;
+
+unsigned long simMillis() { return (unsigned long)(_simClock/16000ULL); }
+unsigned long simMicros() { return (unsigned long)(_simClock/16ULL); }
+
+#if defined(TASKS_HWTIMER1_ENABLE) || defined(TASKS_HWTIMER2_ENABLE) || defined(TASKS_HWTIMER3_ENABLE) || defined(TASKS_HWTIMER4_ENABLE)
+  // prepare hw timer for interval in sub-microseconds (1/16us)
+  volatile uint32_t _nextPeriod1 = 16000, _nextPeriod2 = 16000, _nextPeriod3 = 16000, _nextPeriod4 = 16000;
+  volatile uint16_t _nextRep1 = 0, _nextRep2 = 0, _nextRep3 = 0, _nextRep4 = 0;
+  void HAL_HWTIMER_PREPARE_PERIOD(uint8_t num, unsigned long period) {
+    // maximum time is about 134 seconds for this design
+    uint32_t counts, reps = 0;
+    if (period != 0 && period <= 2144000000) {
+      if (period < 16) period = 16;   // minimum time is 1us
+      period /= TIMER_RATE_16MHZ_TICKS;
+      reps    = 1;
+      counts  = period;
+    } else counts = 16000;            // set for a 1ms period, stopped
+  
+    noInterrupts();
+    switch (num) {
+      case 1: _nextPeriod1 = counts; _nextRep1 = reps; break;
+      case 2: _nextPeriod2 = counts; _nextRep2 = reps; break;
+      case 3: _nextPeriod3 = counts; _nextRep3 = reps; break;
+      case 4: _nextPeriod4 = counts; _nextRep4 = reps; break;
+    }
+    interrupts();
+  }
+#else
+  void HAL_HWTIMER_PREPARE_PERIOD(uint8_t num, unsigned long period) { (void)(num); (void)(period); }
+#endif
+
+#ifdef TASKS_HWTIMER1_ENABLE
+  bool _timerRunning1 = false;
+  uint32_t _timerPeriod1 = 16000;
+  uint64_t _timerNext1 = 0;
+
+  void (*HAL_HWTIMER1_FUN)() = NULL; // points to task/process callback function
+  void HAL_HWTIMER1_WRAPPER(void);   // forward definition of the timer ISR
+
+  bool HAL_HWTIMER1_INIT(uint8_t priority) {
+    (void)(priority);
+    _timerPeriod1 = 16000;           // startup one millisecond
+    _timerNext1 = _simClock + _timerPeriod1;
+    _timerRunning1 = true;
+    return true;
+  }
+
+  void HAL_HWTIMER1_DONE() {
+    HAL_HWTIMER1_FUN = NULL;
+    _timerRunning1 = false;
+  }
+
+  #define HAL_HWTIMER1_SET_PERIOD() _timerPeriod1 = _nextPeriod1
+  void HAL_HWTIMER1_WRAPPER() {
+    TASKS_HWTIMER1_PROFILER_PREFIX;
+    if (_nextRep1) HAL_HWTIMER1_FUN();
+    HAL_HWTIMER1_SET_PERIOD();
+    TASKS_HWTIMER1_PROFILER_SUFFIX;
+  }
+#endif
+
+#ifdef TASKS_HWTIMER2_ENABLE
+  bool _timerRunning2 = false;
+  uint32_t _timerPeriod2 = 16000;
+  uint64_t _timerNext2 = 0;
+
+  void (*HAL_HWTIMER2_FUN)() = NULL; // points to task/process callback function
+  void HAL_HWTIMER2_WRAPPER(void);   // forward definition of the timer ISR
+
+  bool HAL_HWTIMER2_INIT(uint8_t priority) {
+    (void)(priority);
+    _timerPeriod2 = 16000;           // startup one millisecond
+    _timerNext2 = _simClock + _timerPeriod2;
+    _timerRunning2 = true;
+    return true;
+  }
+
+  void HAL_HWTIMER2_DONE() {
+    HAL_HWTIMER2_FUN = NULL;
+    _timerRunning2 = false;
+  }
+
+  #define HAL_HWTIMER2_SET_PERIOD() _timerPeriod2 = _nextPeriod2
+  void HAL_HWTIMER2_WRAPPER() {
+    TASKS_HWTIMER2_PROFILER_PREFIX;
+    if (_nextRep2) HAL_HWTIMER2_FUN();
+    HAL_HWTIMER2_SET_PERIOD();
+    TASKS_HWTIMER2_PROFILER_SUFFIX;
+  }
+#endif
+
+#ifdef TASKS_HWTIMER3_ENABLE
+  bool _timerRunning3 = false;
+  uint32_t _timerPeriod3 = 16000;
+  uint64_t _timerNext3 = 0;
+
+  void (*HAL_HWTIMER3_FUN)() = NULL; // points to task/process callback function
+  void HAL_HWTIMER3_WRAPPER(void);   // forward definition of the timer ISR
+
+  bool HAL_HWTIMER3_INIT(uint8_t priority) {
+    (void)(priority);
+    _timerPeriod3 = 16000;           // startup one millisecond
+    _timerNext3 = _simClock + _timerPeriod3;
+    _timerRunning3 = true;
+    return true;
+  }
+
+  void HAL_HWTIMER3_DONE() {
+    HAL_HWTIMER3_FUN = NULL;
+    _timerRunning3 = false;
+  }
+
+  #define HAL_HWTIMER3_SET_PERIOD() _timerPeriod3 = _nextPeriod3
+  void HAL_HWTIMER3_WRAPPER() {
+    TASKS_HWTIMER3_PROFILER_PREFIX;
+    if (_nextRep3) HAL_HWTIMER3_FUN();
+    HAL_HWTIMER3_SET_PERIOD();
+    TASKS_HWTIMER3_PROFILER_SUFFIX;
+  }
+#endif
+
+#ifdef TASKS_HWTIMER4_ENABLE
+  bool _timerRunning4 = false;
+  uint32_t _timerPeriod4 = 16000;
+  uint64_t _timerNext4 = 0;
+
+  void (*HAL_HWTIMER4_FUN)() = NULL; // points to task/process callback function
+  void HAL_HWTIMER4_WRAPPER(void);   // forward definition of the timer ISR
+
+  bool HAL_HWTIMER4_INIT(uint8_t priority) {
+    (void)(priority);
+    _timerPeriod4 = 16000;           // startup one millisecond
+    _timerNext4 = _simClock + _timerPeriod4;
+    _timerRunning4 = true;
+    return true;
+  }
+
+  void HAL_HWTIMER4_DONE() {
+    HAL_HWTIMER4_FUN = NULL;
+    _timerRunning4 = false;
+  }
+
+  #define HAL_HWTIMER4_SET_PERIOD() _timerPeriod4 = _nextPeriod4
+  void HAL_HWTIMER4_WRAPPER() {
+    TASKS_HWTIMER4_PROFILER_PREFIX;
+    if (_nextRep4) HAL_HWTIMER4_FUN();
+    HAL_HWTIMER4_SET_PERIOD();
+    TASKS_HWTIMER4_PROFILER_SUFFIX;
+  }
+#endif
+
+// advance the virtual clock by subMicros (1/16us) firing the timers as they come due
+void simAdvance(unsigned long subMicros) {
+  uint64_t target = _simClock + subMicros;
+  while (true) {
+    // find the timer that comes due first, lower numbered timers first when they are simultaneous
+    uint8_t next = 0;
+    uint64_t nextTime = target;
+    #ifdef TASKS_HWTIMER1_ENABLE
+      if (_timerRunning1 && _timerNext1 <= nextTime) { next = 1; nextTime = _timerNext1; }
+    #endif
+    #ifdef TASKS_HWTIMER2_ENABLE
+      if (_timerRunning2 && (_timerNext2 < nextTime || (next == 0 && _timerNext2 == nextTime))) { next = 2; nextTime = _timerNext2; }
+    #endif
+    #ifdef TASKS_HWTIMER3_ENABLE
+      if (_timerRunning3 && (_timerNext3 < nextTime || (next == 0 && _timerNext3 == nextTime))) { next = 3; nextTime = _timerNext3; }
+    #endif
+    #ifdef TASKS_HWTIMER4_ENABLE
+      if (_timerRunning4 && (_timerNext4 < nextTime || (next == 0 && _timerNext4 == nextTime))) { next = 4; nextTime = _timerNext4; }
+    #endif
+    if (next == 0) break;
+
+    _simClock = nextTime;
+    switch (next) {
+      #ifdef TASKS_HWTIMER1_ENABLE
+        case 1: HAL_HWTIMER1_WRAPPER(); _timerNext1 = nextTime + _timerPeriod1; break;
+      #endif
+      #ifdef TASKS_HWTIMER2_ENABLE
+        case 2: HAL_HWTIMER2_WRAPPER(); _timerNext2 = nextTime + _timerPeriod2; break;
+      #endif
+      #ifdef TASKS_HWTIMER3_ENABLE
+        case 3: HAL_HWTIMER3_WRAPPER(); _timerNext3 = nextTime + _timerPeriod3; break;
+      #endif
+      #ifdef TASKS_HWTIMER4_ENABLE
+        case 4: HAL_HWTIMER4_WRAPPER(); _timerNext4 = nextTime + _timerPeriod4; break;
+      #endif
+    }
+  }
+  _simClock = target;
+}
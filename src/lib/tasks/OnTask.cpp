@@ -54,6 +54,9 @@ Task::Task(uint32_t period, uint32_t duration, bool repeat, uint8_t priority, vo
   start_time     = millis();
   next_task_time = start_time + period;
   strcpy(processName, "");
+  #ifdef TASKS_PROFILER_STATS_ENABLE
+    memset(&profile, 0, sizeof(TaskProfile));
+  #endif
 }
 
 Task::~Task() {
@@ -145,8 +148,10 @@ void Task::setTimingMode(TimingMode mode) {
 }
 
 bool Task::poll() {
-  if (hardware_timer || running) return false;
+  if (hardware_timer) { wait_micros = TASKS_WAIT_MAX; return false; }
+  if (running) { wait_micros = 0; return false; }
 
+  wait_micros = TASKS_WAIT_MAX;
   if (period != 0) {
     unsigned long t, time_to_next_task;
 
@@ -163,6 +168,9 @@ bool Task::poll() {
     
       running = false;
 
+      // check again on the next pass
+      wait_micros = 0;
+
       if (_task_postpone) { _task_postpone = false; return false; }
 
       // set timing for guaranteed minimum (or gap) period
@@ -187,9 +195,21 @@ bool Task::poll() {
       #endif
       next_task_time = t + (long)(period + time_to_next_task);
       if (!repeat) period = 0;
+    } else {
+      if (period_units != PU_MICROS) {
+        if (time_to_next_task < TASKS_WAIT_MAX/1000UL) time_to_next_task *= 1000UL; else time_to_next_task = TASKS_WAIT_MAX;
+      }
+      if (time_to_next_task < wait_micros) wait_micros = time_to_next_task;
     }
   } else immediate = true;
 
+  // the task must also be checked when its duration completes (right away if that's already passed)
+  if (duration > 0 && wait_micros > 0) {
+    long time_to_complete = (long)((start_time + duration) - millis());
+    if (time_to_complete <= 0) wait_micros = 0; else
+    if ((unsigned long)time_to_complete < wait_micros/1000UL) wait_micros = time_to_complete*1000UL;
+  }
+
   return false;
 }
 
@@ -315,6 +335,16 @@ float Task::getRuntimeMax() {
 }
 #endif
 
+#ifdef TASKS_PROFILER_STATS_ENABLE
+void Task::getProfile(TaskProfile *profile) {
+  if (hardware_timer) { noInterrupts(); *profile = _task_hw_profile[hardware_timer - 1]; interrupts(); } else *profile = this->profile;
+}
+void Task::clearProfile() {
+  if (hardware_timer) { noInterrupts(); memset(&_task_hw_profile[hardware_timer - 1], 0, sizeof(TaskProfile)); interrupts(); }
+  memset(&profile, 0, sizeof(TaskProfile));
+}
+#endif
+
 void Task::setHardwareTimerPeriod() {
   // adopt next period
   if (next_period_units != PU_NONE) {
@@ -361,6 +391,16 @@ Tasks::Tasks() {
     task[c] = NULL;
     allocated[c] = false;
   }
+  for (uint8_t p = 0; p < 8; p++) {
+    wake_time[p] = 0;
+    wake_time_serial[p] = wake_serial - 1;
+  }
+
+  #ifdef TASKS_PROFILER_STATS_ENABLE
+    // the power of two nearest the profiler ticks per microsecond
+    unsigned long ticksPerMicro = tasksProfilerTicksPerMicro();
+    while ((2UL << _task_profiler_shift) <= ticksPerMicro + (ticksPerMicro >> 1)) _task_profiler_shift++;
+  #endif
 
   // start the task monitor
   tasks.add(1000, 0, true, 7, tasksMonitor, "TaskMtr");
@@ -391,6 +431,7 @@ uint8_t Tasks::add(uint32_t period, uint32_t duration, bool repeat, uint8_t prio
   if (task[e] != NULL) allocated[e] = true; else return false;
 
   updateEventRange();
+  updateBuckets();
   return e + 1;
 }
 
@@ -409,6 +450,7 @@ bool Tasks::requestHardwareTimer(uint8_t handle, uint8_t hwPriority) {
     for (int num = 0; num < TASKS_HWTIMERS; num++) {
       if (!hardware_timer_allocated[num]) {
         hardware_timer_allocated[num] = task[handle - 1]->requestHardwareTimer(num + 1, hwPriority);
+        if (hardware_timer_allocated[num]) updateBuckets();
         return hardware_timer_allocated[num];
       }
     }
@@ -436,6 +478,7 @@ void Tasks::remove(uint8_t handle) {
     allocated[handle - 1] = false;
     updateEventRange();
     updatePriorityRange();
+    updateBuckets();
   }
 }
 
@@ -448,24 +491,28 @@ void Tasks::refreshPeriod(uint8_t handle) {
 void Tasks::setPeriod(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period);
+    if (!task[handle - 1]->hardware_timer) wake_serial++;
   }
 }
 
 void Tasks::setPeriodMicros(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period, PU_MICROS);
+    if (!task[handle - 1]->hardware_timer) wake_serial++;
   }
 }
 
 void Tasks::setPeriodSubMicros(uint8_t handle, unsigned long period) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setPeriod(period, PU_SUB_MICROS);
+    if (!task[handle - 1]->hardware_timer) wake_serial++;
   }
 }
 
 void Tasks::setFrequency(uint8_t handle, double freq) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setFrequency(freq);
+    if (!task[handle - 1]->hardware_timer) wake_serial++;
   }
 }
 
@@ -476,18 +523,21 @@ IRAM_ATTR void Tasks::setPeriodRatioSubMicros(unsigned long value) {
 void Tasks::setDuration(uint8_t handle, unsigned long duration) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setDuration(duration);
+    wake_serial++;
   }
 }
 
 void Tasks::setDurationComplete(uint8_t handle) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setDurationComplete();
+    wake_serial++;
   }
 }
 
 void Tasks::setRepeat(uint8_t handle, bool repeat) {
   if (handle != 0 && allocated[handle - 1]) {
     task[handle - 1]->setRepeat(repeat);
+    wake_serial++;
   }
 }
 
@@ -497,6 +547,7 @@ void Tasks::setPriority(uint8_t handle, uint8_t priority) {
     task[handle - 1]->setPriority(priority);
     updateEventRange();
     updatePriorityRange();
+    updateBuckets();
   }
 }
 
@@ -569,38 +620,72 @@ uint8_t Tasks::getHandleByName(const char name[]) {
   }
 #endif
 
+#ifdef TASKS_PROFILER_STATS_ENABLE
+  bool Tasks::getProfile(uint8_t handle, TaskProfile *profile) {
+    if (handle != 0 && allocated[handle - 1]) {
+      task[handle - 1]->getProfile(profile);
+      return true;
+    } else return false;
+  }
+  void Tasks::clearProfiles() {
+    for (uint8_t e = 0; e <= highest_task; e++) {
+      if (allocated[e]) task[e]->clearProfile();
+    }
+  }
+#endif
+
 #ifdef TASKS_HIGHER_PRIORITY_ONLY
   void Tasks::yield() {
     ::yield();
+    unsigned long now = micros();
     for (uint8_t priority = 0; priority <= highest_priority; priority++) {
       uint8_t last_priority = highest_active_priority;
       if (priority < highest_active_priority) {
+        // skip this level if none of its tasks can be due yet
+        uint32_t serial = wake_serial;
+        if (wake_time_serial[priority] == serial && (long)(now - wake_time[priority]) < 0) continue;
+
         highest_active_priority = priority;
-        for (uint8_t i = 0; i <= highest_task; i++) {
-          if (++number[priority] > highest_task) number[priority] = 0;
-          if (allocated[number[priority]]) {
-            if (task[number[priority]]->getPriority() == priority) {
-              if (task[number[priority]]->isDurationComplete()) { remove(number[priority] + 1); highest_active_priority = last_priority; return; }
-              if (task[number[priority]]->poll()) { highest_active_priority = last_priority; return; }
+        unsigned long wait = TASKS_WAIT_MAX;
+        for (uint8_t i = 0; i < bucket_start[priority + 1] - bucket_start[priority]; i++) {
+          if (++number[priority] >= bucket_start[priority + 1] - bucket_start[priority]) number[priority] = 0;
+          uint8_t e = bucket[bucket_start[priority] + number[priority]];
+          if (allocated[e]) {
+            if (task[e]->getPriority() == priority) {
+              if (task[e]->isDurationComplete()) { remove(e + 1); highest_active_priority = last_priority; return; }
+              if (task[e]->poll()) { highest_active_priority = last_priority; return; }
+              if (task[e]->getWaitMicros() < wait) wait = task[e]->getWaitMicros();
             }
           }
         }
         highest_active_priority = last_priority;
+
+        if (wake_serial == serial) { wake_time[priority] = now + wait; wake_time_serial[priority] = serial; }
       }
     }
   }
 #else
   void Tasks::yield() {
+    unsigned long now = micros();
     for (uint8_t priority = 0; priority <= highest_priority; priority++) {
-      for (uint8_t i = 0; i <= highest_task; i++) {
-        if (++number[priority] > highest_task) number[priority] = 0;
-        if (allocated[number[priority]]) {
-          if (task[number[priority]]->getPriority() == priority) {
-            if (task[number[priority]]->isDurationComplete()) { remove(number[priority] + 1); return; }
-            if (task[number[priority]]->poll()) return;
+      // skip this level if none of its tasks can be due yet
+      uint32_t serial = wake_serial;
+      if (wake_time_serial[priority] == serial && (long)(now - wake_time[priority]) < 0) continue;
+
+      unsigned long wait = TASKS_WAIT_MAX;
+      for (uint8_t i = 0; i < bucket_start[priority + 1] - bucket_start[priority]; i++) {
+        if (++number[priority] >= bucket_start[priority + 1] - bucket_start[priority]) number[priority] = 0;
+        uint8_t e = bucket[bucket_start[priority] + number[priority]];
+        if (allocated[e]) {
+          if (task[e]->getPriority() == priority) {
+            if (task[e]->isDurationComplete()) { remove(e + 1); return; }
+            if (task[e]->poll()) return;
+            if (task[e]->getWaitMicros() < wait) wait = task[e]->getWaitMicros();
           }
         }
       }
+
+      if (wake_serial == serial) { wake_time[priority] = now + wait; wake_time_serial[priority] = serial; }
     }
   }
 #endif
@@ -635,4 +720,17 @@ void Tasks::updateEventRange() {
   }
 }
 
+void Tasks::updateBuckets() {
+  // group the allocated software timed tasks by priority, hardware timed tasks are never polled
+  uint8_t count = 0;
+  for (uint8_t p = 0; p < 8; p++) {
+    bucket_start[p] = count;
+    for (uint8_t e = 0; e <= highest_task; e++) {
+      if (allocated[e] && !task[e]->hardware_timer && task[e]->getPriority() == p) bucket[count++] = e;
+    }
+  }
+  bucket_start[8] = count;
+  wake_serial++;
+}
+
 Tasks tasks;
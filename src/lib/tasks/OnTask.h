@@ -62,6 +62,11 @@
   #define TASKS_MAX 8
 #endif
 
+// longest time (in microseconds) a priority level can be skipped over by yield() without checking its tasks
+#ifndef TASKS_WAIT_MAX
+  #define TASKS_WAIT_MAX 1000000UL
+#endif
+
 // default is to allow only higher priority tasks to run during a yield()
 // comment out and any task can run except the task that yields
 #define TASKS_HIGHER_PRIORITY_ONLY
@@ -84,6 +89,14 @@
   extern void timerAlarmsEnable();
 #endif
 
+// host simulation virtual clock, the Arduino core stand-in's millis()/micros() return simMillis()/simMicros()
+#ifdef ARDUINO_ARCH_SIM
+  extern unsigned long simMillis();
+  extern unsigned long simMicros();
+  // advance the virtual clock by the given sub-microseconds (1/16us) running any h/w timers that come due
+  extern void simAdvance(unsigned long subMicros);
+#endif
+
 // short Y macro to embed yield()
 #define Y tasks.yield()
 
@@ -94,6 +107,26 @@ extern unsigned char __task_postpone;
 
 enum PeriodUnits: uint8_t {PU_NONE, PU_MILLIS, PU_MICROS, PU_SUB_MICROS};
 
+#ifdef TASKS_PROFILER_STATS_ENABLE
+  // low overhead profiler statistics, runtimes are in profiler clock ticks (CPU cycles where available)
+  // histogram bin 0 holds values < 1us and bin n holds values from 2^(n-1) to 2^n us, the last bin holds anything longer
+  #define TASKS_PROFILER_BINS 16
+  typedef struct TaskProfile {
+    unsigned long runs;
+    unsigned long lateMax;                     // in microseconds
+    unsigned long lateMaxTime;                 // millis() when lateMax occurred
+    unsigned long runMax;                      // in ticks
+    unsigned long runMaxTime;                  // millis() when runMax occurred
+    uint64_t      lateTotal;                   // in microseconds
+    uint64_t      runTotal;                    // in ticks
+    uint16_t      lateHist[TASKS_PROFILER_BINS];
+    uint16_t      runHist[TASKS_PROFILER_BINS];
+  } TaskProfile;
+
+  // profiler clock ticks per microsecond
+  extern unsigned long tasksProfilerTicksPerMicro();
+#endif
+
 // Timing modes
 // TM_BALANCED (default) to maintain the specified frequency/period where a task that runs late is next run early to compensate
 // TM_MINIMUM to run the task at an interval not less than the specified frequency/period from task start to next start
@@ -117,6 +150,9 @@ class Task {
     //       the task occurs late the next call is scheduled earlier to make up the difference
     bool poll();
 
+    // microseconds until this task could next be due, as of the last poll()
+    inline unsigned long getWaitMicros() { return wait_micros; }
+
     void refreshPeriod();
     void setPeriod(unsigned long period, PeriodUnits units = PU_MILLIS);
     void setFrequency(float freq);
@@ -141,6 +177,12 @@ class Task {
       float getRuntimeMax();
     #endif
 
+    #ifdef TASKS_PROFILER_STATS_ENABLE
+      // copies the profiler statistics for this task
+      void getProfile(TaskProfile *profile);
+      void clearProfile();
+    #endif
+
     volatile bool immediate = true;
 
   private:
@@ -160,9 +202,14 @@ class Task {
     unsigned long          start_time        = 0;
     unsigned long          last_task_time    = 0;
     unsigned long          next_task_time    = 0;
+    unsigned long          wait_micros       = 0;
     TimingMode             timingMode        = TM_BALANCED;
     void (*volatile callback)() = NULL;
 
+    #ifdef TASKS_PROFILER_STATS_ENABLE
+      TaskProfile            profile;
+    #endif
+
     #ifdef TASKS_PROFILER_ENABLE
       volatile double        average_arrival_time       = 0;
       volatile unsigned long average_arrival_time_count = 0;
@@ -273,7 +320,7 @@ class Tasks {
     IRAM_ATTR void setPeriodRatioSubMicros(unsigned long value);
 
     // set process to run immediately on the next pass (within its priority level)
-    IRAM_ATTR inline void immediate(uint8_t handle) { if (handle != 0 && allocated[handle - 1]) { task[handle - 1]->immediate = true; } }
+    IRAM_ATTR inline void immediate(uint8_t handle) { if (handle != 0 && allocated[handle - 1]) { task[handle - 1]->immediate = true; wake_serial++; } }
 
     // change process duration (milliseconds,) use 0 for disabled
     void setDuration(uint8_t handle, unsigned long duration);
@@ -312,6 +359,17 @@ class Tasks {
       double getRuntimeMax(uint8_t handle);
     #endif
 
+    #ifdef TASKS_PROFILER_STATS_ENABLE
+      // get the profiler statistics for a task, hardware timer tasks report their ISR runtime
+      // \param handle        task handle
+      // \param profile       pointer to the statistics to fill in
+      // \return              true if successful, or false if unable to find the associated task
+      bool getProfile(uint8_t handle, TaskProfile *profile);
+
+      // clear the profiler statistics for all tasks
+      void clearProfiles();
+    #endif
+
     // runs tasks at their prescribed interval, each call can trigger at most a single process
     // processes that are already running are ignored so it's ok to poll() within a process
     void yield();
@@ -323,6 +381,8 @@ class Tasks {
     void updatePriorityRange();
     // keep track of the range of tasks so we don't waste cycles looking at empty ones
     void updateEventRange();
+    // group the software timed tasks by priority so yield() only looks at the tasks in a given level
+    void updateBuckets();
 
     uint8_t highest_task     = 0; // the highest task# assigned
     uint8_t highest_priority = 0; // the highest task priority
@@ -334,6 +394,15 @@ class Tasks {
     uint8_t number[8]        = {255, 255, 255, 255, 255, 255, 255, 255}; // the task# we are servicing at this priority level
     bool    allocated[TASKS_MAX];
     bool    hardware_timer_allocated[4] = {false, false, false, false};
+
+    // software timed task indexes grouped by priority, priority p is bucket[bucket_start[p]] to bucket[bucket_start[p + 1] - 1]
+    uint8_t bucket[TASKS_MAX];
+    uint8_t bucket_start[9]  = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    // micros() time before which no task in a priority level can be due, valid while wake_serial is unchanged
+    unsigned long wake_time[8];
+    uint32_t wake_time_serial[8];
+    // changes whenever a task's timing is changed outside of its own poll(), 32 bits so it can't wrap back onto a stale wake_time
+    volatile uint32_t wake_serial = 0;
     Task    *task[TASKS_MAX];
 };
 
@@ -22,6 +22,8 @@
   #include <ESP8266WiFi.h>
   #include <WiFiClient.h>
   #include <ESP8266WiFiAP.h>
+#elif defined(ARDUINO_ARCH_SIM)
+  #include <WiFi.h>
 #else
   #error "Configuration (Config.h): No Wifi support is present for this device"
 #endif
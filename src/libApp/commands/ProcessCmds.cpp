@@ -5,6 +5,7 @@
 #include "../../lib/tasks/OnTask.h"
 #include "../../lib/convert/Convert.h"
 #include "ProcessCmds.h"
+#include "../telemetry/Telemetry.h"
 
 #include "../../telescope/Telescope.h"
 
@@ -102,6 +103,14 @@
 CommandProcessor::CommandProcessor(long baud, char channel) {
   this->channel = channel;
   serialBaud = baud;
+  for (uint8_t i = 0; i < COMMAND_CLIENTS; i++) {
+    clients[i].connection = 0;
+    clients[i].lastCommandError = CE_NONE;
+    clients[i].telemetryMask = 0;
+    clients[i].telemetrySequence = 0;
+    clients[i].telemetryPeriodMs = 0;
+    clients[i].telemetryNextMs = 0;
+  }
 }
 
 CommandProcessor::~CommandProcessor() {
@@ -115,6 +124,7 @@ void CommandProcessor::poll() {
   while (SerialPort.available()) { char c = SerialPort.read(); buffer.add(c); if (buffer.ready() || (long)(micros() - tout) > 0) break; }
 
   if (buffer.ready()) {
+    client = getClient(SerialPort.getClient());
     char reply[80] = "";
     bool numericReply = true;
     bool supressFrame = false;
@@ -142,7 +152,7 @@ void CommandProcessor::poll() {
       }
     #endif
     if (commandError != CE_NULL) {
-      lastCommandError = commandError;
+      client->lastCommandError = commandError;
       #if DEBUG_ECHO_COMMANDS != OFF
         if (commandError > CE_0) { DF(", Error "); D(commandErrorStr[commandError]); }
       #endif
@@ -153,6 +163,52 @@ void CommandProcessor::poll() {
 
     buffer.flush();
   }
+
+  telemetryPoll();
+}
+
+CommandClient *CommandProcessor::getClient(uint8_t i) {
+  if (i >= COMMAND_CLIENTS) i = 0;
+  CommandClient *c = &clients[i];
+
+  uint8_t connection = SerialPort.getConnection(i);
+  if (c->connection != connection) {
+    c->connection = connection;
+    c->lastCommandError = CE_NONE;
+    c->telemetryMask = 0;
+  }
+  return c;
+}
+
+void CommandProcessor::telemetryPoll() {
+  uint8_t last = SerialPort.getClient();
+
+  for (uint8_t i = 0; i < COMMAND_CLIENTS; i++) {
+    CommandClient *c = getClient(i);
+    if (c->telemetryMask == 0 || (long)(millis() - c->telemetryNextMs) < 0) continue;
+    c->telemetryNextMs += c->telemetryPeriodMs;
+    // don't try to catch up on frames missed while busy
+    if ((long)(millis() - c->telemetryNextMs) > 0) c->telemetryNextMs = millis() + c->telemetryPeriodMs;
+
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint8_t length = telemetry.frame(frame, c->telemetryMask, c->telemetrySequence++);
+    SerialPort.setClient(i);
+    SerialPort.write(frame, length);
+  }
+
+  SerialPort.setClient(last);
+}
+
+unsigned long CommandProcessor::telemetryPeriodMin(uint8_t mask) {
+  // frames on a serial port get at most half its bandwidth (10 bits per byte), so writes don't block
+  // and replies still get through, the network and local channels aren't limited this way
+  if (channel < 'A' || channel > 'D' || serialBaud <= 0) return TELEMETRY_PERIOD_MIN;
+
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  uint8_t length = telemetry.frame(frame, mask, 0);
+  unsigned long period = (length*20000UL)/serialBaud + 1;
+  if (period < TELEMETRY_PERIOD_MIN) period = TELEMETRY_PERIOD_MIN;
+  return period;
 }
 
 CommandError CommandProcessor::command(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply) {
@@ -187,12 +243,14 @@ CommandError CommandProcessor::command(char *reply, char *command, char *paramet
       SerialPort.print("1");
       tasks.yield(50);
       SerialPort.begin(230400);
+      serialBaud = 230400;
       *numericReply = false;
     } else
     if (parameter[0] == 'B') {
       SerialPort.print("1");
       tasks.yield(50);
       SerialPort.begin(460800);
+      serialBaud = 460800;
       *numericReply = false;
     } else
     if (rate >= 0 && rate <= 9) {
@@ -200,8 +258,10 @@ CommandError CommandProcessor::command(char *reply, char *command, char *paramet
       SerialPort.print("1");
       tasks.yield(50);
       SerialPort.begin(baud[rate]);
+      serialBaud = baud[rate];
       *numericReply = false;
     } else commandError = CE_PARAM_RANGE;
+    if (client->telemetryMask != 0) client->telemetryPeriodMs = max(client->telemetryPeriodMs, telemetryPeriodMin(client->telemetryMask));
     return commandError;
   } else
 
@@ -219,10 +279,28 @@ CommandError CommandProcessor::command(char *reply, char *command, char *paramet
     return commandError;
   } else
 
+  // :YT[m],[n]# Set binary telemetry for this client, [m] is the block mask (hex) and [n] the period in ms
+  //            a mask of 0 stops telemetry, see Telemetry.h for the frame layout
+  //            on serial ports the period is lengthened if the baud rate can't carry the frames
+  //            Returns: 0 on failure
+  //                     1 on success
+  if (command[0] == 'Y' && command[1] == 'T') {
+    char *conv_end;
+    long mask = strtol(parameter, &conv_end, 16);
+    if (conv_end == parameter || *conv_end != ',') return CE_PARAM_FORM;
+    long period = strtol(conv_end + 1, &conv_end, 10);
+    if (*conv_end != 0) return CE_PARAM_FORM;
+    if (mask < 0 || mask > TELEMETRY_ALL || (mask & ~telemetry.available()) || (mask != 0 && (period < TELEMETRY_PERIOD_MIN || period > 60000))) return CE_PARAM_RANGE;
+    client->telemetryMask = mask;
+    client->telemetryPeriodMs = mask != 0 ? max((unsigned long)period, telemetryPeriodMin(mask)) : period;
+    client->telemetryNextMs = millis();
+    return commandError;
+  } else
+
   // :GE#       Get last command error numeric code
   //            Returns: CC#
   if (command[0] == 'G' && command[1] == 'E' && parameter[0] == 0) {
-    sprintf(reply, "%02d", lastCommandError);
+    sprintf(reply, "%02d", client->lastCommandError);
     *numericReply = false;
     return commandError;
   } else
@@ -7,6 +7,22 @@
 #include "../../lib/commands/SerialWrapper.h"
 #include "../../lib/commands/CommandErrors.h"
 
+#if OPERATIONAL_MODE == WIFI && SERIAL_SERVER != OFF
+  #define COMMAND_CLIENTS SERIAL_SERVER_CLIENTS
+#else
+  #define COMMAND_CLIENTS 1
+#endif
+
+// state kept for each client of a channel, IP serial channels serve several at once
+typedef struct CommandClient {
+  uint8_t connection;
+  CommandError lastCommandError;
+  uint8_t telemetryMask;
+  uint8_t telemetrySequence;
+  unsigned long telemetryPeriodMs;
+  unsigned long telemetryNextMs;
+} CommandClient;
+
 class CommandProcessor {
   public:
     // start and stop the serial port for the associated command channel
@@ -23,12 +39,23 @@ class CommandProcessor {
     void logErrors(char *cmd, char *param, char *reply, CommandError e);
     void appendChecksum(char *s);
 
+    // the state for a client, reset when a new client takes its place
+    CommandClient *getClient(uint8_t i);
+
+    // send telemetry frames to the clients they are due for
+    void telemetryPoll();
+
+    // the shortest telemetry period in ms this channel can carry frames with the blocks in mask
+    unsigned long telemetryPeriodMin(uint8_t mask);
+
     CommandError commandError      = CE_NONE;
-    CommandError lastCommandError  = CE_NONE;
     bool serialReady               = false;
     long serialBaud                = 9600;
     char channel                   = '?';
 
+    CommandClient clients[COMMAND_CLIENTS];
+    CommandClient *client          = &clients[0];   // the client the command being processed came from
+
     Buffer buffer;
     SerialWrapper SerialPort;
 };
@@ -0,0 +1,55 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// CRC header for the NV regions (settings and PEC/library data), detects corruption at startup
+
+#include "NvCheck.h"
+
+#if NV_CHECKSUM_SIZE > 0
+
+#include "../../lib/tasks/OnTask.h"
+
+void nvCheckWrapper() { nvCheck.poll(); }
+
+void NvCheck::init() {
+  base = nv.size - NV_ALIGN_SUMS_SIZE - NV_LOG_SIZE - NV_CHECKSUM_SIZE;
+
+  // there's nothing to validate until NV has been set to defaults
+  if (nv.hasValidKey()) {
+    NvCheckHeader stored, current;
+    nv.readBytes(base, &stored, sizeof(NvCheckHeader));
+    if (stored.check == check(&stored)) {
+      found = true;
+      compute(&current);
+      for (uint8_t r = 0; r < NV_CHECKSUM_REGIONS; r++) {
+        if (current.crc[r] != stored.crc[r]) {
+          bitSet(failed, r);
+          DF("WRN: NvCheck, region "); D(r); DLF(" checksum mismatch");
+        }
+      }
+      if (!failed) { VLF("MSG: NvCheck, all regions valid"); }
+    } else { VLF("MSG: NvCheck, no header found"); }
+  }
+  lastChanges = nv.changes - 1;
+
+  VF("MSG: NvCheck, start task (rate "); V(NV_CHECKSUM_PERIOD); VF("ms priority 7)... ");
+  if (tasks.add(NV_CHECKSUM_PERIOD, 0, true, 7, nvCheckWrapper, "NvChk")) { VLF("success"); } else { VLF("FAILED!"); }
+}
+
+void NvCheck::poll() {
+  if (nv.changes == lastChanges || !nv.hasValidKey()) return;
+
+  NvCheckHeader header;
+  compute(&header);
+  header.check = check(&header);
+  nv.writeBytes(base, &header, sizeof(NvCheckHeader));
+
+  lastChanges = nv.changes;
+}
+
+void NvCheck::compute(NvCheckHeader *header) {
+  header->crc[0] = nv.checksum(0, NV_LAST + 1);
+  header->crc[1] = nv.checksum(NV_LAST + 1, base - (NV_LAST + 1));
+}
+
+NvCheck nvCheck;
+
+#endif
@@ -0,0 +1,49 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// CRC header for the NV regions (settings and PEC/library data), detects corruption at startup
+#pragma once
+
+#include "../../Common.h"
+
+#if NV_CHECKSUM_SIZE > 0
+
+#ifndef NV_CHECKSUM_PERIOD
+  #define NV_CHECKSUM_PERIOD 10000 // in milliseconds, how often the header is brought up to date after NV changes
+#endif
+
+#define NV_CHECKSUM_REGIONS 2
+
+#pragma pack(1)
+typedef struct NvCheckHeader {
+  uint16_t crc[NV_CHECKSUM_REGIONS];
+  uint16_t check;
+} NvCheckHeader;
+#pragma pack()
+
+class NvCheck {
+  public:
+    // validates the stored header against the NV contents and starts the update task
+    void init();
+
+    // brings the header up to date if anything in NV changed
+    void poll();
+
+    // bit for each region that failed validation at startup, 0 if all passed
+    uint8_t failed = 0;
+
+    // true if a valid header was found at startup
+    bool found = false;
+
+  private:
+    // CRC of each region
+    void compute(NvCheckHeader *header);
+
+    // checksum for the header, chosen so erased (all 0x00 or 0xFF) headers are never valid
+    inline uint16_t check(NvCheckHeader *header) { return header->crc[0] ^ header->crc[1] ^ 0xA55A; }
+
+    uint16_t base = 0;
+    uint32_t lastChanges = 0;
+};
+
+extern NvCheck nvCheck;
+
+#endif
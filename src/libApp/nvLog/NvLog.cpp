@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// Wear leveled log for frequently changing NV records (last mount position, focuser/rotator position, etc.)
+
+#include "NvLog.h"
+
+#if NV_LOG_SIZE > 0
+
+#include "../../lib/tasks/OnTask.h"
+
+void nvLogWrapper() { nvLog.poll(); }
+
+void NvLog::init() {
+  if (ready) return;
+
+  for (uint8_t k = 0; k < NV_LOG_KEYS; k++) slot[k] = -1;
+
+  // the log sits at the end of NV, below any stored align sums
+  if (nv.size < NV_END_DATA_BASE_MIN + NV_CHECKSUM_SIZE + NV_LOG_SIZE + NV_ALIGN_SUMS_SIZE) {
+    DLF("ERR: NvLog, the log would overlap the settings or PEC buffer, disabled");
+    return;
+  }
+  uint16_t start = nv.size - NV_ALIGN_SUMS_SIZE - NV_LOG_SIZE;
+
+  // the first slot holds a format marker, written when the log is first enabled after the area
+  // is cleared, so bytes left there by the library are never taken for entries
+  NvLogEntry entry, mark;
+  nv.readBytes(start, &entry, sizeof(NvLogEntry));
+  marker(&mark);
+  if (memcmp(&entry, &mark, sizeof(NvLogEntry)) != 0) format(start);
+
+  base = start + sizeof(NvLogEntry);
+  slots = NV_LOG_SIZE/sizeof(NvLogEntry) - 1;
+
+  // entries are written round-robin with an incrementing sequence number, so the newest of them
+  // all marks the head and the newest entry with a given key holds its value
+  bool found = false;
+  uint16_t sequenceNewest[NV_LOG_KEYS];
+  for (uint16_t i = 0; i < slots; i++) {
+    nv.readBytes(base + i*sizeof(NvLogEntry), &entry, sizeof(NvLogEntry));
+    if (entry.key == 0 || entry.key >= NV_LOG_KEYS || entry.check != check(&entry)) continue;
+
+    if (!found || (int16_t)(entry.sequence - sequence) > 0) { sequence = entry.sequence; head = i; found = true; }
+
+    uint8_t k = entry.key;
+    if (slot[k] < 0 || (int16_t)(entry.sequence - sequenceNewest[k]) > 0) {
+      slot[k] = i;
+      sequenceNewest[k] = entry.sequence;
+      memcpy(value[k], entry.data, NV_LOG_DATA_SIZE);
+    }
+    Y;
+  }
+  if (found) head = (head + 1) % slots;
+
+  VF("MSG: NvLog, "); V(slots); VF(" slots at "); V(base); VF(found ? " head at " : " empty, head at "); VL(head);
+
+  VF("MSG: NvLog, start task (rate "); V(NV_LOG_PERIOD); VF("ms priority 7)... ");
+  if (tasks.add(NV_LOG_PERIOD, 0, true, 7, nvLogWrapper, "NvLog")) { VLF("success"); } else { VLF("FAILED!"); }
+
+  ready = true;
+}
+
+bool NvLog::read(uint8_t key, void *data, uint8_t count) {
+  if (key == 0 || key >= NV_LOG_KEYS || count > NV_LOG_DATA_SIZE) return false;
+  if (slot[key] < 0 && !bitRead(staged, key)) return false;
+
+  memcpy(data, value[key], count);
+  return true;
+}
+
+void NvLog::write(uint8_t key, void *data, uint8_t count) {
+  if (key == 0 || key >= NV_LOG_KEYS || count > NV_LOG_DATA_SIZE) return;
+
+  // repeated writes of the same value are dropped, changed values wait for the next poll
+  if ((slot[key] >= 0 || bitRead(staged, key)) && memcmp(value[key], data, count) == 0) return;
+
+  memset(value[key], 0, NV_LOG_DATA_SIZE);
+  memcpy(value[key], data, count);
+  bitSet(staged, key);
+}
+
+void NvLog::poll() {
+  if (!ready || staged == 0) return;
+
+  for (uint8_t k = 1; k < NV_LOG_KEYS; k++) {
+    if (bitRead(staged, k)) {
+      append(k);
+      bitClear(staged, k);
+    }
+  }
+}
+
+uint8_t NvLog::check(NvLogEntry *entry) {
+  uint8_t sum = 0x5A;
+  uint8_t *bytes = (uint8_t*)entry;
+  for (uint8_t i = 0; i < sizeof(NvLogEntry) - 1; i++) sum = (uint8_t)((sum << 1) | (sum >> 7)) + bytes[i];
+  return sum;
+}
+
+void NvLog::marker(NvLogEntry *entry) {
+  memset(entry, 0, sizeof(NvLogEntry));
+  entry->sequence = NV_LOG_SIZE;
+  entry->key = NV_LOG_MARKER_KEY;
+  strcpy((char*)entry->data, "OnStepNvLog");
+  entry->check = check(entry);
+}
+
+void NvLog::format(uint16_t start) {
+  VLF("MSG: NvLog, no format marker, clearing the log area");
+
+  // all zeros is never a valid entry, the marker goes last so an interrupted format is done again
+  NvLogEntry entry;
+  memset(&entry, 0, sizeof(NvLogEntry));
+  for (uint16_t i = 1; i < NV_LOG_SIZE/sizeof(NvLogEntry); i++) {
+    nv.updateBytes(start + i*sizeof(NvLogEntry), &entry, sizeof(NvLogEntry));
+    Y;
+  }
+  marker(&entry);
+  nv.updateBytes(start, &entry, sizeof(NvLogEntry));
+}
+
+uint8_t NvLog::liveKey(uint16_t i) {
+  for (uint8_t k = 1; k < NV_LOG_KEYS; k++) if (slot[k] == (int16_t)i) return k;
+  return 0;
+}
+
+void NvLog::store(uint8_t key) {
+  // slots holding the newest entry of a key are never written over
+  uint16_t i = head;
+  for (uint16_t n = 0; n < slots && liveKey(i); n++) i = (i + 1) % slots;
+
+  NvLogEntry entry;
+  entry.sequence = ++sequence;
+  entry.key = key;
+  memcpy(entry.data, value[key], NV_LOG_DATA_SIZE);
+  entry.check = check(&entry);
+  nv.updateBytes(base + i*sizeof(NvLogEntry), &entry, sizeof(NvLogEntry));
+  slot[key] = i;
+  head = (i + 1) % slots;
+}
+
+void NvLog::append(uint8_t key) {
+  // a slot at the head still holding the newest entry for another key has that entry written again
+  // further on first, the old copy stays valid until then and the slot is free once the head comes
+  // around again (so every live entry is rewritten at least once per trip around the log)
+  for (uint8_t n = 0; n < NV_LOG_KEYS; n++) {
+    uint8_t live = liveKey(head);
+    if (live == 0 || live == key) break;
+    store(live);
+  }
+  store(key);
+}
+
+NvLog nvLog;
+
+#endif
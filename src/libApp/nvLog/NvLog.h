@@ -0,0 +1,68 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// Wear leveled log for frequently changing NV records (last mount position, focuser/rotator position, etc.)
+#pragma once
+
+#include "../../Common.h"
+
+#if NV_LOG_SIZE > 0
+
+#define NV_LOG_KEYS 16         // keys 1 to 15
+#define NV_LOG_DATA_SIZE 12    // bytes of data per record
+#define NV_LOG_MARKER_KEY 0xA5 // key of the format marker in the first slot of the log area
+
+#pragma pack(1)
+typedef struct NvLogEntry {
+  uint16_t sequence;
+  uint8_t key;
+  uint8_t data[NV_LOG_DATA_SIZE];
+  uint8_t check;
+} NvLogEntry;
+#pragma pack()
+
+class NvLog {
+  public:
+    // scans the log area for the newest entry of each key
+    void init();
+
+    // reads the newest value stored for a key, returns false if there is none
+    bool read(uint8_t key, void *data, uint8_t count);
+
+    // stages a value for a key, writes of a changed value are appended at the next poll()
+    void write(uint8_t key, void *data, uint8_t count);
+
+    // appends the staged values
+    void poll();
+
+  private:
+    // checksum for an entry, chosen so erased (all 0x00 or 0xFF) slots are never valid
+    uint8_t check(NvLogEntry *entry);
+
+    // fills in the format marker entry
+    void marker(NvLogEntry *entry);
+
+    // clears the log area and writes the format marker
+    void format(uint16_t start);
+
+    // the key whose newest entry is in a slot, 0 if none
+    uint8_t liveKey(uint16_t i);
+
+    // writes an entry for a key at the head of the log, or the next free slot after it, and moves the head on
+    void store(uint8_t key);
+
+    // appends an entry for a key, first moving any live entry at the head forward
+    void append(uint8_t key);
+
+    uint16_t base = 0;
+    uint16_t slots = 0;
+    uint16_t head = 0;
+    uint16_t sequence = 0;
+
+    int16_t slot[NV_LOG_KEYS];                    // where the newest entry for each key is, -1 if none
+    uint8_t value[NV_LOG_KEYS][NV_LOG_DATA_SIZE];
+    uint16_t staged = 0;                          // bit for each key with a value waiting to be appended
+    bool ready = false;
+};
+
+extern NvLog nvLog;
+
+#endif
@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// Binary telemetry frames, streamed on a command channel alongside the LX200 replies
+
+#include "Telemetry.h"
+
+#include "../../telescope/mount/Mount.h"
+#include "../../telescope/mount/guide/Guide.h"
+#include "../../telescope/mount/status/Status.h"
+#include "../../telescope/focuser/Focuser.h"
+
+uint8_t Telemetry::available() {
+  uint8_t mask = 0;
+  #ifdef MOUNT_PRESENT
+    mask |= TELEMETRY_POSITION | TELEMETRY_RATE | TELEMETRY_STATUS | TELEMETRY_GUIDE;
+  #endif
+  #ifdef FOCUSER_PRESENT
+    mask |= TELEMETRY_FOCUSER;
+  #endif
+  return mask;
+}
+
+uint8_t Telemetry::frame(uint8_t *buffer, uint8_t mask, uint8_t sequence) {
+  uint8_t data[TELEMETRY_DATA_MAX];
+  this->buffer = data;
+  length = 3;
+  mask &= available();
+
+  #ifdef MOUNT_PRESENT
+    if (mask & TELEMETRY_POSITION) {
+      Coordinate current = mount.getPositionSnapshot();
+      float position[4] = { (float)current.r, (float)current.d, (float)current.a, (float)current.z };
+      add(position, sizeof(position));
+    }
+
+    if (mask & TELEMETRY_RATE) {
+      float rate[3] = { (float)radToDegF(axis1.getFrequency()), (float)radToDegF(axis2.getFrequency()), mount.isTracking() ? mount.trackingRate : 0.0F };
+      add(rate, sizeof(rate));
+    }
+
+    if (mask & TELEMETRY_STATUS) {
+      char status[10];
+      mountStatus.getStatusBits(status);
+      add(status, 9);
+    }
+
+    if (mask & TELEMETRY_GUIDE) {
+      uint8_t state[3];
+      state[0] = guide.active() | guide.activePulseGuide() << 1 | guide.activeAxis1() << 2 | guide.activeAxis2() << 3;
+      state[1] = guide.settings.pulseRateSelect;
+      state[2] = guide.settings.axis1RateSelect;
+      add(state, sizeof(state));
+    }
+  #endif
+
+  #ifdef FOCUSER_PRESENT
+    if (mask & TELEMETRY_FOCUSER) {
+      for (int index = 0; index < 6; index++) {
+        int32_t position = focuser.getPositionSteps(index);
+        add(&position, sizeof(position));
+      }
+    }
+  #endif
+
+  data[0] = mask;
+  data[1] = sequence;
+  data[2] = length - 3;
+
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  data[length++] = crc & 0xFF;
+  data[length++] = crc >> 8;
+
+  return encode(data, length, buffer);
+}
+
+uint8_t Telemetry::encode(const uint8_t *data, uint8_t count, uint8_t *frame) {
+  uint8_t frameLength = 0;
+  frame[frameLength++] = 0;
+
+  // each 0x00 in the data becomes a code byte, the distance to the next code byte (or to the end)
+  uint8_t code = frameLength++;
+  frame[code] = 1;
+  for (uint8_t i = 0; i < count; i++) {
+    if (data[i] == 0) { code = frameLength++; frame[code] = 1; } else { frame[frameLength++] = data[i]; frame[code]++; }
+  }
+
+  frame[frameLength++] = 0;
+  return frameLength;
+}
+
+void Telemetry::add(const void *data, uint8_t count) {
+  memcpy(&buffer[length], data, count);
+  length += count;
+}
+
+Telemetry telemetry;
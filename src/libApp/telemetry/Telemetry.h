@@ -0,0 +1,43 @@
+// -----------------------------------------------------------------------------------------------------------------------------
+// Binary telemetry frames, streamed on a command channel alongside the LX200 replies
+#pragma once
+
+#include "../../Common.h"
+
+// frame layout (multi-byte values are little endian)
+//   block mask, sequence, payload length, payload, CRC-16 (CCITT) of all the bytes before it
+// the payload holds the blocks selected by the mask, in bit order
+// each frame is COBS encoded, so it holds no 0x00 bytes, and sent with a 0x00 before and after it; LX200 replies
+// never hold a 0x00 so a client splits what it receives on 0x00 into frames and the replies between them
+#define TELEMETRY_POSITION    0b00000001  // float ra, dec, alt, azm (native coordinates, radians)
+#define TELEMETRY_RATE        0b00000010  // float axis1, axis2 (degrees/s) and tracking rate (sidereal)
+#define TELEMETRY_STATUS      0b00000100  // the 9 status bytes from :Gu#
+#define TELEMETRY_GUIDE       0b00001000  // uint8 flags (bit0 active, bit1 pulse, bit2 axis1, bit3 axis2,) pulse rate, guide rate
+#define TELEMETRY_FOCUSER     0b00010000  // int32 position (steps) for focusers 1 to 6
+#define TELEMETRY_ALL         0b00011111
+
+#define TELEMETRY_PERIOD_MIN  20          // in ms
+#define TELEMETRY_DATA_MAX    (3 + 16 + 12 + 9 + 3 + 24 + 2)
+#define TELEMETRY_FRAME_MAX   (TELEMETRY_DATA_MAX + 3)  // with the COBS code byte and the two delimiters
+
+class Telemetry {
+  public:
+    // build a frame with the blocks in mask into buffer (at least TELEMETRY_FRAME_MAX bytes), encoded and delimited
+    // returns the frame length in bytes
+    uint8_t frame(uint8_t *buffer, uint8_t mask, uint8_t sequence);
+
+    // the blocks that can be sent with this configuration
+    uint8_t available();
+
+  private:
+    // appends a value to the frame being built
+    void add(const void *data, uint8_t count);
+
+    // COBS encodes count bytes of data (less than 254) into frame between 0x00 delimiters, returns the frame length
+    uint8_t encode(const uint8_t *data, uint8_t count, uint8_t *frame);
+
+    uint8_t *buffer = NULL;
+    uint8_t length = 0;
+};
+
+extern Telemetry telemetry;
@@ -81,6 +81,10 @@
 #define GPIO_SSR74HC595_CLOCK_PIN  16
 #define GPIO_SSR74HC595_DATA_PIN   21
 #define GPIO_SSR74HC595_COUNT       8
+// To latch all step/dir changes together in a single shift per frame (rather than one or more shifts per step)
+// add this to Config.h: #define GPIO_SSR74HC595_FRAME_RATE 50000
+// and to precompute those frames and stream them out by I2S DMA (pins 16/17/21 are the I2S BCK/WS/DATA) also add:
+// #define GPIO_SSR74HC595_STREAM ON
 
 #define SHARED_ENABLE_PIN   GPIO_PIN(0)         // Hint that the enable pins are shared
 
@@ -72,6 +72,14 @@
 #define GPIO_SSR74HC595_COUNT       8              // 8, 16, 24, or 32 (for 1, 2, 3, or 4 74HC595's)
 #endif
 
+#ifndef GPIO_SSR74HC595_FRAME_RATE
+#define GPIO_SSR74HC595_FRAME_RATE  OFF            // OFF or n. Where n=1000 to 100000 (Hz) to latch all changes together once per
+#endif                                             // frame (uses a h/w timer,) step rates are limited to n/2.5 steps per second
+
+#ifndef GPIO_SSR74HC595_STREAM
+#define GPIO_SSR74HC595_STREAM      OFF            // OFF, ON precomputes step/dir frames for all axes and streams them out at the
+#endif                                             // frame rate (I2S DMA on the ESP32, otherwise a h/w timer)
+
 // --------------------------------------------------------------------------------------------------------
 // define standard pins as inactive
 #ifndef AUX0_PIN
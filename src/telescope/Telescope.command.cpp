@@ -7,6 +7,8 @@
 #include "../lib/convert/Convert.h"
 #include "../libApp/commands/ProcessCmds.h"
 #include "../libApp/weather/Weather.h"
+#include "../libApp/nvCheck/NvCheck.h"
+#include "../lib/ethernet/webServer/WebServer.h"
 #include "Telescope.h"
 
 #include "addonFlasher/AddonFlasher.h"
@@ -29,35 +31,46 @@
   HAL_RESET_FUNC;
 #endif
 
-bool Telescope::command(char reply[], char command[], char parameter[], bool *supressFrame, bool *numericReply, CommandError *commandError) {
+// wraps a subsystem's command() so it can go in the dispatch table
+#define COMMAND_HANDLER(object) [](char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError) \
+  { return object.command(reply, command, parameter, supressFrame, numericReply, commandError); }
 
+// register the subsystem command handlers, in the order they get tried, along with the commands each one can
+// process (a single character for all commands starting with it or two characters for just that command)
+void Telescope::commandInit() {
   #ifdef MOUNT_PRESENT
-    if (mount.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (guide.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (gpio.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (mountStatus.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (goTo.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (park.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (library.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (site.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (limits.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (home.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (pec.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (axis1.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
-    if (axis2.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    commandDispatch.add("$B %B GA GD GR GT GX GZ SE ST SX T",         COMMAND_HANDLER(mount));
+    commandDispatch.add("GX M Q R",                                   COMMAND_HANDLER(guide));
+    commandDispatch.add("GX SX",                                      COMMAND_HANDLER(gpio));
+    commandDispatch.add("GU Gm Gu GW SX",                             COMMAND_HANDLER(mountStatus));
+    commandDispatch.add("A C D GX Ga Gd Gr Gz M SX Sa Sd Sr Sz",      COMMAND_HANDLER(goTo));
+    commandDispatch.add("h",                                          COMMAND_HANDLER(park));
+    commandDispatch.add("L",                                          COMMAND_HANDLER(library));
+    commandDispatch.add("GC GG GL GM GN GO GP GS GX Ga Gc Gg Gt Gv "
+                        "SC SG SL SM SN SO SP SU Sg St Sv W",         COMMAND_HANDLER(site));
+    commandDispatch.add("GX Gh Go SX Sh So",                          COMMAND_HANDLER(limits));
+    commandDispatch.add("h",                                          COMMAND_HANDLER(home));
+    commandDispatch.add("$Q GX SX V W",                               COMMAND_HANDLER(pec));
+    commandDispatch.add("GX SX",                                      COMMAND_HANDLER(axis1));
+    commandDispatch.add("GX SX",                                      COMMAND_HANDLER(axis2));
   #endif
 
   #ifdef ROTATOR_PRESENT
-    if (rotator.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    commandDispatch.add("GX SX h r",                                  COMMAND_HANDLER(rotator));
   #endif
 
   #ifdef FOCUSER_PRESENT
-    if (focuser.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    commandDispatch.add("F GX SX h",                                  COMMAND_HANDLER(focuser));
   #endif
 
   #ifdef FEATURES_PRESENT
-    if (features.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
+    commandDispatch.add("GX SX",                                      COMMAND_HANDLER(features));
   #endif
+}
+
+bool Telescope::command(char reply[], char command[], char parameter[], bool *supressFrame, bool *numericReply, CommandError *commandError) {
+
+  if (commandDispatch.command(reply, command, parameter, supressFrame, numericReply, commandError)) return true;
 
   //  B - Reticle/Accessory Control
   // :B+#       Increase reticle Brightness
@@ -150,6 +163,45 @@ bool Telescope::command(char reply[], char command[], char parameter[], bool *su
       *numericReply = false;
     } else
 
+    #ifdef TASKS_PROFILER_STATS_ENABLE
+      // :GXP[nn]#  Get task profile for task handle nn (01 to 99)
+      //            Returns: name,runs,lateAvg,lateMax,lateMaxTime,runAvg,runMax,runMaxTime#
+      //            times are in microseconds, when each maximum occurred is in seconds since boot
+      // :GXP[nn]L# Get task lateness histogram
+      // :GXP[nn]R# Get task runtime histogram
+      //            Returns: 16 hex digits, the bit length of each bin's count (0 for none, 1 for 1, 2 for 2 to 3, etc.)
+      //            bin 0 is < 1us, bin n is from 2^(n-1) to 2^n us, bin 15 is anything longer
+      if (command[1] == 'X' && parameter[0] == 'P' && parameter[1] >= '0' && parameter[1] <= '9' && parameter[2] >= '0' && parameter[2] <= '9' && (parameter[3] == 0 || parameter[4] == 0)) {
+        TaskProfile profile;
+        uint8_t handle = (parameter[1] - '0')*10 + (parameter[2] - '0');
+        if (tasks.getProfile(handle, &profile)) {
+          if (parameter[3] == 0) {
+            float ticksPerMicro = tasksProfilerTicksPerMicro();
+            unsigned long lateAvg = 0, runAvg = 0;
+            if (profile.runs > 0) {
+              lateAvg = profile.lateTotal/profile.runs;
+              runAvg = lroundf((profile.runTotal/profile.runs)/ticksPerMicro);
+            }
+            sprintf(reply, "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu", tasks.getNameStr(handle), profile.runs,
+              lateAvg, profile.lateMax, profile.lateMaxTime/1000UL,
+              runAvg, (unsigned long)lroundf(profile.runMax/ticksPerMicro), profile.runMaxTime/1000UL);
+            *numericReply = false;
+          } else
+          if (parameter[3] == 'L' || parameter[3] == 'R') {
+            uint16_t *bin = parameter[3] == 'L' ? profile.lateHist : profile.runHist;
+            for (int i = 0; i < TASKS_PROFILER_BINS; i++) {
+              uint8_t bits = 0;
+              for (uint16_t count = bin[i]; count > 0; count >>= 1) bits++;
+              if (bits > 15) bits = 15;
+              reply[i] = "0123456789ABCDEF"[bits];
+            }
+            reply[TASKS_PROFILER_BINS] = 0;
+            *numericReply = false;
+          } else *commandError = CE_CMD_UNKNOWN;
+        } else *commandError = CE_PARAM_RANGE;
+      } else
+    #endif
+
     if (command[1] == 'X' && parameter[2] == 0) {
       if (parameter[0] == '9') {
         // :GX9A#     temperature in deg. C
@@ -181,6 +233,44 @@ bool Telescope::command(char reply[], char command[], char parameter[], bool *su
         } else return false;
       } else
 
+      if (parameter[0] == 'N') {
+        // :GXN0#     Get NV commit statistics
+        //            Returns: commitMs,commitMaxMs,commitBytes,blockMaxUs#
+        //            time for the last and slowest commit, bytes stored by the last and the longest single storage operation
+        if (parameter[1] == '0') {
+          sprintf(reply, "%lu,%lu,%lu,%lu", nv.commitTimeMs, nv.commitTimeMaxMs, nv.commitBytes, nv.blockTimeMaxUs);
+          *numericReply = false;
+        } else
+        // :GXN1#     Get boot time statistics
+        //            Returns: loadMs,initMs,trackingMs,checksum#
+        //            time to load the NV image, millis() when init finished and when tracking first started (0 if not yet,)
+        //            checksum is -1 if disabled or no header was found, otherwise a bit for each region that failed
+        if (parameter[1] == '1') {
+          unsigned long trackingMs = 0;
+          #ifdef MOUNT_PRESENT
+            trackingMs = mount.trackingStartTimeMs;
+          #endif
+          int checksum = -1;
+          #if NV_CHECKSUM_SIZE > 0
+            if (nvCheck.found) checksum = nvCheck.failed;
+          #endif
+          sprintf(reply, "%lu,%lu,%lu,%d", nv.loadTimeMs, initTimeMs, trackingMs, checksum);
+          *numericReply = false;
+        } else
+        // :GXN2#     Get web server statistics
+        //            Returns: requests,requestMaxMs,heapFragmentation#
+        //            requests handled, the slowest one, and heap fragmentation in % (-1 if not known on this platform)
+        if (parameter[1] == '2') {
+          #if (OPERATIONAL_MODE == ETHERNET_W5100 || OPERATIONAL_MODE == ETHERNET_W5500) && WEB_SERVER == ON
+            sprintf(reply, "%lu,%lu,%d", www.requests, www.requestTimeMaxMs, www.heapFragmentation());
+            *numericReply = false;
+          #else
+            *numericReply = true;
+            *commandError = CE_0;
+          #endif
+        } else return false;
+      } else
+
       if (parameter[0] == 'A') {
         // :GXA0#     Get axis/driver revert all state
         //            Returns: Value
@@ -218,6 +308,14 @@ bool Telescope::command(char reply[], char command[], char parameter[], bool *su
       } else return false;
     } else
 
+    #ifdef TASKS_PROFILER_STATS_ENABLE
+      // :SXP0,0#   Clear the task profiler statistics
+      //            Return: 0 failure, 1 success
+      if (parameter[0] == 'P') {
+        if (parameter[1] == '0' && parameter[3] == '0' && parameter[4] == 0) tasks.clearProfiles(); else *commandError = CE_PARAM_RANGE;
+      } else
+    #endif
+
     if (parameter[0] == 'A') {
       // :SXAC,0#   for run-time NV (EEPROM) axis settings
       // :SXAC,1#   for compile-time Config.h axis settings
@@ -8,6 +8,8 @@
 #include "../libApp/commands/ProcessCmds.h"
 #include "../libApp/weather/Weather.h"
 #include "../libApp/temperature/Temperature.h"
+#include "../libApp/nvLog/NvLog.h"
+#include "../libApp/nvCheck/NvCheck.h"
 
 #include "Telescope.h"
 
@@ -112,6 +114,11 @@ void Telescope::init(const char *fwName, int fwMajor, int fwMinor, const char *f
   strcpy(firmware.date, __DATE__);
   strcpy(firmware.time, __TIME__);
 
+  commandInit();
+
+  // one pass over the whole NV image in bursts, all reads from here on come from the cache
+  nv.load();
+
   if (!nv.isKeyValid(INIT_NV_KEY)) {
     if (!nv.initError) {
       VF("MSG: NV, invalid key wipe "); V(nv.size); VLF(" bytes");
@@ -121,6 +128,14 @@ void Telescope::init(const char *fwName, int fwMajor, int fwMinor, const char *f
     }
   } else { VLF("MSG: NV, correct key found"); }
 
+  #if NV_LOG_SIZE > 0
+    nvLog.init();
+  #endif
+
+  #if NV_CHECKSUM_SIZE > 0
+    nvCheck.init();
+  #endif
+
   if (!gpio.init()) initError.gpio = true;
 
   #ifdef SHARED_ENABLE_PIN
@@ -207,6 +222,9 @@ void Telescope::init(const char *fwName, int fwMajor, int fwMinor, const char *f
 
   initError.nv = nv.initError;
 
+  initTimeMs = millis();
+  VF("MSG: Telescope, init done in "); V(initTimeMs); VLF(" ms");
+
   #if RETICLE_LED_DEFAULT != OFF && RETICLE_LED_PIN != OFF
     #if RETICLE_LED_MEMORY == ON
       reticleBrightness = nv.readI(NV_TELESCOPE_SETTINGS_BASE);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "../Common.h"
+#include "../lib/commands/CommandDispatch.h"
 #include "../libApp/commands/ProcessCmds.h"
 
 #ifndef ANALOG_WRITE_RANGE
@@ -52,7 +53,12 @@ class Telescope {
     void statusInit();
 
   private:
+    // register the subsystem command handlers
+    void commandInit();
+
+    CommandDispatch commandDispatch;
     Firmware firmware;
+    unsigned long initTimeMs = 0;     // millis() when init() finished, for boot time metrics
     int16_t reticleBrightness = RETICLE_LED_DEFAULT;
 };
 
@@ -8,6 +8,7 @@
 #include "../../lib/tasks/OnTask.h"
 #include "../../libApp/weather/Weather.h"
 #include "../../libApp/temperature/Temperature.h"
+#include "../../libApp/nvLog/NvLog.h"
 #include "../Telescope.h"
 #include "../../lib/sense/Sense.h"
 
@@ -195,6 +196,12 @@ float Focuser::getTemperature() {
   return t;
 }
 
+// get focuser position in steps (less the TCF offset,) 0 if this focuser isn't present
+long Focuser::getPositionSteps(int index) {
+  if (index < 0 || index >= FOCUSER_MAX || axes[index] == NULL) return 0;
+  return axes[index]->getInstrumentCoordinateSteps() - tcfSteps[index];
+}
+
 // check for DC motor focuser
 bool Focuser::isDC(int index) {
   if (index < 0 || index >= FOCUSER_MAX) return false;
@@ -433,6 +440,9 @@ CommandError Focuser::unpark(int index) {
 
 void Focuser::readSettings(int index) {
   nv.readBytes(NV_FOCUSER_SETTINGS_BASE + index*FocuserSettingsSize, &settings[index], sizeof(FocuserSettings));
+  #if NV_LOG_SIZE > 0
+    nvLog.read(NV_LOG_FOCUSER_POSITION + index, &settings[index].position, sizeof(float));
+  #endif
   if (fabs(settings[index].tcf.coef) > 999.0F) { settings[index].tcf.coef = 0.0F;  initError.value = true; DLF("ERR: Focuser.init(), bad NV |tcf.coef| > 999.0 um/deg. C (set to 0.0)"); }
   if (settings[index].tcf.deadband < 1 )       { settings[index].tcf.deadband = 1; initError.value = true; DLF("ERR: Focuser.init(), bad NV tcf.deadband < 1 steps (set to 1)"); }
   if (settings[index].tcf.deadband > 10000 )   { settings[index].tcf.deadband = 1; initError.value = true; DLF("ERR: Focuser.init(), bad NV tcf.deadband > 10000 steps (set to 1)"); }
@@ -443,6 +453,18 @@ void Focuser::readSettings(int index) {
 
 void Focuser::writeSettings(int index) {
   nv.updateBytes(NV_FOCUSER_SETTINGS_BASE + index*FocuserSettingsSize, &settings[index], sizeof(FocuserSettings));
+  #if NV_LOG_SIZE > 0
+    nvLog.write(NV_LOG_FOCUSER_POSITION + index, &settings[index].position, sizeof(float));
+  #endif
+}
+
+// the position is written to the NV log only (when present) where it's always the most recent
+void Focuser::writePosition(int index) {
+  #if NV_LOG_SIZE > 0
+    nvLog.write(NV_LOG_FOCUSER_POSITION + index, &settings[index].position, sizeof(float));
+  #else
+    writeSettings(index);
+  #endif
 }
 
 // poll focusers to handle parking and TCF
@@ -513,7 +535,7 @@ void Focuser::monitor() {
           if (FOCUSER_WRITE_DELAY != 0) {
             if (secs > writeTime[index]) {
               settings[index].position = targetMicrons;
-              writeSettings(index);
+              writePosition(index);
               VF("MSG: Focuser"); V(index + 1); VF(", writing position ("); V(targetMicrons); VLF("um) to NV"); 
             }
           }
@@ -75,6 +75,9 @@ class Focuser {
     // poll focusers to handle parking and TCF
     void monitor();
 
+    // get focuser position in steps (less the TCF offset,) 0 if this focuser isn't present
+    long getPositionSteps(int index);
+
     // poll focuser buttons to start/stop movement
     #if FOCUSER_BUTTON_SENSE_IN != OFF && FOCUSER_BUTTON_SENSE_OUT != OFF
       void buttons();
@@ -147,6 +150,7 @@ class Focuser {
 
     void readSettings(int index);
     void writeSettings(int index);
+    void writePosition(int index);
 
     int moveRate[FOCUSER_MAX];
     long tcfSteps[FOCUSER_MAX];
@@ -25,7 +25,7 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *supressFr
     //            Returns: sDD*MM'SS.SSS# (high precision)
     if (command[1] == 'A' && (parameter[0] == 0 || parameter[1] == 0)) {
       if (parameter[0] == 'H') precisionMode = PM_HIGHEST; else if (parameter[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
-      convert.doubleToDms(reply, radToDeg(getPosition(CR_MOUNT_ALT).a), false, true, precisionMode);
+      convert.doubleToDms(reply, radToDeg(getPositionSnapshot().a), false, true, precisionMode);
       *numericReply = false;
     } else
 
@@ -34,7 +34,7 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *supressFr
     // :GDH#      Returns: sDD*MM:SS.SSS# (high precision)
     if (command[1] == 'D' && (parameter[0] == 0 || parameter[1] == 0)) {
       if (parameter[0] == 'H' || parameter[0] == 'e') precisionMode = PM_HIGHEST; else if (parameter[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
-      convert.doubleToDms(reply, radToDeg(getPosition().d), false, true, precisionMode);
+      convert.doubleToDms(reply, radToDeg(getPositionSnapshot().d), false, true, precisionMode);
       *numericReply = false;
     } else
 
@@ -43,7 +43,7 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *supressFr
     // :GRH#      Returns: HH:MM:SS.SSSS# (high precision)
     if (command[1] == 'R' && (parameter[0] == 0 || parameter[1] == 0)) {
       if (parameter[0] == 'H' || parameter[0] == 'a') precisionMode = PM_HIGHEST; else if (parameter[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
-      convert.doubleToHms(reply, radToHrs(getPosition().r), false, precisionMode);
+      convert.doubleToHms(reply, radToHrs(getPositionSnapshot().r), false, precisionMode);
       *numericReply = false;
     } else
 
@@ -131,7 +131,7 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *supressFr
     //            Returns: DDD*MM'SS.SSS# (high precision)
     if (command[1] == 'Z' && (parameter[0] == 0 || parameter[1] == 0)) {
       if (parameter[0] == 'H') precisionMode = PM_HIGHEST; else if (parameter[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
-      convert.doubleToDms(reply, NormalizeAzimuth(radToDeg(getPosition(CR_MOUNT_HOR).z)), true, false, precisionMode);
+      convert.doubleToDms(reply, NormalizeAzimuth(radToDeg(getPositionSnapshot().z)), true, false, precisionMode);
       *numericReply = false;
     } else return false;
   } else
@@ -6,6 +6,7 @@
 #ifdef MOUNT_PRESENT
 
 #include "../../lib/tasks/OnTask.h"
+#include "../../libApp/nvLog/NvLog.h"
 
 #include "../Telescope.h"
 #include "coordinates/Transform.h"
@@ -108,11 +109,16 @@ void Mount::begin() {
   // restore where we were pointing
   #if MOUNT_COORDS_MEMORY == ON
     if (!goTo.absoluteEncodersPresent && park.state != PS_PARKED) {
-      int8_t lastMountType = nv.readC(NV_MOUNT_LAST_POSITION);
-      if (transform.mountType == lastMountType) {
+      uint8_t lastPosition[9];
+      nv.readBytes(NV_MOUNT_LAST_POSITION, lastPosition, 9);
+      #if NV_LOG_SIZE > 0
+        nvLog.read(NV_LOG_MOUNT_LAST_POSITION, lastPosition, 9);
+      #endif
+      if (transform.mountType == (int8_t)lastPosition[0]) {
         VLF("MSG: Mount, reading last position");
-        float a1 = nv.readF(NV_MOUNT_LAST_POSITION + 1);
-        float a2 = nv.readF(NV_MOUNT_LAST_POSITION + 5);
+        float a1, a2;
+        memcpy(&a1, &lastPosition[1], 4);
+        memcpy(&a2, &lastPosition[5], 4);
         axis1.setInstrumentCoordinate(a1);
         axis2.setInstrumentCoordinate(a2);
       }
@@ -125,8 +131,8 @@ void Mount::begin() {
     transform.align.modelRead();
   #endif
 
-  VF("MSG: Mount, start tracking monitor task (rate 1000ms priority 6)... ");
-  if (tasks.add(1000, 0, true, 6, mountWrapper, "MntTrk")) { VLF("success"); } else { VLF("FAILED!"); }
+  VF("MSG: Mount, start tracking monitor task (rate "); V(1000/TRACK_COMPENSATION_RATE); VF("ms priority 6)... ");
+  if (tasks.add(1000/TRACK_COMPENSATION_RATE, 0, true, 6, mountWrapper, "MntTrk")) { VLF("success"); } else { VLF("FAILED!"); }
 
   update();
 }
@@ -143,6 +149,18 @@ Coordinate Mount::getMountPosition(CoordReturn coordReturn) {
   return current;
 }
 
+// get current position (Native coordinate system) for status queries
+Coordinate Mount::getPositionSnapshot() {
+  updateSnapshot();
+  return snapshotNative;
+}
+
+// get current position (Mount coordinate system) for status queries
+Coordinate Mount::getMountPositionSnapshot() {
+  updateSnapshot();
+  return snapshotMount;
+}
+
 // one time initialization of tracking
 void Mount::trackingAutostart() {
   static bool completed = false;
@@ -173,7 +191,10 @@ void Mount::trackingAutostart() {
 void Mount::tracking(bool state) {
   if (state == true) {
     enable(state);
-    if (isEnabled()) trackingState = TS_SIDEREAL;
+    if (isEnabled()) {
+      trackingState = TS_SIDEREAL;
+      if (trackingStartTimeMs == 0) trackingStartTimeMs = millis();
+    }
   } else
 
   if (state == false) {
@@ -201,7 +222,7 @@ void Mount::enable(bool state) {
 }
 
 // updates the tracking rates, etc. as appropriate for the mount state
-// called once a second by poll() but available here for immediate action
+// called TRACK_COMPENSATION_RATE times a second by poll() but available here for immediate action
 void Mount::update() {
   static int lastStatusFlashMs = 0;
   int statusFlashMs = 0;
@@ -246,20 +267,24 @@ void Mount::update() {
 }
 
 void Mount::poll() {
-  #ifdef HAL_NO_DOUBLE_PRECISION
-    #define DiffRange  0.0087266463F         // 30 arc-minutes in radians
-    #define DiffRange2 0.017453292F          // 60 arc-minutes in radians
-  #else
-    #define DiffRange  2.908882086657216e-4L // 1 arc-minute in radians
-    #define DiffRange2 5.817764173314432e-4L // 2 arc-minutes in radians
-  #endif
-
-  // keep track of where we are pointing
+  // keep track of where we are pointing, once a second
   #if MOUNT_COORDS_MEMORY == ON
-    if (!goTo.absoluteEncodersPresent) {
-      nv.write(NV_MOUNT_LAST_POSITION, transform.mountType);
-      nv.write(NV_MOUNT_LAST_POSITION + 1, (float)axis1.getInstrumentCoordinate());
-      nv.write(NV_MOUNT_LAST_POSITION + 5, (float)axis2.getInstrumentCoordinate());
+    static uint8_t positionCount = 0;
+    if (++positionCount >= TRACK_COMPENSATION_RATE && !goTo.absoluteEncodersPresent) {
+      positionCount = 0;
+      #if NV_LOG_SIZE > 0
+        uint8_t lastPosition[9];
+        float a1 = axis1.getInstrumentCoordinate();
+        float a2 = axis2.getInstrumentCoordinate();
+        lastPosition[0] = transform.mountType;
+        memcpy(&lastPosition[1], &a1, 4);
+        memcpy(&lastPosition[5], &a2, 4);
+        nvLog.write(NV_LOG_MOUNT_LAST_POSITION, lastPosition, 9);
+      #else
+        nv.write(NV_MOUNT_LAST_POSITION, transform.mountType);
+        nv.write(NV_MOUNT_LAST_POSITION + 1, (float)axis1.getInstrumentCoordinate());
+        nv.write(NV_MOUNT_LAST_POSITION + 5, (float)axis2.getInstrumentCoordinate());
+      #endif
     }
   #endif
 
@@ -277,7 +302,6 @@ void Mount::poll() {
     return;
   }
 
-  // get positions 1 (or 30) arc-min ahead and behind the current
   updatePosition(CR_MOUNT_ALL);
   double altitude = current.a;
   double declination = current.d;
@@ -287,67 +311,29 @@ void Mount::poll() {
     transform.mountToTopocentric(&current);
     if (transform.mountType == ALTAZM) transform.horToEqu(&current);
   #endif
-
-  Coordinate ahead = current;
-  Coordinate behind = current;
   Y;
-  ahead.h += DiffRange;
-  behind.h -= DiffRange;
-
-  // create horizon coordinates that would exist ahead and behind the current position
-  if (transform.mountType == ALTAZM) {
-    transform.equToHor(&ahead); Y;
-    transform.equToHor(&behind); Y;
-  }
 
-  // apply (optional) pointing model and refraction
-  if (settings.rc == RC_MODEL || settings.rc == RC_MODEL_DUAL) {
-    transform.topocentricToObservedPlace(&ahead); Y;
-    transform.topocentricToObservedPlace(&behind); Y;
-    transform.observedPlaceToMount(&ahead); Y;
-    transform.observedPlaceToMount(&behind); Y;
-  } else if (settings.rc == RC_REFRACTION || settings.rc == RC_REFRACTION_DUAL) {
-    transform.topocentricToObservedPlace(&ahead); Y;
-    transform.topocentricToObservedPlace(&behind); Y;
-  }
+  // the target moves at the sidereal rate in hour angle plus any tracking rate offsets, find the
+  // axis rates from the partial derivatives of the transforms from topocentric to mount coordinates
+  Coordinate observed = current;
+  float rate1 = 1.0F - trackingRateOffsetRA;
+  float rate2 = trackingRateOffsetDec;
+  bool model = settings.rc == RC_MODEL || settings.rc == RC_MODEL_DUAL;
+  transform.topocentricToMountRates(&observed, settings.rc != RC_NONE, model, &rate1, &rate2);
 
   // drop the dual axis if not enabled
-  if (settings.rc != RC_REFRACTION_DUAL && settings.rc != RC_MODEL_DUAL) { behind.d = ahead.d; }
-
-  // apply tracking rate offset to equatorial coordinates
-  float timeInSeconds = radToHrs(DiffRange)*3600.0F;
-  float trackingRateOffsetRadsRA = siderealToRad(trackingRateOffsetRA)*timeInSeconds;
-  float trackingRateOffsetRadsDec = siderealToRad(trackingRateOffsetDec)*timeInSeconds;
-  ahead.h -= trackingRateOffsetRadsRA;
-  behind.h += trackingRateOffsetRadsRA;
-  ahead.d += trackingRateOffsetRadsDec;
-  behind.d -= trackingRateOffsetRadsDec;
-
-  // transfer to variables named appropriately for mount coordinates
-  float aheadAxis1, aheadAxis2, behindAxis1, behindAxis2;
-  if (transform.mountType == ALTAZM) {
-    transform.equToHor(&ahead);
-    aheadAxis1 = ahead.z;
-    aheadAxis2 = ahead.a;
-    behindAxis1 = behind.z;
-    behindAxis2 = behind.a;
-  } else {
-    aheadAxis1 = ahead.h;
-    aheadAxis2 = ahead.d;
-    behindAxis1 = behind.h;
-    behindAxis2 = behind.d;
-  }
-
-  // calculate the Axis1 tracking rate
-  if (aheadAxis1 < -Deg90 && behindAxis1 > Deg90) aheadAxis1 += Deg360;
-  if (behindAxis1 < -Deg90 && aheadAxis1 > Deg90) behindAxis1 += Deg360;
-  float rate1 = (aheadAxis1 - behindAxis1)/DiffRange2;
-  if (fabs(trackingRateAxis1 - rate1) <= 0.005F) trackingRateAxis1 = (trackingRateAxis1*9.0F + rate1)/10.0F; else trackingRateAxis1 = rate1;
-
-  // calculate the Axis2 Dec/Alt tracking rate
-  float rate2 = (aheadAxis2 - behindAxis2)/DiffRange2;
+  if (transform.mountType != ALTAZM && settings.rc != RC_REFRACTION_DUAL && settings.rc != RC_MODEL_DUAL) rate2 = trackingRateOffsetDec;
   if (current.pierSide == PIER_SIDE_WEST) rate2 = -rate2;
-  if (fabs(trackingRateAxis2 - rate2) <= 0.005F) trackingRateAxis2 = (trackingRateAxis2*9.0F + rate2)/10.0F; else trackingRateAxis2 = rate2;
+
+  // the rates change slowly and smoothly, so use the rate expected halfway to the next update for
+  // a ramp that follows the change between updates
+  float nextRate1 = rate1, nextRate2 = rate2;
+  if (fabs(rate1 - lastRateAxis1) <= 0.005F) nextRate1 += (rate1 - lastRateAxis1)/2.0F;
+  if (fabs(rate2 - lastRateAxis2) <= 0.005F) nextRate2 += (rate2 - lastRateAxis2)/2.0F;
+  lastRateAxis1 = rate1;
+  lastRateAxis2 = rate2;
+  trackingRateAxis1 = nextRate1;
+  trackingRateAxis2 = nextRate2;
 
   // override for special case of near a celestial pole
   if (fabs(declination) > Deg85) {
@@ -399,6 +385,26 @@ void Mount::updatePosition(CoordReturn coordReturn) {
   if (isHome()) current.pierSide = PIER_SIDE_NONE;
 }
 
+void Mount::updateSnapshot() {
+  long steps1 = axis1.getInstrumentCoordinateSteps();
+  long steps2 = axis2.getInstrumentCoordinateSteps();
+
+  // small motion (tracking, guiding) is covered by the age limit, anything more (slews, syncs) refreshes it now
+  #if MOUNT_COORDS_SNAPSHOT != OFF
+    if (snapshotValid && (long)(millis() - snapshotTimeMs) <= MOUNT_COORDS_SNAPSHOT &&
+        labs(steps1 - snapshotSteps1) <= axis1.getStepsPerMeasure()*arcsecToRad(60.0) &&
+        labs(steps2 - snapshotSteps2) <= axis2.getStepsPerMeasure()*arcsecToRad(60.0)) return;
+  #endif
+
+  updatePosition(CR_MOUNT_ALL);
+  snapshotMount = current;
+  snapshotNative = transform.mountToNative(&current, false);
+  snapshotTimeMs = millis();
+  snapshotSteps1 = steps1;
+  snapshotSteps2 = steps2;
+  snapshotValid = true;
+}
+
 Mount mount;
 
 #endif
@@ -56,6 +56,13 @@ class Mount {
     // get current equatorial position (Mount coordinate system)
     Coordinate getMountPosition(CoordReturn coordReturn = CR_MOUNT_EQU);
 
+    // get current position (Native coordinate system) with all coordinates (CR_MOUNT_ALL,) for status queries
+    // this comes from a snapshot that is shared until it is older than MOUNT_COORDS_SNAPSHOT ms or the mount moved > 1'
+    Coordinate getPositionSnapshot();
+
+    // get current position (Mount coordinate system) with all coordinates (CR_MOUNT_ALL,) for status queries
+    Coordinate getMountPositionSnapshot();
+
     // returns true if either of the mount motor drivers report a fault
     inline bool motorFault() { return axis1.motorFault() || axis2.motorFault(); }
 
@@ -88,11 +95,13 @@ class Mount {
     bool syncFromOnStepToEncoders = false;
 
     // updates the tracking rates, etc. as appropriate for the mount state
-    // called once a second by poll() but available here for immediate action
+    // called TRACK_COMPENSATION_RATE times a second by poll() but available here for immediate action
     void update();
 
     void poll();
 
+    unsigned long trackingStartTimeMs = 0; // millis() when tracking first started, for boot time metrics
+
     float trackingRate = 1.0F;            // in sidereal units 1x = 15 arc-seconds/sidereal second
     float trackingRateAxis1 = 0.0F;       // in sidereal units 1x = 15 arc-seconds/sidereal second
     float trackingRateAxis2 = 0.0F;       // in sidereal units 1x = 15 arc-seconds/sidereal second
@@ -117,6 +126,20 @@ class Mount {
     // also includes Mount normalized axis coordinates (a1, a2) where a2 is an instrument coordinate in tangent arm mode
     Coordinate current;
 
+    // refresh the position snapshot if it's stale
+    void updateSnapshot();
+
+    Coordinate snapshotMount;
+    Coordinate snapshotNative;
+    unsigned long snapshotTimeMs = 0;
+    long snapshotSteps1 = 0;
+    long snapshotSteps2 = 0;
+    bool snapshotValid = false;
+
+    // axis rates found at the last update, to follow their rate of change
+    float lastRateAxis1 = 0.0F;
+    float lastRateAxis2 = 0.0F;
+
     TrackingState trackingState = TS_NONE;
 };
 
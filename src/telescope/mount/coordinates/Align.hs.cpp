@@ -46,11 +46,25 @@ void GeoAlign::modelRead() {
   if (model.pdCor  <    -256 || model.pdCor  >    256) { model.pdCor  = 0; DLF("ERR: GeoAlign::readModel(), bad NV pdCor");  }
   if (model.altCor <  -16384 || model.altCor >  16384) { model.altCor = 0; DLF("ERR: GeoAlign::readModel(), bad NV altCor"); }
   if (model.azmCor <  -16384 || model.azmCor >  16384) { model.azmCor = 0; DLF("ERR: GeoAlign::readModel(), bad NV azmCor"); }
+
+  #if ALIGN_MODEL_STREAM == ON
+    // the running sums are kept at the end of NV
+    if (NV_ALIGN_SUMS_SIZE < sizeof(AlignSums)) { nv.initError = true; DL("ERR: GeoAlign::readModel(), NV_ALIGN_SUMS_SIZE error"); }
+    nv.readBytes(nv.size - NV_ALIGN_SUMS_SIZE, &sums, sizeof(AlignSums));
+    if (!(sums.rtr >= 0.0) || sums.count > 65535) { memset(&sums, 0, sizeof(AlignSums)); DLF("ERR: GeoAlign::readModel(), bad NV sums"); }
+    VF("MSG: Align, streaming model has "); V(sums.count); VLF(" points");
+    solveSums();
+  #endif
 }
 
 void GeoAlign::modelWrite() {
   if (AlignModelSize < sizeof(AlignModel)) { nv.initError = true; DL("ERR: GeoAlign::writeModel(), AlignModelSize error"); }
   nv.updateBytes(NV_ALIGN_MODEL_BASE, &model, AlignModelSize);
+
+  #if ALIGN_MODEL_STREAM == ON
+    if (NV_ALIGN_SUMS_SIZE < sizeof(AlignSums)) { nv.initError = true; DL("ERR: GeoAlign::writeModel(), NV_ALIGN_SUMS_SIZE error"); }
+    nv.updateBytes(nv.size - NV_ALIGN_SUMS_SIZE, &sums, sizeof(AlignSums));
+  #endif
 }
 
 void GeoAlign::modelClear() {
@@ -64,53 +78,72 @@ void GeoAlign::modelClear() {
   model.dfCor  = 0;  // altitude axis axis flex
   model.tfCor  = 0;  // tube flex
   modelIsReady = false;
+  modelHasFailed = false;
+  iteration = 0;
+  rms = 0.0F;
+  #if ALIGN_MODEL_STREAM == ON
+    memset(&sums, 0, sizeof(AlignSums));
+  #endif
 }
 
 bool GeoAlign::modelReady() {
   return modelIsReady;
 }
 
+bool GeoAlign::modelFailed() {
+  return modelHasFailed;
+}
+
 CommandError GeoAlign::addStar(int thisStar, int numberStars, Coordinate *actual, Coordinate *mount) {
   // just return if we are processing a model or the star count is out of range, this should never happen
   if (autoModelTask != 0 || thisStar < 1 || thisStar > ALIGN_MAX_NUM_STARS || numberStars < 1 || numberStars > ALIGN_MAX_NUM_STARS) return CE_ALIGN_FAIL;
 
   int i = thisStar - 1;
 
-  this->mount[i].h = mount->h;
-  this->mount[i].d = mount->d;
-  this->actual[i].h = actual->h;
-  this->actual[i].d = actual->d;
+  setCoordinates(actual, mount, &this->actual[i], &this->mount[i]);
+
+  #if ALIGN_MODEL_STREAM == ON
+    // the align stars also start the streaming model
+    accumulate(this->actual[i], this->mount[i]);
+  #endif
+
+  // two or more stars and finished
+  if (thisStar >= 2 && thisStar == numberStars) {
+    createModel(numberStars);
+  }
+
+  return CE_NONE;
+}
+
+void GeoAlign::setCoordinates(Coordinate *actual, Coordinate *mount, AlignCoordinate *alignActual, AlignCoordinate *alignMount) {
+  alignMount->h = mount->h;
+  alignMount->d = mount->d;
+  alignActual->h = actual->h;
+  alignActual->d = actual->d;
 
   if (mountType == ALTAZM) {
     transform.equToHor(mount);
-    this->mount[i].ax1 = mount->z;
-    this->mount[i].ax2 = mount->a;
+    alignMount->ax1 = mount->z;
+    alignMount->ax2 = mount->a;
 
     transform.equToHor(actual);
-    this->actual[i].ax1 = actual->z;
-    this->actual[i].ax2 = actual->a;
+    alignActual->ax1 = actual->z;
+    alignActual->ax2 = actual->a;
   } else {
-    this->mount[i].ax1 = mount->h;
-    this->mount[i].ax2 = mount->d;
+    alignMount->ax1 = mount->h;
+    alignMount->ax2 = mount->d;
 
-    this->actual[i].ax1 = actual->h;
-    this->actual[i].ax2 = actual->d;
+    alignActual->ax1 = actual->h;
+    alignActual->ax2 = actual->d;
   }
 
   if (mount->pierSide == PIER_SIDE_WEST) {
-    this->actual[i].side = -1;
-    this->mount[i].side = -1;
+    alignActual->side = -1;
+    alignMount->side = -1;
   } else {
-    this->actual[i].side = 1;
-    this->mount[i].side = 1;
-  }
-
-  // two or more stars and finished
-  if (thisStar >= 2 && thisStar == numberStars) {
-    createModel(numberStars);
+    alignActual->side = 1;
+    alignMount->side = 1;
   }
-
-  return CE_NONE;
 }
 
 void GeoAlign::createModel(int numberStars) {
@@ -118,24 +151,23 @@ void GeoAlign::createModel(int numberStars) {
 
   // start a task to solve for the model
   modelNumberStars = numberStars;
-  autoModelTask = tasks.add(1, 0, false, 6, autoModelWrapper, "Align");
+  autoModelTask = tasks.add(1, 0, true, 6, autoModelWrapper, "Align");
 }
 
 // returns the correction to be added to the requested RA,Dec to yield the actual RA,Dec that we will arrive at
-void GeoAlign::correct(AlignCoordinate &mount, float sf, float _deo, float _pd, float _pz, float _pe, float _df, float _ff, float _tf, float *a1r, float *a2r) {
-  float DO1,DOh;
-  float PD,PDh;
+void GeoAlign::correct(AlignCoordinate &mount, const float *term, float *a1r, float *a2r) {
+  float DOh;
+  float PDh;
   float PZ,PA;
-  float DF,DFd,TF,FF,FFd,TFh,TFd;
+  float FLd,TF,TFh,TFd;
 
   // ------------------------------------------------------------
   // A. Misalignment due to tube/optics not being perp. to Dec axis
   // negative numbers are further (S) from the NCP, swing to the
   // equator and the effect on declination is 0. At the SCP it
   // becomes a (N) offset.  Unchanged with meridian flips.
-  DO1 = _deo*sf;
   // works on HA.  meridian flips effect this in HA
-  DOh = DO1*(1.0F/mount.cosA2)*mount.side;
+  DOh = term[ALIGN_TERM_DO]*(1.0F/mount.cosA2)*mount.side;
 
   // ------------------------------------------------------------
   // B. Misalignment, Declination axis relative to Polar axis
@@ -143,257 +175,353 @@ void GeoAlign::correct(AlignCoordinate &mount, float sf, float _deo, float _pd,
   // negative numbers are further (S) from the NCP, swing to the
   // equator and the effect on declination is 0.
   // At the SCP it is, again, a (S) offset
-  PD  = _pd*sf;
   // works on HA.
-  PDh = -PD*mount.tanA2*mount.side;
+  PDh = -term[ALIGN_TERM_PD]*mount.tanA2*mount.side;
 
   // ------------------------------------------------------------
   // Misalignment, relative to NCP
   // negative numbers are east of the pole
   // C. polar left-right misalignment
-  PZ  = _pz*sf;
+  PZ  = term[ALIGN_TERM_AZM];
   // D. negative numbers are below the pole
   // polar below-above misalignment
-  PA  = _pe*sf;
-
-  // ------------------------------------------------------------
-  // Axis flex
-  DF  = _df*sf;
-  DFd = -DF*(cosLat*mount.cosA1+sinLat*mount.tanA2);
+  PA  = term[ALIGN_TERM_ALT];
 
   // ------------------------------------------------------------
-  // Fork flex
-  FF  = _ff*sf;
-  FFd = FF*mount.cosA1;
+  // Fork flex or axis flex
+  if (mountType == FORK || mountType == ALTAZM) FLd = term[ALIGN_TERM_FLEX]*mount.cosA1; else
+    FLd = -term[ALIGN_TERM_FLEX]*(cosLat*mount.cosA1 + sinLat*mount.tanA2);
 
   // ------------------------------------------------------------
   // Optical axis sag
-  TF  = _tf*sf;
+  TF  = term[ALIGN_TERM_TF];
 
-  TFh = TF*(cosLat*mount.sinA1*(1.0/mount.cosA2));
-  TFd = TF*(cosLat*mount.cosA1*mount.sinA2-sinLat*mount.cosA2);
+  TFh = TF*(cosLat*mount.sinA1*(1.0F/mount.cosA2));
+  TFd = TF*(cosLat*mount.cosA1*mount.sinA2 - sinLat*mount.cosA2);
 
   // ------------------------------------------------------------
   *a1r  = (-PZ*mount.cosA1*mount.tanA2 + PA*mount.sinA1*mount.tanA2 + DOh + PDh + TFh);
-  *a2r  = (+PZ*mount.sinA1             + PA*mount.cosA1             + DFd + FFd + TFd);
+  *a2r  = (+PZ*mount.sinA1             + PA*mount.cosA1             + FLd + TFd);
 }
 
-void GeoAlign::doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
-  long l,
-
-  _deo_m,_deo_p,
-  _pd_m,_pd_p,
-  _pz_m,_pz_p,
-  _pe_m,_pe_p,
-  _df_m,_df_p,
-  _tf_m,_tf_p,
-  _ff_m,_ff_p,
-  _oh_m,_oh_p,
-  _od_m,_od_p,
-  
-  _deo,_pd,_pz,_pe, _df,_tf,_ff, _ode,_ohe;
-
-  float sf1 = arcsecToRad(sf);
-
-  // search
-  // set Parameter Space
-  _deo_m= -p1 + round(best_deo/sf); _deo_p= p1 + round(best_deo/sf);
-  _pd_m = -p2 + round(best_pd/sf);  _pd_p = p2 + round(best_pd/sf);
-  _pz_m = -p3 + round(best_pz/sf);  _pz_p = p3 + round(best_pz/sf);
-  _pe_m = -p4 + round(best_pe/sf);  _pe_p = p4 + round(best_pe/sf);
-  _tf_m = -p5 + round(best_tf/sf);  _tf_p = p5 + round(best_tf/sf);
-  _ff_m = -p6 + round(best_ff/sf);  _ff_p = p6 + round(best_ff/sf);
-  _df_m = -p7 + round(best_df/sf);  _df_p = p7 + round(best_df/sf);
-  _od_m = -p8 + round(best_ode/sf); _od_p = p8 + round(best_ode/sf);
-  _oh_m = -p9 + round(best_ohe/sf); _oh_p = p9 + round(best_ohe/sf);
-
-  float ma2, ma1;
-  for (_ohe = _oh_m; _ohe <= _oh_p; _ohe++)
-  for (_ode = _od_m; _ode <= _od_p; _ode++) {
-    ode = _ode*sf1;
-    odw = -ode;
-    ohe = _ohe*sf1;
-    ohw = ohe;
-
-    for (l = 0; l < num; l++) {
-      ma1 = mount[l].ax1;
-      ma2 = mount[l].ax2;
-      
-      if (mount[l].side == -1) // west of the mount
-      {
-        ma1 = ma1 + ohw;
-        ma2 = ma2 + odw;
-      } else
-      if (mount[l].side == 1) // east of the mount, default (fork mounts)
-      {
-        ma1 = ma1 + ohe;
-        ma2 = ma2 + ode;
-      }
+void GeoAlign::starResiduals(AlignCoordinate &mount, AlignCoordinate &delta, float cosA2, const float *term, float *r) {
+  // index offsets, axis1 is the same on both sides of the pier and axis2 is reversed on the west side
+  mount.ma1 = mount.ax1 + term[ALIGN_TERM_AX1];
+  mount.ma2 = mount.ax2 + term[ALIGN_TERM_AX2]*mount.side;
 
-      mount[l].ma1 = ma1;
-      mount[l].ma2 = ma2;
-      mount[l].sinA1 = sinf(ma1);
-      mount[l].cosA1 = cosf(ma1);
-      mount[l].sinA2 = sinf(ma2);
-      mount[l].cosA2 = cosf(ma2);
-      mount[l].tanA2 = mount[l].sinA2/mount[l].cosA2;
-    }
+  mount.sinA1 = sinf(mount.ma1);
+  mount.cosA1 = cosf(mount.ma1);
+  mount.sinA2 = sinf(mount.ma2);
+  mount.cosA2 = cosf(mount.ma2);
+  mount.tanA2 = mount.sinA2/mount.cosA2;
 
-    for (_deo = _deo_m; _deo <= _deo_p; _deo++)
-    for (_pd = _pd_m; _pd <= _pd_p; _pd++)
-    for (_pz = _pz_m; _pz <= _pz_p; _pz++)
-    for (_pe = _pe_m; _pe <= _pe_p; _pe++)
-    for (_df = _df_m; _df <= _df_p; _df++)
-    for (_ff = _ff_m; _ff <= _ff_p; _ff++)
-    for (_tf = _tf_m; _tf <= _tf_p; _tf++) {
-
-      // check the combinations for all samples
-      for (l = 0; l < num; l++) {
-        float ma1r, ma2r;
-        correct(mount[l], sf1, _deo, _pd, _pz, _pe, _df, _ff, _tf, &ma1r, &ma2r);
-
-        delta[l].ax1 = actual[l].ax1 - (mount[l].ma1 - ma1r);
-        if (delta[l].ax1 >  Deg180) delta[l].ax1 = delta[l].ax1 - Deg360; else
-        if (delta[l].ax1 < -Deg180) delta[l].ax1 = delta[l].ax1 + Deg360;
-        delta[l].ax2 = actual[l].ax2 - (mount[l].ma2 - ma2r);
-        delta[l].side = mount[l].side;
-      }
+  float ma1r, ma2r;
+  correct(mount, term, &ma1r, &ma2r);
 
-      // calculate the standard deviations
-      float a, b;
-
-      sum1 = 0.0;
-      for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax1*cosf(actual[l].ax2));
-      a = sum1/(num - 1); // was sqrt(sum1/(num - 1))
-
-      sum1 = 0.0;
-      for (l = 0; l < num; l++) sum1 = sum1 + sq(delta[l].ax2);
-      b = sum1/(num - 1); // was sqrt(sum1/(num - 1))
-
-      max_dist = sqrtf(a + b); // was sq(a) + sq(b)
-
-      // remember the best fit
-      if (max_dist < best_dist) {
-        best_dist = max_dist;
-        best_deo  = _deo*sf;
-        best_pd   = _pd*sf;
-        best_pz   = _pz*sf;
-        best_pe   = _pe*sf;
-
-        best_tf   = _tf*sf;
-        best_df   = _df*sf;
-        best_ff   = _ff*sf;
-        
-        if (p8 != 0) best_odw = radToArcsec(odw); else best_odw = best_pe/2.0;
-        if (p8 != 0) best_ode = radToArcsec(ode); else best_ode = -best_pe/2.0;
-        if (p9 != 0) best_ohw = radToArcsec(ohw);
-        if (p9 != 0) best_ohe = radToArcsec(ohe);
-      }
-      
-      Y;
+  // the large axis values are differenced first (as delta) so the residuals keep full precision
+  r[0] = (delta.ax1 - term[ALIGN_TERM_AX1] + ma1r)*cosA2;
+  r[1] = delta.ax2 - term[ALIGN_TERM_AX2]*mount.side + ma2r;
+}
+
+float GeoAlign::residuals(const float *term, float *r) {
+  float sum = 0.0F;
+
+  for (long l = 0; l < num; l++) {
+    starResiduals(mount[l], delta[l], actual[l].cosA2, term, &r[l*2]);
+    sum += sq(r[l*2]) + sq(r[l*2 + 1]);
+  }
+
+  return sum;
+}
+
+bool GeoAlign::solve(double a[][ALIGN_TERMS], double *b, int m) {
+  // decompose a into L L^T, L stored in the lower triangle
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j <= i; j++) {
+      double s = a[i][j];
+      for (int k = 0; k < j; k++) s -= a[i][k]*a[j][k];
+      if (i == j) {
+        if (s <= 0.0) return false;
+        a[i][i] = sqrt(s);
+      } else a[i][j] = s/a[j][j];
     }
   }
+
+  // forward then back substitution
+  for (int i = 0; i < m; i++) {
+    for (int k = 0; k < i; k++) b[i] -= a[i][k]*b[k];
+    b[i] /= a[i][i];
+  }
+  for (int i = m - 1; i >= 0; i--) {
+    for (int k = i + 1; k < m; k++) b[i] -= a[k][i]*b[k];
+    b[i] /= a[i][i];
+  }
+
+  return true;
 }
 
 void GeoAlign::autoModel(int n) {
-  modelIsReady = false;
+  float r[ALIGN_MAX_NUM_STARS*2];
+
+  if (iteration == 0) {
+    modelIsReady = false;
+    modelHasFailed = false;
 
-  VLF("MSG: Align, calculate pointing model start");
-
-  // how many stars?
-  num = n;
-
-  best_dist = 3600.0F*180.0F;
-  best_deo  = 0.0F;
-  best_pd   = 0.0F;
-  best_pz   = 0.0F;
-  best_pe   = 0.0F;
-  best_tf   = 0.0F;
-  best_ff   = 0.0F;
-  best_df   = 0.0F;
-  best_ode  = 0.0F;
-  best_ohe  = 0.0F;
-
-  // figure out the average Axis1 offset as a starting point
-  ohe = 0;
-  float diff;
-  for (l = 0; l < num; l++) {
-    diff = actual[l].ax1 - mount[l].ax1;
-    if (diff >  Deg180) diff = diff - Deg360;
-    if (diff < -Deg180) diff = diff + Deg360;
-    ohe = ohe + diff;
+    VLF("MSG: Align, calculate pointing model start");
+
+    // how many stars?
+    num = n;
+
+    for (long l = 0; l < num; l++) {
+      delta[l].ax1 = actual[l].ax1 - mount[l].ax1;
+      if (delta[l].ax1 >  Deg180) delta[l].ax1 -= Deg360; else
+      if (delta[l].ax1 < -Deg180) delta[l].ax1 += Deg360;
+      delta[l].ax2 = actual[l].ax2 - mount[l].ax2;
+      delta[l].side = mount[l].side;
+      actual[l].cosA2 = cosf(actual[l].ax2);
+    }
+
+    selectTerms(num);
+
+    // start from the average Axis1 offset
+    for (int i = 0; i < ALIGN_TERMS; i++) term[i] = 0.0F;
+    for (long l = 0; l < num; l++) term[ALIGN_TERM_AX1] += delta[l].ax1;
+    term[ALIGN_TERM_AX1] /= num;
+
+    cost = residuals(term, r);
+    lambda = 0.001F;
+    improved = false;
+    iteration = 1;
+    return;
+  }
+
+  bool done = false;
+  bool converged = false;
+
+  // Jacobian by forward differences, one arc-second steps
+  const float h = arcsecToRad(1.0F);
+  float j[ALIGN_MAX_NUM_STARS*2][ALIGN_TERMS];
+  float rs[ALIGN_MAX_NUM_STARS*2];
+  float trial[ALIGN_TERMS];
+  residuals(term, r);
+  for (int c = 0; c < termCount; c++) {
+    for (int i = 0; i < ALIGN_TERMS; i++) trial[i] = term[i];
+    trial[termIndex[c]] += h;
+    residuals(trial, rs);
+    for (int i = 0; i < num*2; i++) j[i][c] = (rs[i] - r[i])/h;
   }
-  ohe = ohe/num;
-  best_ohe = round(radToArcsec(ohe));
-  best_ohw = best_ohe;
-
-  // fork flex or dec axis flex, as appropriate
-  if (mountType == ALTAZM) { Ff = 0; Df = 0; } else if (mountType == FORK) { Ff = 1; Df = 0; } else { Ff = 0; Df = 1; }
-
-  // only search for cone error if > 2 stars
-  int Do = 0;
-  if (num > 2) Do = 1;
-
-  // search, this can handle about 9 degrees of polar misalignment, and 4 degrees of cone error
-  //              DoPdPzPeTfFf Df OdOh
-  doSearch(16384,0 ,0,1,1,0, 0, 0,1,1);
-  doSearch( 8192,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 4096,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 2048,Do,0,1,1,0, 0, 0,1,1);
-  doSearch( 1024,Do,0,1,1,0, 0, 0,1,1);
-  doSearch(  512,Do,0,1,1,0, 0, 0,1,1);
-  #ifdef HAL_SLOW_PROCESSOR
-    doSearch(256,Do,0,1,1,0, 0, 0,1,1);
-    doSearch(128,Do,0,1,1,0, 0, 0,1,1);
-    doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
-  #else
-    if (num > 4) {
-      doSearch(256,Do,1,1,1,0,Ff,Df,1,1);
-      doSearch(128,Do,1,1,1,1,Ff,Df,1,1);
-      doSearch( 64,Do,1,1,1,1,Ff,Df,1,1);
-      #ifdef HAL_FAST_PROCESSOR
-        doSearch( 32,Do,1,1,1,1,Ff,Df,1,1);
-        doSearch( 16,Do,1,1,1,1,Ff,Df,1,1);
-        doSearch(  8,Do,1,1,1,1,Ff,Df,1,1);
-        #ifdef HAL_VFAST_PROCESSOR
-          doSearch(  4,Do,1,1,1,1,Ff,Df,1,1);
-        #endif
-      #endif
-    } else {
-      doSearch(256,Do,0,1,1,0, 0, 0,1,1);
-      doSearch(128,Do,0,1,1,0, 0, 0,1,1);
-      doSearch( 64,Do,0,1,1,0, 0, 0,1,1);
-      doSearch( 32,Do,0,1,1,0, 0, 0,1,1);
-      #ifdef HAL_FAST_PROCESSOR
-        doSearch( 16,Do,0,1,1,0, 0, 0,1,1);
-        doSearch(  8,Do,0,1,1,0, 0, 0,1,1);
-        #ifdef HAL_VFAST_PROCESSOR
-          doSearch(  4,Do,0,1,1,0, 0, 0,1,1);
-        #endif
-      #endif
+
+  // normal equations, damped
+  double a[ALIGN_TERMS][ALIGN_TERMS];
+  double b[ALIGN_TERMS];
+  for (int c = 0; c < termCount; c++) {
+    for (int k = 0; k <= c; k++) {
+      double s = 0.0;
+      for (int i = 0; i < num*2; i++) s += (double)j[i][c]*j[i][k];
+      a[c][k] = s;
+      a[k][c] = s;
     }
-  #endif
+    double s = 0.0;
+    for (int i = 0; i < num*2; i++) s -= (double)j[i][c]*r[i];
+    b[c] = s;
+  }
+  // damping is added in proportion to each diagonal, with a floor so a term the stars don't pin down (a column
+  // of J that is zero) still gets damped and stays put rather than making the system singular
+  double diagMax = 0.0;
+  for (int c = 0; c < termCount; c++) diagMax = max(diagMax, a[c][c]);
+  if (diagMax <= 0.0) diagMax = 1.0;
+  for (int c = 0; c < termCount; c++) a[c][c] += lambda*max(a[c][c], diagMax*1.0E-9);
+
+  if (solve(a, b, termCount)) {
+    for (int i = 0; i < ALIGN_TERMS; i++) trial[i] = term[i];
+    float step = 0.0F;
+    for (int c = 0; c < termCount; c++) { trial[termIndex[c]] += b[c]; step = max(step, (float)fabs(b[c])); }
+
+    float trialCost = residuals(trial, rs);
+    if (trialCost < cost) {
+      // converged when the terms barely move or the fit barely improves
+      if (step < arcsecToRad(0.01F) || cost - trialCost < cost*1.0E-6F) converged = true;
+      for (int i = 0; i < ALIGN_TERMS; i++) term[i] = trial[i];
+      cost = trialCost;
+      improved = true;
+      lambda = max(lambda*0.1F, 1.0E-7F);
+    } else lambda *= 10.0F;
+  } else lambda *= 10.0F;
+
+  // no step improves the fit any more, this is the best it gets if the fit improved along the way (or started exact)
+  if (lambda > 1.0E6F) converged = improved || sqrtf(cost/num) < arcsecToRad(0.01F);
+
+  if (converged || lambda > 1.0E6F || ++iteration > 100 || isnan(cost)) done = true;
+  if (!done) return;
+
+  iteration = 0;
+  tasks.setDurationComplete(autoModelTask);
+  autoModelTask = 0;
 
-  // geometric corrections
-  model.doCor = arcsecToRad(best_deo);
-  model.pdCor = arcsecToRad(best_pd);
-  model.azmCor = arcsecToRad(best_pz);
-  model.altCor = arcsecToRad(best_pe);
+  if (!converged || isnan(cost)) {
+    // leave the model cleared rather than use terms that didn't settle
+    for (int i = 0; i < ALIGN_TERMS; i++) term[i] = 0.0F;
+    setModel();
+    rms = 0.0F;
+    modelHasFailed = true;
+    DLF("ERR: Align, calculate pointing model failed");
+    return;
+  }
 
-  model.tfCor = arcsecToRad(best_tf);
-  if (mountType == FORK || mountType == ALTAZM) model.dfCor = arcsecToRad(best_ff); else model.dfCor = arcsecToRad(best_df);
+  // per star and overall residuals
+  residuals(term, r);
+  for (long l = 0; l < num; l++) residual[l] = sqrtf(sq(r[l*2]) + sq(r[l*2 + 1]));
+  rms = sqrtf(cost/num);
 
-  model.ax1Cor = arcsecToRad(best_ohw);
-  model.ax2Cor = arcsecToRad(best_odw);
+  setModel();
 
   // update status and exit
   modelIsReady = true;
 
-  VLF("MSG: Align, calculate pointing model done");
-  tasks.setDurationComplete(autoModelTask);
-  autoModelTask = 0;
+  VF("MSG: Align, calculate pointing model done, rms "); V(radToArcsec(rms)); VLF(" arc-seconds");
+}
+
+void GeoAlign::selectTerms(long n) {
+  termCount = 0;
+  termIndex[termCount++] = ALIGN_TERM_AX1;
+  termIndex[termCount++] = ALIGN_TERM_AX2;
+  termIndex[termCount++] = ALIGN_TERM_AZM;
+  termIndex[termCount++] = ALIGN_TERM_ALT;
+  if (n > 2) termIndex[termCount++] = ALIGN_TERM_DO;
+  if (n > 4) {
+    termIndex[termCount++] = ALIGN_TERM_PD;
+    termIndex[termCount++] = ALIGN_TERM_TF;
+    if (mountType != ALTAZM) termIndex[termCount++] = ALIGN_TERM_FLEX;
+  }
+}
+
+void GeoAlign::setModel() {
+  // geometric corrections
+  model.doCor = term[ALIGN_TERM_DO];
+  model.pdCor = term[ALIGN_TERM_PD];
+  model.azmCor = term[ALIGN_TERM_AZM];
+  model.altCor = term[ALIGN_TERM_ALT];
+
+  model.tfCor = term[ALIGN_TERM_TF];
+  model.dfCor = term[ALIGN_TERM_FLEX];
+
+  model.ax1Cor = term[ALIGN_TERM_AX1];
+  model.ax2Cor = -term[ALIGN_TERM_AX2];
+}
+
+#if ALIGN_MODEL_STREAM == ON
+
+// index into the lower triangle of J'J for j <= i
+#define SUMS_INDEX(i, j) ((i)*((i) + 1)/2 + (j))
+
+CommandError GeoAlign::addPoint(Coordinate *actual, Coordinate *mount) {
+  // not while the align stars are being processed
+  if (autoModelTask != 0) return CE_ALIGN_FAIL;
+
+  AlignCoordinate alignActual, alignMount;
+  setCoordinates(actual, mount, &alignActual, &alignMount);
+  accumulate(alignActual, alignMount);
+
+  if (solveSums()) {
+    VF("MSG: Align, streaming model "); V(sums.count); VF(" points, rms "); V(radToArcsec(rms)); VLF(" arc-seconds");
+  }
+
+  return CE_NONE;
+}
+
+void GeoAlign::accumulate(AlignCoordinate &actual, AlignCoordinate &mount) {
+  AlignCoordinate d;
+  d.ax1 = actual.ax1 - mount.ax1;
+  if (d.ax1 >  Deg180) d.ax1 -= Deg360; else
+  if (d.ax1 < -Deg180) d.ax1 += Deg360;
+  d.ax2 = actual.ax2 - mount.ax2;
+  float cosA2 = cosf(actual.ax2);
+
+  // the sums can't be revisited so the residuals are linearized about the model in use now, r ~ b - J x
+  // where b = r0 + J x0, as the model settles the points added are described more and more exactly
+  float x0[ALIGN_TERMS];
+  x0[ALIGN_TERM_AX1] = model.ax1Cor;
+  x0[ALIGN_TERM_AX2] = -model.ax2Cor;
+  x0[ALIGN_TERM_DO] = model.doCor;
+  x0[ALIGN_TERM_PD] = model.pdCor;
+  x0[ALIGN_TERM_AZM] = model.azmCor;
+  x0[ALIGN_TERM_ALT] = model.altCor;
+  x0[ALIGN_TERM_TF] = model.tfCor;
+  x0[ALIGN_TERM_FLEX] = model.dfCor;
+  if (!modelIsReady) for (int i = 0; i < ALIGN_TERMS; i++) x0[i] = 0.0F;
+
+  float r0[2];
+  starResiduals(mount, d, cosA2, x0, r0);
+
+  // Jacobian by forward differences, one arc-second steps
+  const float h = arcsecToRad(1.0F);
+  float j[2][ALIGN_TERMS];
+  float trial[ALIGN_TERMS];
+  float rs[2];
+  for (int t = 0; t < ALIGN_TERMS; t++) {
+    for (int i = 0; i < ALIGN_TERMS; i++) trial[i] = x0[i];
+    trial[t] += h;
+    starResiduals(mount, d, cosA2, trial, rs);
+    j[0][t] = (r0[0] - rs[0])/h;
+    j[1][t] = (r0[1] - rs[1])/h;
+  }
+
+  double b[2];
+  for (int k = 0; k < 2; k++) {
+    b[k] = r0[k];
+    for (int t = 0; t < ALIGN_TERMS; t++) b[k] += (double)j[k][t]*x0[t];
+  }
+
+  for (int i = 0; i < ALIGN_TERMS; i++) {
+    for (int k = 0; k <= i; k++) sums.jtj[SUMS_INDEX(i, k)] += (double)j[0][i]*j[0][k] + (double)j[1][i]*j[1][k];
+    sums.jtr[i] += j[0][i]*b[0] + j[1][i]*b[1];
+  }
+  sums.rtr += b[0]*b[0] + b[1]*b[1];
+  sums.count++;
+}
+
+bool GeoAlign::solveSums() {
+  if (sums.count < 2) return false;
+
+  double a[ALIGN_TERMS][ALIGN_TERMS];
+  double b[ALIGN_TERMS];
+
+  // if the points don't pin down all the terms the number of points allows fall back to the basic ones
+  selectTerms(sums.count);
+  for (int pass = 0; pass < 2; pass++) {
+    for (int c = 0; c < termCount; c++) {
+      for (int k = 0; k < termCount; k++) {
+        int i = max(termIndex[c], termIndex[k]);
+        int j = min(termIndex[c], termIndex[k]);
+        a[c][k] = sums.jtj[SUMS_INDEX(i, j)];
+      }
+      b[c] = sums.jtr[termIndex[c]];
+    }
+    if (solve(a, b, termCount)) break;
+    if (pass == 1 || termCount <= 4) { DLF("WRN: Align, streaming model points don't support a solution"); return false; }
+    selectTerms(2);
+  }
+
+  for (int i = 0; i < ALIGN_TERMS; i++) term[i] = 0.0F;
+  double fit = 0.0;
+  for (int c = 0; c < termCount; c++) {
+    term[termIndex[c]] = b[c];
+    fit += b[c]*sums.jtr[termIndex[c]];
+  }
+
+  // at the least squares solution the remaining sum of squares is r'r - x'J'r
+  double remaining = sums.rtr - fit;
+  if (remaining < 0.0) remaining = 0.0;
+  rms = sqrt(remaining/sums.count);
+
+  setModel();
+  modelIsReady = true;
+
+  return true;
 }
 
+#endif
+
 void GeoAlign::observedPlaceToMount(Coordinate *coord) {
   if (!modelIsReady) return;
 
@@ -467,6 +595,58 @@ void GeoAlign::observedPlaceToMount(Coordinate *coord) {
   }
 }
 
+void GeoAlign::observedPlaceToMountRates(Coordinate *coord, float *rate1, float *rate2) {
+  if (!modelIsReady) return;
+
+  float p = 1.0F;
+  if (coord->pierSide == PIER_SIDE_WEST) p = -1.0F;
+
+  // the corrections are found at the mount coordinate (less the index offsets)
+  Coordinate mount = *coord;
+  observedPlaceToMount(&mount);
+
+  float ax1, ax2;
+  if (mountType == ALTAZM) {
+    ax1 = mount.z + model.ax1Cor;
+    ax2 = mount.a + model.ax2Cor*-p;
+  } else {
+    ax1 = mount.h + model.ax1Cor;
+    ax2 = mount.d + model.ax2Cor*-p;
+  }
+
+  // breaks-down near the poles (limited to > 1' from pole)
+  if (fabs(ax2) >= degToRadF(89.98333333F)) return;
+
+  float sinAx2 = sinf(ax2);
+  float cosAx2 = cosf(ax2);
+  float sinAx1 = sinf(ax1);
+  float cosAx1 = cosf(ax1);
+  float tanAx2 = sinAx2/cosAx2;
+  float secSqAx2 = 1.0F/(cosAx2*cosAx2);
+
+  // partial derivatives of the corrections in observedPlaceToMount()
+  float d11 = model.azmCor*sinAx1*tanAx2 + model.altCor*cosAx1*tanAx2 + model.tfCor*cosLat*cosAx1/cosAx2;
+  float d12 = (-model.azmCor*cosAx1 + model.altCor*sinAx1 - model.pdCor*p + model.doCor*sinAx2*p + model.tfCor*cosLat*sinAx1*sinAx2)*secSqAx2;
+  float d21 = model.azmCor*cosAx1 - model.altCor*sinAx1 - model.tfCor*cosLat*sinAx1*sinAx2;
+  float d22 = model.tfCor*(cosLat*cosAx1*cosAx2 + sinLat*sinAx2);
+  if (mountType == FORK || mountType == ALTAZM) d21 -= model.dfCor*sinAx1; else {
+    d21 += model.dfCor*cosLat*sinAx1;
+    d22 -= model.dfCor*sinLat*secSqAx2;
+  }
+
+  // the mount coordinate is the observed place plus the corrections at the mount coordinate, so the
+  // mount rates are the observed rates times the inverse of (I - D)
+  float m11 = 1.0F - d11, m12 = -d12;
+  float m21 = -d21, m22 = 1.0F - d22;
+  float det = m11*m22 - m12*m21;
+  if (fabs(det) < 0.1F) return;
+
+  float r1 = *rate1;
+  float r2 = *rate2;
+  *rate1 = (m22*r1 - m12*r2)/det;
+  *rate2 = (m11*r2 - m21*r1)/det;
+}
+
 void GeoAlign::mountToObservedPlace(Coordinate *coord) {
   if (!modelIsReady) return;
 
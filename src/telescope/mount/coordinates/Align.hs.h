@@ -65,6 +65,28 @@ typedef struct AlignModel {
   float tfCor;
 } AlignModel;
 
+// pointing model terms, as solved for
+#define ALIGN_TERM_AX1   0   // axis1 index offset
+#define ALIGN_TERM_AX2   1   // axis2 index offset (sign follows the pier side)
+#define ALIGN_TERM_DO    2   // optics not perpendicular to axis2
+#define ALIGN_TERM_PD    3   // axis2 not perpendicular to axis1
+#define ALIGN_TERM_AZM   4   // polar misalignment left-right
+#define ALIGN_TERM_ALT   5   // polar misalignment below-above
+#define ALIGN_TERM_TF    6   // tube flex
+#define ALIGN_TERM_FLEX  7   // fork flex or axis2 flex
+#define ALIGN_TERMS      8
+
+#if ALIGN_MODEL_STREAM == ON
+// running sums of the normal equations for the streaming pointing model, with J the residual change
+// per model term and r the residual with no model, the lower triangle of J'J is stored row by row
+typedef struct AlignSums {
+  double jtj[ALIGN_TERMS*(ALIGN_TERMS + 1)/2];
+  double jtr[ALIGN_TERMS];
+  double rtr;
+  uint32_t count;
+} AlignSums;
+#endif
+
 class GeoAlign
 {
   public:
@@ -79,6 +101,8 @@ class GeoAlign
     void modelClear();
     // reports if ready for operation
     bool modelReady();
+    // reports if the pointing model for the last align couldn't be solved for
+    bool modelFailed();
 
     // add a star to an alignment model
     // thisStar: 1 for 1st star, 2 for 2nd star, etc. up to numberStars (at which point the mount model is calculated)
@@ -88,38 +112,78 @@ class GeoAlign
     CommandError addStar(int thisStar, int numberStars, Coordinate *actual, Coordinate *mount);
 
     void createModel(int numberStars);
+
+    #if ALIGN_MODEL_STREAM == ON
+      // add a point to the streaming pointing model and refit, the model can grow to any number of points
+      // actual: equatorial or horizon coordinate (depending on the mount type) for where the star should be (in mount coordinates)
+      // mount:  equatorial or horizon coordinate (depending on the mount type) for where the star is (in mount coordinates)
+      CommandError addPoint(Coordinate *actual, Coordinate *mount);
+
+      // number of points in the streaming pointing model
+      inline uint32_t pointCount() { return sums.count; }
+    #endif
     
     // convert equatorial (h,d) or horizon (a,z) coordinate from observed place to mount
     void observedPlaceToMount(Coordinate *coord);
     // convert equatorial (h,d) or horizon (a,z) coordinate from mount to observed place
     void mountToObservedPlace(Coordinate *coord);
+    // convert axis rates at an equatorial (h,d) or horizon (a,z) coordinate from observed place to mount
+    void observedPlaceToMountRates(Coordinate *coord, float *rate1, float *rate2);
 
+    // solves for the pointing model, one Levenberg-Marquardt iteration per call until done
     void autoModel(int n);
 
+    // pointing error remaining at each star and overall after the model is applied, in radians
+    float residual[ALIGN_MAX_NUM_STARS];
+    float rms = 0.0F;
+
     AlignCoordinate mount[ALIGN_MAX_NUM_STARS];
     AlignCoordinate actual[ALIGN_MAX_NUM_STARS];
     AlignCoordinate delta[ALIGN_MAX_NUM_STARS];
     AlignModel model;
 
   private:
-    void correct(AlignCoordinate &mount, float sf, float _deo, float _pd, float _pz, float _pe, float _da, float _ff, float _tf, float *h1, float *d1);
-    void doSearch(float sf, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9);
+    // copy the actual and mount coordinates of a star into align coordinates
+    void setCoordinates(Coordinate *actual, Coordinate *mount, AlignCoordinate *alignActual, AlignCoordinate *alignMount);
+    // choose the terms to solve for, only those the number of stars can support
+    void selectTerms(long n);
+    // set the model from the solved terms
+    void setModel();
+
+    void correct(AlignCoordinate &mount, const float *term, float *a1r, float *a2r);
+    // residuals (two) for one star, with delta the actual less the mount coordinate, for the model terms given
+    void starResiduals(AlignCoordinate &mount, AlignCoordinate &delta, float cosA2, const float *term, float *r);
+    // residuals (two per star) for the model terms given, returns the sum of their squares
+    float residuals(const float *term, float *r);
+    // solve the m x m system a x = b in place by Cholesky decomposition, returns false if not positive definite
+    bool solve(double a[][ALIGN_TERMS], double *b, int m);
 
     bool modelIsReady = false;
+    bool modelHasFailed = false;
     int8_t mountType;
     float cosLat, sinLat;
 
-    long num, l;
-    long Ff, Df;
-    float best_deo, best_pd, best_pz, best_pe, best_ohw, best_odw, best_ohe, best_ode, best_tf, best_df, best_ff;
-    float avg_ha, avg_dec;
-    float dist, sumd, rms;
-    float best_dist;
-    float ohe, ode, ohw, odw, dh;
-    float sum1;
-    float max_dist;
+    long num;
+
+    // solver state
+    float term[ALIGN_TERMS];
+    int8_t termIndex[ALIGN_TERMS];
+    int termCount = 0;
+    float cost = 0.0F;
+    float lambda = 0.0F;
+    bool improved = false;
+    int iteration = 0;
 
     uint8_t autoModelTask = 0;
+
+    #if ALIGN_MODEL_STREAM == ON
+      // add the normal equation terms for a star to the running sums
+      void accumulate(AlignCoordinate &actual, AlignCoordinate &mount);
+      // solve the running sums for the model terms, returns false if there aren't enough points
+      bool solveSums();
+
+      AlignSums sums;
+    #endif
 };
 
 #endif
@@ -444,6 +444,58 @@ void GeoAlign::observedPlaceToMount(Coordinate *coord) {
   }
 }
 
+void GeoAlign::observedPlaceToMountRates(Coordinate *coord, float *rate1, float *rate2) {
+  if (!modelIsReady) return;
+
+  float p = 1.0F;
+  if (coord->pierSide == PIER_SIDE_WEST) p = -1.0F;
+
+  // the corrections are found at the mount coordinate (less the index offsets)
+  Coordinate mount = *coord;
+  observedPlaceToMount(&mount);
+
+  float ax1, ax2;
+  if (mountType == ALTAZM) {
+    ax1 = mount.z + model.ax1Cor;
+    ax2 = mount.a + model.ax2Cor*-p;
+  } else {
+    ax1 = mount.h + model.ax1Cor;
+    ax2 = mount.d + model.ax2Cor*-p;
+  }
+
+  // breaks-down near the poles (limited to > 1' from pole)
+  if (fabs(ax2) >= degToRadF(89.98333333F)) return;
+
+  float sinAx2 = sinf(ax2);
+  float cosAx2 = cosf(ax2);
+  float sinAx1 = sinf(ax1);
+  float cosAx1 = cosf(ax1);
+  float tanAx2 = sinAx2/cosAx2;
+  float secSqAx2 = 1.0F/(cosAx2*cosAx2);
+
+  // partial derivatives of the corrections in observedPlaceToMount()
+  float d11 = model.azmCor*sinAx1*tanAx2 + model.altCor*cosAx1*tanAx2 + model.tfCor*cosLat*cosAx1/cosAx2;
+  float d12 = (-model.azmCor*cosAx1 + model.altCor*sinAx1 - model.pdCor*p + model.doCor*sinAx2*p + model.tfCor*cosLat*sinAx1*sinAx2)*secSqAx2;
+  float d21 = model.azmCor*cosAx1 - model.altCor*sinAx1 - model.tfCor*cosLat*sinAx1*sinAx2;
+  float d22 = model.tfCor*(cosLat*cosAx1*cosAx2 + sinLat*sinAx2);
+  if (mountType == FORK || mountType == ALTAZM) d21 -= model.dfCor*sinAx1; else {
+    d21 += model.dfCor*cosLat*sinAx1;
+    d22 -= model.dfCor*sinLat*secSqAx2;
+  }
+
+  // the mount coordinate is the observed place plus the corrections at the mount coordinate, so the
+  // mount rates are the observed rates times the inverse of (I - D)
+  float m11 = 1.0F - d11, m12 = -d12;
+  float m21 = -d21, m22 = 1.0F - d22;
+  float det = m11*m22 - m12*m21;
+  if (fabs(det) < 0.1F) return;
+
+  float r1 = *rate1;
+  float r2 = *rate2;
+  *rate1 = (m22*r1 - m12*r2)/det;
+  *rate2 = (m11*r2 - m21*r1)/det;
+}
+
 void GeoAlign::mountToObservedPlace(Coordinate *coord) {
   if (!modelIsReady) return;
 
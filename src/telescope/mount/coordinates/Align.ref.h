@@ -78,6 +78,8 @@ class GeoAlign
     void modelClear();
     // reports if ready for operation
     bool modelReady();
+    // reports if the pointing model for the last align couldn't be solved for (the search always finds one)
+    inline bool modelFailed() { return false; }
 
     // add a star to an alignment model
     // thisStar: 1 for 1st star, 2 for 2nd star, etc. up to numberStars (at which point the mount model is calculated)
@@ -92,6 +94,8 @@ class GeoAlign
     void observedPlaceToMount(Coordinate *coord);
     // convert equatorial (h,d) or horizon (a,z) coordinate from mount to observed place
     void mountToObservedPlace(Coordinate *coord);
+    // convert axis rates at an equatorial (h,d) or horizon (a,z) coordinate from observed place to mount
+    void observedPlaceToMountRates(Coordinate *coord, float *rate1, float *rate2);
 
     void autoModel(int n);
 
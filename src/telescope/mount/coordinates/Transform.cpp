@@ -154,6 +154,41 @@ void Transform::topocentricToObservedPlace(Coordinate *coord) {
   } else coord->a += trueRefrac(coord->a);
 }
 
+void Transform::topocentricToMountRates(Coordinate *coord, bool refraction, bool model, float *rate1, float *rate2) {
+  double r1 = *rate1;
+  double r2 = *rate2;
+
+  // within about 1/20 arc-second of NCP or SCP refraction is left out, as in topocentricToObservedPlace()
+  if (mountType != ALTAZM && (fabs(coord->d - Deg90) < OneArcSec || fabs(coord->d + Deg90) < OneArcSec)) refraction = false;
+
+  if (mountType == ALTAZM || refraction) {
+    equToHor(coord);
+    equToHorRates(coord->h, coord->d, &r1, &r2);
+    if (refraction) {
+      r2 *= 1.0 + trueRefracRate(coord->a);
+      coord->a += trueRefrac(coord->a);
+    }
+    if (mountType != ALTAZM) {
+      horToEqu(coord);
+      equToHorRates(coord->z, coord->a, &r1, &r2);
+    }
+  }
+
+  #if ALIGN_MAX_NUM_STARS > 1
+    if (model && coord->pierSide != PIER_SIDE_NONE) {
+      float f1 = r1, f2 = r2;
+      align.observedPlaceToMountRates(coord, &f1, &f2);
+      r1 = f1;
+      r2 = f2;
+    }
+  #else
+    (void)(model);
+  #endif
+
+  *rate1 = r1;
+  *rate2 = r2;
+}
+
 Coordinate Transform::instrumentToMount(double a1, double a2) {
   Coordinate mount;
 
@@ -231,6 +266,27 @@ void Transform::equToHor(Coordinate *coord) {
   if (coord->z > Deg180) coord->z -= Deg360;
 }
 
+void Transform::equToHorRates(double h, double d, double *rate1, double *rate2) {
+  double sinHA  = sin(h);
+  double cosHA  = cos(h);
+  double sinDec = sin(d);
+  double cosDec = cos(d);
+  double sinLat = site.locationEx.latitude.sine;
+  double cosLat = site.locationEx.latitude.cosine;
+
+  // partial derivatives of asin(sinAlt) and atan2(t1, t2) as used in equToHor()
+  double sinAlt = sinDec*sinLat + cosDec*cosLat*cosHA;
+  double cosAlt = sqrt(1.0 - sinAlt*sinAlt);
+  double t1     = sinHA;
+  double t2     = cosHA*sinLat - (sinDec/cosDec)*cosLat;
+  double t      = t1*t1 + t2*t2;
+
+  double rh = *rate1;
+  double rd = *rate2;
+  if (t > 0.0) *rate1 = ((t2*cosHA + sinHA*sinHA*sinLat)*rh + (sinHA*cosLat/(cosDec*cosDec))*rd)/t; else *rate1 = 0.0;
+  if (cosAlt > 0.0) *rate2 = (-cosDec*cosLat*sinHA*rh + (cosDec*sinLat - sinDec*cosLat*cosHA)*rd)/cosAlt; else *rate2 = 0.0;
+}
+
 void Transform::equToAlt(Coordinate *coord) {
   double cosHA  = cos(coord->h);
   double sinAlt = sin(coord->d)*site.locationEx.latitude.sine + cos(coord->d)*site.locationEx.latitude.cosine*cosHA;  
@@ -249,12 +305,19 @@ void Transform::horToEqu(Coordinate *coord) {
 }
 
 double Transform::trueRefrac(double altitude) {
-  float pressure = 1010.0F;
-  float temperature = 10.0F;
-  if (!isnan(weather.getPressure())) pressure = weather.getPressure();
-  if (!isnan(weather.getTemperature())) temperature = weather.getTemperature();
-  float TPC = (pressure/1010.0F)*(283.0F/(273.0F + temperature));
-  float r   = 2.9670597e-4F*cotf(altitude + 0.0031375594F/(altitude + 0.089186324F))*TPC;
+  float pressure = weather.getPressure();
+  float temperature = weather.getTemperature();
+  if (isnan(pressure)) pressure = 1010.0F;
+  if (isnan(temperature)) temperature = 10.0F;
+
+  // the pressure and temperature term only changes with the weather
+  if (pressure != refracPressure || temperature != refracTemperature) {
+    refracPressure = pressure;
+    refracTemperature = temperature;
+    refracTPC = (pressure/1010.0F)*(283.0F/(273.0F + temperature));
+  }
+
+  float r   = 2.9670597e-4F*cotf(altitude + 0.0031375594F/(altitude + 0.089186324F))*refracTPC;
   if (r < 0.0F) r = 0.0F;
   return r;
 }
@@ -264,6 +327,13 @@ double Transform::apparentRefrac(double altitude) {
   return trueRefrac(altitude - r);
 }
 
+double Transform::trueRefracRate(double altitude) {
+  if (trueRefrac(altitude) <= 0.0) return 0.0;
+  float d = altitude + 0.089186324F;
+  float s = sinf(altitude + 0.0031375594F/d);
+  return -2.9670597e-4F*refracTPC*(1.0F - 0.0031375594F/(d*d))/(s*s);
+}
+
 float Transform::cotf(float n) {
   return 1.0F/tanf(n);
 }
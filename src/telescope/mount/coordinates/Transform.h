@@ -43,6 +43,11 @@ class Transform {
     // converts from Observed to Mount coordinates (adds pointing model to coordinates)
     void observedPlaceToMount(Coordinate *coord);
 
+    // converts the rates of motion in hour angle and declination of a Topocentric coordinate to Mount axis
+    // rates (all in multiples of the sidereal rate) by the chain rule through the optional refraction and
+    // pointing model, coord is set to the Observed place (with horizon coordinates for ALTAZM mounts)
+    void topocentricToMountRates(Coordinate *coord, bool refraction, bool model, float *rate1, float *rate2);
+
     // converts from Instrument (angular) to Mount (equatorial or horizon) coordinates
     Coordinate instrumentToMount(double a1, double a2);
     // converts from Mount (equatorial or horizon) to Instrument (angular) coordinates
@@ -61,6 +66,9 @@ class Transform {
 
     // converts from Equatorial (h,d) to Horizon (a,z) coordinates
     void equToHor(Coordinate *coord);
+    // converts rates in Equatorial (h,d) to rates in Horizon (z,a) coordinates at the coordinate given, and
+    // since the conversion has the same form rates in Horizon (z,a) to rates in Equatorial (h,d) coordinates
+    void equToHorRates(double h, double d, double *rate1, double *rate2);
     // converts from Equatorial (h,d) to Horizon (a) altitude coordinate
     void equToAlt(Coordinate *coord);
     // converts from Equatorial (h,d) to Horizon (a,z) coordinates
@@ -72,6 +80,8 @@ class Transform {
     // refraction at altitude, pressure (millibars), and temperature (celsius)
     // returns the amount of refraction at the apparent altitude
     double apparentRefrac(double altitude);
+    // rate of change of the refraction with altitude at the true altitude
+    double trueRefracRate(double altitude);
 
     #if ALIGN_MAX_NUM_STARS > 1  
       GeoAlign align;
@@ -82,6 +92,11 @@ class Transform {
   private:
 
     float cotf(float n);
+
+    // cached refraction pressure and temperature term
+    float refracPressure = NAN;
+    float refracTemperature = NAN;
+    float refracTPC = 1.0F;
     
     // adjust coordinate back into 0 to 360 "degrees" range (in radians)
     double backInRads(double angle);
@@ -20,9 +20,10 @@ bool Goto::command(char *reply, char *command, char *parameter, bool *supressFra
   if (command[0] == 'A') {
     // :AW#       Align Write to EEPROM
     //            Returns: 1 on success
+    //                     0 on failure (the pointing model for the last align couldn't be solved for)
     if (command[1] == 'W' && parameter[0] == 0) {
       #if ALIGN_MAX_NUM_STARS > 1  
-        transform.align.modelWrite();
+        if (transform.align.modelFailed()) *commandError = CE_ALIGN_FAIL; else transform.align.modelWrite();
       #endif
     } else
 
@@ -80,7 +81,20 @@ bool Goto::command(char *reply, char *command, char *parameter, bool *supressFra
           DLF("ERR: Mount, failed to add align point");
         } else { VLF("MSG: Mount, align point added"); }
       } else *commandError = CE_ALIGN_NOT_ACTIVE;
-    } else *commandError = CE_CMD_UNKNOWN;
+    } else
+
+    #if ALIGN_MAX_NUM_STARS > 1 && ALIGN_MODEL_STREAM == ON
+      // :AP#       Align add point, adds the current target location to the streaming pointing model
+      //            for where the mount is now pointing and refits the model
+      //            Return: 0 on failure
+      //                    1 on success
+      if (command[1] == 'P' && parameter[0] == 0) {
+        CommandError e = alignAddPoint();
+        if (e != CE_NONE) { *commandError = e; DLF("ERR: Mount, failed to add align point"); } else { VLF("MSG: Mount, align point added"); }
+      } else
+    #endif
+
+    *commandError = CE_CMD_UNKNOWN;
   } else
 
   //  C - Sync Control
@@ -197,8 +211,16 @@ bool Goto::command(char *reply, char *command, char *parameter, bool *supressFra
             case 'B': { convert.doubleToDms(reply,radToDeg(transform.align.actual[star].d),false,true,PM_HIGH); } break;
             case 'C': { convert.doubleToHms(reply,radToHrs(transform.align.mount[star].h),true,PM_HIGH); } break;
             case 'D': { convert.doubleToDms(reply,radToDeg(transform.align.mount[star].d),false,true,PM_HIGH); } break;
+            // pointing error remaining at this star after the model is applied, in arc-seconds
+            case 'F': sprintF(reply, "%0.1f", radToArcsec(transform.align.residual[star])); break;
             // pier side (and increment n)
             case 'E': sprintf(reply,"%ld",(long)(transform.align.mount[star].side)); star++; break;
+            // pointing error remaining overall (rms) after the model is applied, in arc-seconds
+            case 'G': sprintF(reply, "%0.1f", radToArcsec(transform.align.rms)); break;
+            #if ALIGN_MODEL_STREAM == ON
+              // number of points in the streaming pointing model
+              case 'H': sprintf(reply,"%ld",(long)(transform.align.pointCount())); break;
+            #endif
             default: *numericReply = true; *commandError = CE_CMD_UNKNOWN;
           }
         } else
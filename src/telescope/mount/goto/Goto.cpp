@@ -64,6 +64,11 @@ void Goto::init() {
       AXIS1_TARGET_TOLERANCE != 0.0F || AXIS2_TARGET_TOLERANCE != 0.0F || absoluteEncodersPresent) encodersPresent = true;
 
   updateAccelerationRates();
+
+  #if SLEW_ACCELERATION_SCURVE == ON
+    axis1.setSlewProfile(SP_SCURVE);
+    axis2.setSlewProfile(SP_SCURVE);
+  #endif
 }
 
 // goto to equatorial target position (Native coordinate system) using the defaut preferredPierSide
@@ -392,6 +397,23 @@ CommandError Goto::alignAddStar(bool sync) {
   return e;
 }
 
+#if ALIGN_MAX_NUM_STARS > 1 && ALIGN_MODEL_STREAM == ON
+// add a point to the streaming pointing model (at the current position relative to target)
+CommandError Goto::alignAddPoint() {
+  if (alignActive()) return CE_ALIGN_FAIL;
+
+  // the target without any pointing model applied (that only happens with a pier side given)
+  Coordinate target = gotoTarget;
+  target.pierSide = PIER_SIDE_NONE;
+  transform.nativeToMount(&target);
+
+  Coordinate mountPosition = mount.getMountPosition(CR_MOUNT_ALL);
+  target.pierSide = mountPosition.pierSide;
+
+  return transform.align.addPoint(&target, &mountPosition);
+}
+#endif
+
 // reset the alignment model
 void Goto::alignReset() {
   alignState.currentStar = 0;
@@ -613,7 +635,9 @@ CommandError Goto::startAutoSlew() {
   nearTargetTimeoutAxis1 = millis();
   nearTargetTimeoutAxis2 = millis();
 
-  if (stage == GG_NEAR_DESTINATION || stage == GG_DESTINATION) {
+  // while tracking poll() moves the targets to near the destination from the start, set them there now so the
+  // goto begins (and any synchronization is worked out) for where the axes are really headed
+  if (stage == GG_NEAR_DESTINATION || stage == GG_DESTINATION || (stage == GG_NEAR_DESTINATION_START && mount.isTracking())) {
     destination.h -= slewDestinationDistHA;
     destination.d -= slewDestinationDistDec;
   }
@@ -635,6 +659,32 @@ CommandError Goto::startAutoSlew() {
   e = axis1.autoGoto(radsPerSecondCurrent);
   if (e == CE_NONE) e = axis2.autoGoto(radsPerSecondCurrent*((float)(AXIS2_SLEW_RATE_PERCENT)/100.0F));
 
+  #if GOTO_SYNCHRONIZED == ON
+    // the axis that would arrive first is slowed so both arrive together
+    if (e == CE_NONE) {
+      // while tracking the axis targets move (see poll) so find where they'll be a second from now
+      float rate1 = 0.0F, rate2 = 0.0F;
+      if (mount.isTracking()) {
+        Coordinate later = destination;
+        later.h += siderealToRad(SIDEREAL_RATIO - mount.trackingRateOffsetRA);
+        later.d += siderealToRad(mount.trackingRateOffsetDec);
+        if (transform.mountType == ALTAZM) transform.equToHor(&later);
+
+        double a1Later, a2Later;
+        transform.mountToInstrument(&later, &a1Later, &a2Later);
+        if (transform.mountType == ALTAZM) a1Later += azimuthTargetCorrection;
+
+        // positive when the target moves away from the axis
+        rate1 = (a1Later - a1)*(a1 >= axis1.getInstrumentCoordinate() ? 1.0 : -1.0);
+        rate2 = (a2Later - a2)*(a2 >= axis2.getInstrumentCoordinate() ? 1.0 : -1.0);
+      }
+
+      float seconds = max(axis1.getAutoGotoTime(rate1), axis2.getAutoGotoTime(rate2));
+      axis1.setAutoGotoTime(seconds, rate1);
+      axis2.setAutoGotoTime(seconds, rate2);
+    }
+  #endif
+
   nearTargetTimeout = millis();
 
   return e;
@@ -668,6 +718,11 @@ float Goto::usPerStepLowerLimit() {
     r_us /= 1.6F;
   #endif
 
+  // step signals through a 74HC595 latched in frames take two frames each (plus a margin for timer jitter)
+  #if GPIO_DEVICE == SSR74HC595 && GPIO_SSR74HC595_FRAME_RATE != OFF
+    if (r_us < 2500000.0F/GPIO_SSR74HC595_FRAME_RATE) r_us = 2500000.0F/GPIO_SSR74HC595_FRAME_RATE;
+  #endif
+
   // average required goto us rates for each axis with any micro-step mode switching applied
   float r_us_axis1 = r_us/axis1.getStepsPerStepSlewing();
   float r_us_axis2 = r_us/axis2.getStepsPerStepSlewing();
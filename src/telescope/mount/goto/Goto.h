@@ -71,6 +71,11 @@ class Goto {
     // add an align star (at the current position relative to target)
     CommandError alignAddStar(bool sync = false);
 
+    #if ALIGN_MAX_NUM_STARS > 1 && ALIGN_MODEL_STREAM == ON
+      // add a point to the streaming pointing model (at the current position relative to target)
+      CommandError alignAddPoint();
+    #endif
+
     // reset the alignment model
     void alignReset();
 
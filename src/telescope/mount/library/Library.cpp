@@ -13,7 +13,7 @@ void Library::init() {
   catalog = 0;
 
   byteMin = NV_LIBRARY_DATA_BASE;
-  byteMax = nv.size - 1;
+  byteMax = nv.size - 1 - NV_ALIGN_SUMS_SIZE - NV_LOG_SIZE - NV_CHECKSUM_SIZE;
 
   long byteCount = (byteMax - byteMin) + 1;
   if (byteCount < 0) byteCount = 0;
@@ -21,7 +21,7 @@ typedef struct ParkSettings {
   ParkPosition position;
   bool         saved;
   ParkState    state;
-  long         wormSensePositionSteps;
+  int32_t      wormSensePositionSteps;
 } ParkSettings;
 #pragma pack()
 
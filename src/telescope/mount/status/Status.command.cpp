@@ -16,6 +16,57 @@
 #include "../limits/Limits.h"
 #include "../status/Status.h"
 
+// fill in the bit packed telescope status (as for :Gu#,) 9 bytes and a terminating 0
+void Status::getStatusBits(char reply[]) {
+  memset(reply, (char)0b10000000, 9);
+  if (!mount.isTracking())                     reply[0]|=0b10000001;           // Not tracking
+  if (goTo.state == GS_NONE)                   reply[0]|=0b10000010;           // No goto
+  #if (TIME_LOCATION_PPS_SENSE) != OFF
+    if (pps.synced)                            reply[0]|=0b10000100;           // PPS sync
+  #endif
+  if (guide.activePulseGuide())                reply[0]|=0b10001000;           // Pulse guide active
+
+  if (mount.settings.rc == RC_REFRACTION)      reply[0]|=0b11010000;           // Refr enabled Single axis
+  if (mount.settings.rc == RC_REFRACTION_DUAL) reply[0]|=0b10010000;           // Refr enabled
+  if (mount.settings.rc == RC_MODEL)           reply[0]|=0b11100000;           // OnTrack enabled Single axis
+  if (mount.settings.rc == RC_MODEL_DUAL)      reply[0]|=0b10100000;           // OnTrack enabled
+  if (mount.settings.rc == RC_NONE) {
+    float r = siderealToHz(mount.trackingRate);
+    if (fequal(r, 57.900F))                    reply[1]|=0b10000001; else      // Lunar rate selected
+    if (fequal(r, 60.000F))                    reply[1]|=0b10000010; else      // Solar rate selected
+    if (fequal(r, 60.136F))                    reply[1]|=0b10000011;           // King rate selected
+  }
+
+  if (mount.syncFromOnStepToEncoders)          reply[1]|=0b10000100;           // Sync to encoders only
+  if (guide.active())                          reply[1]|=0b10001000;           // Guide active
+  if (mount.isHome())                          reply[2]|=0b10000001;           // At home
+  if (home.state == HS_HOMING)                 reply[2]|=0b10100000;           // Slewing [h]ome
+  if (goTo.isHomePaused())                     reply[2]|=0b10000010;           // Waiting at home
+  if (goTo.isHomePauseEnabled())               reply[2]|=0b10000100;           // Pause at home enabled?
+  if (sound.enabled)                           reply[2]|=0b10001000;           // Buzzer enabled?
+  if (goTo.isAutoFlipEnabled())                reply[2]|=0b10010000;           // Auto meridian flip
+
+  if (transform.mountType == GEM)              reply[3]|=0b10000001; else      // GEM
+  if (transform.mountType == FORK)             reply[3]|=0b10000010; else      // FORK
+  if (transform.mountType == ALTAZM)           reply[3]|=0b10001000;           // ALTAZM
+
+  Coordinate current = mount.getMountPositionSnapshot();
+  if (current.pierSide == PIER_SIDE_NONE)      reply[3]|=0b10010000; else      // Pier side none
+  if (current.pierSide == PIER_SIDE_EAST)      reply[3]|=0b10100000; else      // Pier side east
+  if (current.pierSide == PIER_SIDE_WEST)      reply[3]|=0b11000000;           // Pier side west
+
+  #if AXIS1_PEC == ON
+    if (transform.mountType != ALTAZM)
+      reply[4] = (int)pec.settings.state|0b10000000;                           // PEC state: 0 ignore, 1 ready play, 2 playing, 3 ready record, 4 recording
+    if (pec.settings.recorded)                 reply[4]|=0b11000000;           // PEC state: data has been recorded
+  #endif
+  reply[5] = (int)park.state|0b10000000;                                       // Park state: 0 not parked, 1 parking in-progress, 2 parked, 3 park failed
+  reply[6] = (int)guide.settings.pulseRateSelect|0b10000000;                   // Pulse-guide selection
+  reply[7] = (int)guide.settings.axis1RateSelect|0b10000000;                   // Guide selection
+  reply[8] = limits.errorCode()|0b10000000;                                    // General error
+  reply[9] = 0;
+}
+
 bool Status::command(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError) {
   UNUSED(supressFrame);
 
@@ -24,7 +75,7 @@ bool Status::command(char *reply, char *command, char *parameter, bool *supressF
     //            Returns: E#, W#, N# (none/parked)
     if (command[1] == 'm' && parameter[0] == 0)  {
       strcpy(reply, "?");
-      Coordinate current = mount.getMountPosition(CR_MOUNT);
+      Coordinate current = mount.getMountPositionSnapshot();
       if (current.pierSide == PIER_SIDE_NONE) reply[0]='N';
       if (current.pierSide == PIER_SIDE_EAST) reply[0]='E';
       if (current.pierSide == PIER_SIDE_WEST) reply[0]='W';
@@ -74,7 +125,7 @@ bool Status::command(char *reply, char *command, char *parameter, bool *supressF
       if (transform.mountType == FORK)         reply[i++]='K'; else                // FORK
       if (transform.mountType == ALTAZM)       reply[i++]='A';                     // ALTAZM
 
-      Coordinate current = mount.getMountPosition(CR_MOUNT);
+      Coordinate current = mount.getMountPositionSnapshot();
       if (current.pierSide == PIER_SIDE_NONE)  reply[i++]='o'; else                // Pier side n[o]ne
       if (current.pierSide == PIER_SIDE_EAST)  reply[i++]='T'; else                // Pier side eas[T]
       if (current.pierSide == PIER_SIDE_WEST)  reply[i++]='W';                     // Pier side [W]est
@@ -91,53 +142,7 @@ bool Status::command(char *reply, char *command, char *parameter, bool *supressF
     // :Gu#       Get bit packed telescope status
     //            Returns: s#
     if (command[1] == 'u' && parameter[0] == 0)  {
-      memset(reply, (char)0b10000000, 9);
-      if (!mount.isTracking())                     reply[0]|=0b10000001;           // Not tracking
-      if (goTo.state == GS_NONE)                   reply[0]|=0b10000010;           // No goto
-      #if (TIME_LOCATION_PPS_SENSE) != OFF
-        if (pps.synced)                            reply[0]|=0b10000100;           // PPS sync
-      #endif
-      if (guide.activePulseGuide())                reply[0]|=0b10001000;           // Pulse guide active
-
-      if (mount.settings.rc == RC_REFRACTION)      reply[0]|=0b11010000;           // Refr enabled Single axis
-      if (mount.settings.rc == RC_REFRACTION_DUAL) reply[0]|=0b10010000;           // Refr enabled
-      if (mount.settings.rc == RC_MODEL)           reply[0]|=0b11100000;           // OnTrack enabled Single axis
-      if (mount.settings.rc == RC_MODEL_DUAL)      reply[0]|=0b10100000;           // OnTrack enabled
-      if (mount.settings.rc == RC_NONE) {
-        float r = siderealToHz(mount.trackingRate);
-        if (fequal(r, 57.900F))                    reply[1]|=0b10000001; else      // Lunar rate selected
-        if (fequal(r, 60.000F))                    reply[1]|=0b10000010; else      // Solar rate selected
-        if (fequal(r, 60.136F))                    reply[1]|=0b10000011;           // King rate selected
-      }
-
-      if (mount.syncFromOnStepToEncoders)          reply[1]|=0b10000100;           // Sync to encoders only
-      if (guide.active())                          reply[1]|=0b10001000;           // Guide active
-      if (mount.isHome())                          reply[2]|=0b10000001;           // At home
-      if (home.state == HS_HOMING)                 reply[2]|=0b10100000;           // Slewing [h]ome
-      if (goTo.isHomePaused())                     reply[2]|=0b10000010;           // Waiting at home
-      if (goTo.isHomePauseEnabled())               reply[2]|=0b10000100;           // Pause at home enabled?
-      if (sound.enabled)                           reply[2]|=0b10001000;           // Buzzer enabled?
-      if (goTo.isAutoFlipEnabled())                reply[2]|=0b10010000;           // Auto meridian flip
-
-      if (transform.mountType == GEM)              reply[3]|=0b10000001; else      // GEM
-      if (transform.mountType == FORK)             reply[3]|=0b10000010; else      // FORK
-      if (transform.mountType == ALTAZM)           reply[3]|=0b10001000;           // ALTAZM
-
-      Coordinate current = mount.getMountPosition(CR_MOUNT);
-      if (current.pierSide == PIER_SIDE_NONE)      reply[3]|=0b10010000; else      // Pier side none
-      if (current.pierSide == PIER_SIDE_EAST)      reply[3]|=0b10100000; else      // Pier side east
-      if (current.pierSide == PIER_SIDE_WEST)      reply[3]|=0b11000000;           // Pier side west
-
-      #if AXIS1_PEC == ON
-        if (transform.mountType != ALTAZM)
-          reply[4] = (int)pec.settings.state|0b10000000;                           // PEC state: 0 ignore, 1 ready play, 2 playing, 3 ready record, 4 recording
-        if (pec.settings.recorded)                 reply[4]|=0b11000000;           // PEC state: data has been recorded
-      #endif
-      reply[5] = (int)park.state|0b10000000;                                       // Park state: 0 not parked, 1 parking in-progress, 2 parked, 3 park failed
-      reply[6] = (int)guide.settings.pulseRateSelect|0b10000000;                   // Pulse-guide selection
-      reply[7] = (int)guide.settings.axis1RateSelect|0b10000000;                   // Guide selection
-      reply[8] = limits.errorCode()|0b10000000;                                    // General error
-      reply[9] = 0;
+      getStatusBits(reply);
       *numericReply = false;
     } else
 
@@ -22,6 +22,9 @@ class Status {
 
     bool command(char *reply, char *command, char *parameter, bool *supressFrame, bool *numericReply, CommandError *commandError);
 
+    // fill in the bit packed telescope status (as for :Gu#,) 9 bytes and a terminating 0
+    void getStatusBits(char reply[]);
+
     // mount status LED flash rate (in ms)
     void flashRate(int period);
 
@@ -6,6 +6,7 @@
 #ifdef ROTATOR_PRESENT
 
 #include "../../lib/tasks/OnTask.h"
+#include "../../libApp/nvLog/NvLog.h"
 
 #include "../Telescope.h"
 #include "../mount/Mount.h"
@@ -209,6 +210,9 @@ CommandError Rotator::unpark() {
 
 void Rotator::readSettings() {
   nv.readBytes(NV_ROTATOR_SETTINGS_BASE + RotatorSettingsSize, &settings, sizeof(RotatorSettings));
+  #if NV_LOG_SIZE > 0
+    nvLog.read(NV_LOG_ROTATOR_POSITION, &settings.position, sizeof(float));
+  #endif
 
   if (settings.backlash < 0)     { settings.backlash = 0; initError.value = true; DLF("ERR: Rotator.init(), bad NV backlash < 0 steps (set to 0)"); }
   if (settings.backlash > 10000) { settings.backlash = 0; initError.value = true; DLF("ERR: Rotator.init(), bad NV backlash > 10000 steps (set to 0)"); }
@@ -219,6 +223,18 @@ void Rotator::readSettings() {
 
 void Rotator::writeSettings() {
   nv.updateBytes(NV_ROTATOR_SETTINGS_BASE + RotatorSettingsSize, &settings, sizeof(RotatorSettings));
+  #if NV_LOG_SIZE > 0
+    nvLog.write(NV_LOG_ROTATOR_POSITION, &settings.position, sizeof(float));
+  #endif
+}
+
+// the position is written to the NV log only (when present) where it's always the most recent
+void Rotator::writePosition() {
+  #if NV_LOG_SIZE > 0
+    nvLog.write(NV_LOG_ROTATOR_POSITION, &settings.position, sizeof(float));
+  #else
+    writeSettings();
+  #endif
 }
 
 // poll rotator to handle parking and derotation
@@ -272,7 +288,7 @@ void Rotator::monitor() {
       if (ROTATOR_WRITE_DELAY != 0) {
         if (secs > writeTime) {
           settings.position = axis3.getInstrumentCoordinate();
-          writeSettings();
+          writePosition();
           VF("MSG: Rotator, writing position ("); V(settings.position); VL(" deg) to NV"); 
         }
       }
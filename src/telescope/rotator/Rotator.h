@@ -82,6 +82,7 @@ class Rotator {
 
     void readSettings();
     void writeSettings();
+    void writePosition();
 
     float moveRate = 0.1;  // in degs/sec
 